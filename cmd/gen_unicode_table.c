@@ -0,0 +1,68 @@
+/* Build-time generator for the unicode property table used by text.h.
+ * Every codepoint is mapped to a single byte packing its display width (low 2 bits),
+ * its utf8proc category (next 5 bits) and whether it is Extended_Pictographic (top bit). The table is split into blocks of
+ * 256 codepoints, and identical blocks are deduplicated so lookups are two loads:
+ *   unicode_table_blocks[unicode_table_index[cp >> 8] << 8 | (cp & 0xFF)]
+ *
+ * The table covers the full 21 bit range which can be produced by a 4-byte utf8 sequence,
+ * so callers can mask instead of range checking.
+ *
+ * usage: gen_unicode_table > gen/unicode_table.c
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "utf8proc/utf8proc.h"
+
+#define BLOCK_SHIFT 8
+#define BLOCK_SIZE (1 << BLOCK_SHIFT)
+#define CODEPOINT_LIMIT (1 << 21)
+#define N_BLOCKS (CODEPOINT_LIMIT / BLOCK_SIZE)
+
+static uint8_t props(uint32_t cp) {
+  int width = utf8proc_charwidth((utf8proc_int32_t)cp);
+  int category = utf8proc_category((utf8proc_int32_t)cp);
+  bool pictographic = utf8proc_get_property((utf8proc_int32_t)cp)->boundclass == UTF8PROC_BOUNDCLASS_EXTENDED_PICTOGRAPHIC;
+  if (width < 0 || width > 3 || category < 0 || category > 31) {
+    fprintf(stderr, "U+%04X: width %d or category %d does not fit in the table.\n", cp, width, category);
+    exit(1);
+  }
+  return (uint8_t)(width | (category << 2) | (pictographic << 7));
+}
+
+int main(void) {
+  static uint8_t blocks[N_BLOCKS][BLOCK_SIZE];
+  static uint16_t index[N_BLOCKS];
+  int n_unique = 0;
+
+  for (int b = 0; b < N_BLOCKS; b++) {
+    uint8_t block[BLOCK_SIZE];
+    for (int i = 0; i < BLOCK_SIZE; i++) block[i] = props((uint32_t)(b << BLOCK_SHIFT | i));
+
+    int found = -1;
+    for (int u = 0; u < n_unique && found < 0; u++)
+      if (memcmp(blocks[u], block, BLOCK_SIZE) == 0) found = u;
+
+    if (found < 0) {
+      found = n_unique++;
+      memcpy(blocks[found], block, BLOCK_SIZE);
+    }
+    index[b] = (uint16_t)found;
+  }
+
+  printf("/* generated by cmd/gen_unicode_table.c -- do not edit. */\n");
+  printf("/* %d unique blocks of %d codepoints. */\n\n", n_unique, BLOCK_SIZE);
+
+  printf("const uint16_t unicode_table_index[%d] = {", N_BLOCKS);
+  for (int b = 0; b < N_BLOCKS; b++) printf("%s%d,", b % 16 ? " " : "\n  ", index[b]);
+  printf("\n};\n\n");
+
+  printf("const uint8_t unicode_table_blocks[%d] = {", n_unique * BLOCK_SIZE);
+  for (int u = 0; u < n_unique; u++) {
+    for (int i = 0; i < BLOCK_SIZE; i++) printf("%s%d,", i % 32 ? " " : "\n  ", blocks[u][i]);
+  }
+  printf("\n};\n");
+  return 0;
+}
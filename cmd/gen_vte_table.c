@@ -0,0 +1,114 @@
+/* Build-time generator for the vte state transition table.
+ * The table follows the structure of the classic DEC parser: every state has 256
+ * entries which map the next input byte to an action and a next state.
+ * Escape sequences introducing a new state are derived from control_characters.def.
+ *
+ * usage: gen_vte_table > gen/vte_table.c
+ */
+#include <stdio.h>
+#include <string.h>
+#include "vte_table.h"
+
+#define ESC 0x1b
+#define CAN 0x18
+#define SUB 0x1a
+#define DEL 0x7f
+
+struct control {
+  uint8_t c0, c1;
+  const char *name;
+};
+
+static const struct control controls[] = {
+#define CONTROL(C0, C1, cmd, _) { C0, C1, #cmd },
+#include "control_sequences/control_characters.def"
+#undef CONTROL
+};
+
+static struct vte_transition table[VTE_STATE_LAST][256];
+
+static void set(enum vte_state state, int from, int to, enum vte_action action, enum vte_state next) {
+  for (int ch = from; ch <= to; ch++) table[state][ch] = (struct vte_transition){ .action = action, .next = next };
+}
+
+/* C0 controls are executed immediately inside escape and control sequences.
+ * ESC restarts the sequence, and CAN / SUB abort it. */
+static void set_controls(enum vte_state state) {
+  set(state, 0x00, 0x1f, VTE_ACTION_EXECUTE, state);
+  set(state, ESC, ESC, VTE_ACTION_ESC_ENTER, vte_escape);
+  set(state, CAN, CAN, VTE_ACTION_IGNORE, vte_ground);
+  set(state, SUB, SUB, VTE_ACTION_IGNORE, vte_ground);
+}
+
+static void build_ground(void) {
+  set(vte_ground, 0x00, 0x1f, VTE_ACTION_EXECUTE, vte_ground);
+  set(vte_ground, ESC, ESC, VTE_ACTION_ESC_ENTER, vte_escape);
+  set(vte_ground, 0x20, 0xff, VTE_ACTION_PRINT, vte_ground);
+  set(vte_ground, DEL, DEL, VTE_ACTION_IGNORE, vte_ground);
+  /* C1 controls behave like their escaped 7-bit equivalents */
+  for (size_t i = 0; i < sizeof(controls) / sizeof(controls[0]); i++)
+    table[vte_ground][controls[i].c1] = table[vte_escape][controls[i].c0];
+}
+
+static void build_escape(void) {
+  set_controls(vte_escape);
+  set(vte_escape, 0x20, 0xff, VTE_ACTION_ESC_DISPATCH, vte_ground);
+  set(vte_escape, DEL, DEL, VTE_ACTION_IGNORE, vte_escape);
+  set(vte_escape, '#', '#', VTE_ACTION_COLLECT, vte_pnd);
+  set(vte_escape, ' ', ' ', VTE_ACTION_COLLECT, vte_spc);
+  set(vte_escape, '%', '%', VTE_ACTION_COLLECT, vte_pct);
+  /* designate G0 - G3 */
+  const char *designators = "()*+-./";
+  for (const char *d = designators; *d; d++) set(vte_escape, *d, *d, VTE_ACTION_COLLECT, vte_charset);
+
+  for (size_t i = 0; i < sizeof(controls) / sizeof(controls[0]); i++) {
+    const struct control *c = &controls[i];
+    if (strcmp(c->name, "CSI") == 0) set(vte_escape, c->c0, c->c0, VTE_ACTION_CSI_ENTER, vte_csi);
+    if (strcmp(c->name, "OSC") == 0) set(vte_escape, c->c0, c->c0, VTE_ACTION_STRING_ENTER, vte_osc);
+    if (strcmp(c->name, "DCS") == 0) set(vte_escape, c->c0, c->c0, VTE_ACTION_STRING_ENTER, vte_dcs);
+    if (strcmp(c->name, "APC") == 0) set(vte_escape, c->c0, c->c0, VTE_ACTION_STRING_ENTER, vte_apc);
+  }
+}
+
+static void build_csi(void) {
+  set_controls(vte_csi);
+  /* parameters, prefixes and intermediates */
+  set(vte_csi, 0x20, 0x3f, VTE_ACTION_CSI_COLLECT, vte_csi);
+  set(vte_csi, 0x40, 0x7e, VTE_ACTION_CSI_DISPATCH, vte_ground);
+  set(vte_csi, DEL, 0xff, VTE_ACTION_IGNORE, vte_csi);
+}
+
+int main(void) {
+  /* escape must be built first since ground copies the C1 transitions from it */
+  build_escape();
+  build_ground();
+  build_csi();
+  set(vte_utf8, 0x00, 0xff, VTE_ACTION_UTF8, vte_utf8);
+  /* string terminators are detected by the put actions */
+  set(vte_osc, 0x00, 0xff, VTE_ACTION_OSC_PUT, vte_osc);
+  set(vte_dcs, 0x00, 0xff, VTE_ACTION_DCS_PUT, vte_dcs);
+  set(vte_apc, 0x00, 0xff, VTE_ACTION_APC_PUT, vte_apc);
+  set(vte_clipboard, 0x00, 0xff, VTE_ACTION_CLIPBOARD_PUT, vte_clipboard);
+  set(vte_pnd, 0x00, 0xff, VTE_ACTION_PND_DISPATCH, vte_ground);
+  set(vte_spc, 0x00, 0xff, VTE_ACTION_SPC_DISPATCH, vte_ground);
+  set(vte_pct, 0x00, 0xff, VTE_ACTION_PCT_DISPATCH, vte_ground);
+  set(vte_charset, 0x00, 0xff, VTE_ACTION_CHARSET_DISPATCH, vte_ground);
+  /* intermediates of multi-byte charset designators */
+  set(vte_charset, '"', '"', VTE_ACTION_CHARSET_DISPATCH, vte_charset);
+  set(vte_charset, '%', '%', VTE_ACTION_CHARSET_DISPATCH, vte_charset);
+  set(vte_charset, '&', '&', VTE_ACTION_CHARSET_DISPATCH, vte_charset);
+
+  printf("/* generated by cmd/gen_vte_table.c -- do not edit. */\n");
+  printf("/* { action, next state } */\n\n");
+  printf("const struct vte_transition vte_transitions[VTE_STATE_LAST][256] = {\n");
+  for (int state = 0; state < VTE_STATE_LAST; state++) {
+    printf("  [%d] = {", state);
+    for (int ch = 0; ch < 256; ch++) {
+      struct vte_transition t = table[state][ch];
+      printf("%s{%d,%d},", ch % 16 ? " " : "\n    ", t.action, t.next);
+    }
+    printf("\n  },\n");
+  }
+  printf("};\n");
+  return 0;
+}
@@ -63,7 +63,7 @@ struct dumb_screen *make_dumb_screen(int rows, int cols, uint32_t g[rows][cols])
   return screen;
 }
 
-static struct dumb_screen *screen_to_dumb_screen(const struct screen *const src) {
+static struct dumb_screen *screen_to_dumb_screen(struct screen *src) {
   struct dumb_screen *screen = calloc(sizeof(*screen) + src->w * src->h * sizeof(uint32_t), 1);
   screen->cols = src->w;
   screen->rows = src->h;
@@ -160,7 +160,7 @@ static void assert_eq(int actual, int expected, const char *test_name, const cha
   fail();
 }
 
-static void assert_screen_equals(struct dumb_screen *expected, const struct screen *const g, const char *msg) {
+static void assert_screen_equals(struct dumb_screen *expected, struct screen *g, const char *msg) {
   bool equal = true;
   if (expected->cols != g->w || expected->rows != g->h) {
     printf("Failed assertion: screens are not even the same size! (%s)\n", msg);
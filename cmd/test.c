@@ -15,6 +15,14 @@
 #include "lauxlib.h"
 #include "lua.h"
 #include "csi.h"
+#include "text.h"
+#include "vte_table.h"
+#include "vte.h"
+#include "lz.h"
+#include "scrollback.h"
+#include "line_arena.h"
+#include "velvet_scene.h"
+#include "utf8proc/utf8proc.h"
 
 static bool exit_on_failure = true;
 
@@ -99,6 +107,19 @@ void test_csi_parsing(void) {
                    .n_params = 2,
                    .state = CSI_ACCEPT,
                    .params = {{.primary = 48, .sub = {2, 118, 159, 240}}, {.primary = 38, .sub = {2, 235, 160, 172}}}});
+  test_csi_testcase("Legacy RGB beyond raw parameter count",
+                    "1;38;2;1;2;3;48;2;4;5;6;38;2;7;8;9;4m",
+                    (struct csi){.final = 'm',
+                                 .n_params = 5,
+                                 .state = CSI_ACCEPT,
+                                 .params = {{.primary = 1},
+                                            {.primary = 38, .sub = {2, 1, 2, 3}},
+                                            {.primary = 48, .sub = {2, 4, 5, 6}},
+                                            {.primary = 38, .sub = {2, 7, 8, 9}},
+                                            {.primary = 4}}});
+  test_csi_testcase("Too many subparameters",
+                    "1:2:3:4:5:6:7m",
+                    (struct csi){.state = CSI_REJECT, .n_params = 1, .params = {{.primary = 1, .sub = {2, 3, 4, 5, 6}}}});
   test_csi_testcase("Test prefix / intermediate parsing 1",
                     ">c",
                     (struct csi){.prefix = '>', .final = 'c', .state = CSI_ACCEPT, .n_params = 0});
@@ -344,6 +365,756 @@ static void test_num_as_slice(void) {
   }
 }
 
+static void test_text_scanner(void) {
+  /* compare every implementation against a naive scan, placing a single
+   * terminating byte at every offset to exercise both the vector body and the tail. */
+  enum text_scanner_kind kinds[] = { TEXT_SCANNER_SCALAR, TEXT_SCANNER_SSE2, TEXT_SCANNER_AVX2 };
+  uint8_t terminators[] = { 0x00, 0x07, 0x18, 0x1a, 0x1b, 0x1f, 0x20, 0x7f, 0x80, 0xff, '\n' };
+  uint8_t buf[100];
+  for (int k = 0; k < LENGTH(kinds); k++) {
+    if (text_scanner_select(kinds[k]) != kinds[k]) continue;
+    const char *name = text_scanner_name(kinds[k]);
+    for (int t = 0; t < LENGTH(terminators); t++) {
+      for (int at = 0; at <= LENGTH(buf); at++) {
+        memset(buf, 'a', sizeof(buf));
+        if (at < LENGTH(buf)) buf[at] = terminators[t];
+        size_t expected = terminators[t] >= 0x20 && terminators[t] < 0x7f ? LENGTH(buf) : at;
+        assert_eq(text_scanner.ascii(buf, sizeof(buf)), expected, name, "ascii run");
+
+        memset(buf, 0xe2, sizeof(buf));
+        if (at < LENGTH(buf)) buf[at] = terminators[t];
+        expected = terminators[t] >= 0x80 ? LENGTH(buf) : at;
+        assert_eq(text_scanner.utf8(buf, sizeof(buf)), expected, name, "utf8 run");
+
+        memset(buf, 'a', sizeof(buf));
+        if (at < LENGTH(buf)) buf[at] = terminators[t];
+        expected = terminators[t] < 0x20 ? at : LENGTH(buf);
+        assert_eq(text_scanner.string(buf, sizeof(buf)), expected, name, "string run");
+      }
+    }
+  }
+  text_scanner_select(TEXT_SCANNER_AUTO);
+}
+
+static void test_utf8_decode_run(void) {
+  struct { const char *name; const char *input; size_t max; size_t n; size_t consumed; uint32_t first; } cases[] = {
+    { "empty",          "",                     8, 0, 0,  0 },
+    { "mixed lengths",  "a\xc3\xa9\xe4\xb8\xad\xf0\x9f\x99\x82", 8, 4, 10, 'a' },
+    { "block limit",    "\xc3\xa9\xc3\xa9\xc3\xa9", 2, 2, 4,  0xe9 },
+    { "truncated",      "\xc3\xa9\xe4\xb8",       8, 1, 2,  0xe9 },
+    { "bad continuation", "\xe4\xb8\xc3\xa9",     8, 0, 0,  0 },
+    { "stray continuation", "\x80\xc3\xa9",      8, 0, 0,  0 },
+  };
+  uint32_t out[8];
+  for (int i = 0; i < LENGTH(cases); i++) {
+    size_t consumed;
+    struct u8_slice in = u8_slice_from_cstr(cases[i].input);
+    size_t n = utf8_decode_run(in.content, in.len, out, cases[i].max, &consumed);
+    assert_eq(n, cases[i].n, cases[i].name, "decoded count");
+    assert_eq(consumed, cases[i].consumed, cases[i].name, "consumed bytes");
+    if (n) assert_eq(out[0], cases[i].first, cases[i].name, "first codepoint");
+  }
+  size_t consumed;
+  struct u8_slice in = u8_slice_from_cstr("\xf0\x9f\x99\x82");
+  utf8_decode_run(in.content, in.len, out, 1, &consumed);
+  assert_eq(out[0], 0x1f642, "four byte sequence", "codepoint");
+}
+
+static void test_unicode_table(void) {
+  /* the generated table must agree with utf8proc for every codepoint */
+  int mismatches = 0;
+  for (uint32_t cp = 0; cp <= 0x10FFFF; cp++) {
+    bool pictographic = utf8proc_get_property(cp)->boundclass == UTF8PROC_BOUNDCLASS_EXTENDED_PICTOGRAPHIC;
+    if (unicode_width(cp) != utf8proc_charwidth(cp) || unicode_category(cp) != (int)utf8proc_category(cp) ||
+        unicode_is_extended_pictographic(cp) != pictographic) {
+      if (mismatches++ < 10) printf("unicode table mismatch at U+%04X\n", cp);
+    }
+  }
+  assert_eq(mismatches, 0, "unicode table", "mismatched codepoints");
+  assert_eq(unicode_width('a'), 1, "unicode table", "ascii width");
+  assert_eq(unicode_width(0x4E2D), 2, "unicode table", "cjk width");
+  assert_eq(unicode_width(0x0301), 0, "unicode table", "combining width");
+}
+
+static void test_vte_table(void) {
+  struct vte_transition t;
+  t = vte_transitions[vte_ground]['a'];
+  assert_eq(t.action, VTE_ACTION_PRINT, "vte table", "ground print");
+  t = vte_transitions[vte_ground]['\n'];
+  assert_eq(t.action, VTE_ACTION_EXECUTE, "vte table", "ground execute");
+  t = vte_transitions[vte_ground][0x1b];
+  assert_eq(t.next, vte_escape, "vte table", "ground escape");
+  t = vte_transitions[vte_escape]['['];
+  assert_eq(t.action, VTE_ACTION_CSI_ENTER, "vte table", "escape csi action");
+  assert_eq(t.next, vte_csi, "vte table", "escape csi state");
+  t = vte_transitions[vte_ground][0x9b];
+  assert_eq(t.action, VTE_ACTION_CSI_ENTER, "vte table", "C1 csi action");
+  assert_eq(t.next, vte_csi, "vte table", "C1 csi state");
+  t = vte_transitions[vte_ground][0x9d];
+  assert_eq(t.next, vte_osc, "vte table", "C1 osc state");
+  t = vte_transitions[vte_csi]['\r'];
+  assert_eq(t.action, VTE_ACTION_EXECUTE, "vte table", "csi execute");
+  assert_eq(t.next, vte_csi, "vte table", "csi execute state");
+  t = vte_transitions[vte_csi][0x18];
+  assert_eq(t.next, vte_ground, "vte table", "csi cancel");
+  t = vte_transitions[vte_csi]['m'];
+  assert_eq(t.action, VTE_ACTION_CSI_DISPATCH, "vte table", "csi dispatch");
+  assert_eq(t.next, vte_ground, "vte table", "csi dispatch state");
+  t = vte_transitions[vte_escape]['('];
+  assert_eq(t.next, vte_charset, "vte table", "charset");
+  t = vte_transitions[vte_charset]['%'];
+  assert_eq(t.next, vte_charset, "vte table", "charset intermediate");
+}
+
+static void test_csi_push(void) {
+  struct csi c = {0};
+  const char *seq = "?1;38:2::10:20:30m";
+  csi_reset(&c);
+  for (const char *ch = seq; ch[1]; ch++) csi_push(&c, *ch);
+  csi_finish(&c, 'm');
+  assert_eq(c.state, CSI_ACCEPT, "csi push", "state");
+  assert_eq(c.prefix, '?', "csi push", "prefix");
+  assert_eq(c.final, 'm', "csi push", "final");
+  assert_eq(c.n_params, 2, "csi push", "n_params");
+  assert_eq(c.params[0].primary, 1, "csi push", "first param");
+  assert_eq(c.params[1].primary, 38, "csi push", "second param");
+  assert_eq(c.params[1].n_sub, 5, "csi push", "sub params");
+  assert_eq(c.params[1].sub[4], 30, "csi push", "last sub param");
+
+  /* the legacy semicolon separated form of extended colors is folded into sub parameters */
+  seq = "38;5;196;1m";
+  csi_reset(&c);
+  for (const char *ch = seq; ch[1]; ch++) csi_push(&c, *ch);
+  csi_finish(&c, 'm');
+  assert_eq(c.state, CSI_ACCEPT, "csi push", "sgr state");
+  assert_eq(c.n_params, 2, "csi push", "sgr n_params");
+  assert_eq(c.params[0].n_sub, 2, "csi push", "sgr sub params");
+  assert_eq(c.params[0].sub[1], 196, "csi push", "sgr color");
+  assert_eq(c.params[1].primary, 1, "csi push", "sgr trailing param");
+
+  /* omitted parameters do not inherit values from the previous sequence */
+  seq = "48;2;10;20;30m";
+  csi_reset(&c);
+  for (const char *ch = seq; ch[1]; ch++) csi_push(&c, *ch);
+  csi_finish(&c, 'm');
+  csi_reset(&c);
+  csi_finish(&c, 'H');
+  assert_eq(c.n_params, 0, "csi push", "omitted n_params");
+  assert_eq(c.params[0].primary, 0, "csi push", "omitted first param");
+  assert_eq(c.params[1].primary, 0, "csi push", "omitted second param");
+
+  struct vte vte = vte_default;
+  vte_set_size(&vte, (struct rect){.width = 10, .height = 5});
+  vte_process(&vte, u8_slice_from_cstr("\x1b[4;6H\x1b[H"));
+  struct screen *g = vte_get_current_screen(&vte);
+  assert_eq(g->cursor.line, 0, "csi push", "default cursor line");
+  assert_eq(g->cursor.column, 0, "csi push", "default cursor column");
+  vte_destroy(&vte);
+}
+
+struct clipboard_capture {
+  enum osc_clipboard clipboard;
+  struct string payload;
+  int begin, end, abort;
+};
+
+static void clipboard_capture_begin(enum osc_clipboard clipboard, void *userdata) {
+  struct clipboard_capture *c = userdata;
+  c->clipboard = clipboard;
+  c->begin++;
+}
+
+static void clipboard_capture_write(struct u8_slice base64, void *userdata) {
+  struct clipboard_capture *c = userdata;
+  string_push_slice(&c->payload, base64);
+}
+
+static void clipboard_capture_end(void *userdata) {
+  struct clipboard_capture *c = userdata;
+  c->end++;
+}
+
+static void clipboard_capture_abort(void *userdata) {
+  struct clipboard_capture *c = userdata;
+  c->abort++;
+}
+
+static void test_osc_clipboard_stream(void) {
+  /* OSC 52 payloads larger than the escape sequence limit are streamed in chunks without being buffered */
+  struct clipboard_capture capture = {0};
+  struct vte vte = vte_default;
+  vte_set_size(&vte, (struct rect){.width = 10, .height = 2});
+  vte.clipboard.userdata = &capture;
+  vte.clipboard.begin = clipboard_capture_begin;
+  vte.clipboard.write = clipboard_capture_write;
+  vte.clipboard.end = clipboard_capture_end;
+  vte.clipboard.abort = clipboard_capture_abort;
+
+  static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  struct string input = {0};
+  size_t payload_length = 4 << 20;
+  string_push_cstr(&input, "\x1b]52;p;");
+  for (size_t i = 0; i < payload_length; i++) string_push_char(&input, alphabet[i % (sizeof(alphabet) - 1)]);
+  string_push_cstr(&input, "\x1b\\x");
+
+  /* odd chunk size so the prefix and the terminator are split */
+  for (size_t i = 0; i < input.len; i += 4093) {
+    size_t end = i + 4093 < input.len ? i + 4093 : input.len;
+    vte_process(&vte, string_range(&input, i, end));
+  }
+
+  assert_eq(capture.begin, 1, "osc clipboard stream", "begin");
+  assert_eq(capture.end, 1, "osc clipboard stream", "end");
+  assert_eq(capture.clipboard, OSC_CLIPBOARD_X11_PRIMARY_SELECTION, "osc clipboard stream", "selection");
+  assert_eq(capture.payload.len == payload_length, true, "osc clipboard stream", "payload length");
+  assert_eq(memcmp(capture.payload.content, input.content + 7, payload_length), 0, "osc clipboard stream", "payload");
+  assert_eq(vte.command_buffer.cap < 4096, true, "osc clipboard stream", "payload was buffered");
+  assert_eq(vte.state, vte_ground, "osc clipboard stream", "state");
+  assert_eq(vte.primary.cursor.column, 1, "osc clipboard stream", "text after terminator");
+  assert_eq(capture.abort, 0, "osc clipboard stream", "abort");
+
+  /* CAN, SUB and an ESC which does not start ST abort the sequence. Output after it is processed normally. */
+  const char *aborts[] = { "\x1b]52;c;QUJD\x18y", "\x1b]52;c;QUJD\x1ay", "\x1b]52;c;QUJD\x1b[Cy", "\x1b]52;c;QU\x1b\x1b[Cy" };
+  for (int i = 0; i < LENGTH(aborts); i++) {
+    capture = (struct clipboard_capture){ .payload = capture.payload };
+    vte_process(&vte, u8_slice_from_cstr("\r"));
+    vte_process(&vte, u8_slice_from_cstr(aborts[i]));
+    assert_eq(capture.abort, 1, "osc clipboard abort", aborts[i]);
+    assert_eq(capture.end, 0, "osc clipboard abort", "end");
+    assert_eq(vte.state, vte_ground, "osc clipboard abort", "state");
+    assert_eq(vte.primary.cursor.column, i >= 2 ? 2 : 1, "osc clipboard abort", "text after abort");
+  }
+
+  /* only the base64 alphabet is forwarded */
+  capture = (struct clipboard_capture){ .payload = capture.payload };
+  string_clear(&capture.payload);
+  vte_process(&vte, u8_slice_from_cstr("\x1b]52;c;QU\r\nJD \x7f\xc3\xa9Zm9v=\a"));
+  assert_eq(capture.end, 1, "osc clipboard filter", "end");
+  assert_eq(capture.payload.len, 9, "osc clipboard filter", "payload length");
+  assert_eq(memcmp(capture.payload.content, "QUJDZm9v=", 9), 0, "osc clipboard filter", "payload");
+
+  /* a sequence which stays open too long or grows too large is aborted */
+  capture.abort = 0;
+  vte_process(&vte, u8_slice_from_cstr("\x1b]52;c;QUJD"));
+  assert_eq(vte_clipboard_expire(&vte), false, "osc clipboard abort", "not timed out");
+  vte.clipboard_stream.since -= VTE_CLIPBOARD_TIMEOUT;
+  assert_eq(vte_clipboard_expire(&vte), true, "osc clipboard abort", "timed out");
+  assert_eq(capture.abort, 1, "osc clipboard abort", "timeout");
+  assert_eq(vte_clipboard_open(&vte), false, "osc clipboard abort", "closed after timeout");
+  vte_process(&vte, u8_slice_from_cstr("\x1b]52;c;QUJD"));
+  vte.clipboard_stream.size = VTE_CLIPBOARD_MAX_SIZE;
+  vte_process(&vte, u8_slice_from_cstr("QUJD"));
+  assert_eq(capture.abort, 2, "osc clipboard abort", "size");
+  assert_eq(vte_clipboard_open(&vte), false, "osc clipboard abort", "closed after size");
+
+  /* an open sequence is aborted by RIS and when the emulator is destroyed */
+  capture.abort = 0;
+  vte_process(&vte, u8_slice_from_cstr("\x1b]52;c;QUJD\x1b"));
+  vte_process(&vte, u8_slice_from_cstr("c"));
+  assert_eq(capture.abort, 1, "osc clipboard abort", "RIS");
+  vte_process(&vte, u8_slice_from_cstr("\x1b]52;c;QUJD"));
+  assert_eq(vte_clipboard_open(&vte), true, "osc clipboard abort", "open");
+  vte_destroy(&vte);
+  assert_eq(capture.abort, 2, "osc clipboard abort", "destroy");
+  string_destroy(&capture.payload);
+  string_destroy(&input);
+}
+
+static void test_hyperlink_reclaim(void) {
+  /* ids of hyperlinks which are no longer referenced by a cell are reused once the ids run out */
+  struct vte vte = vte_default;
+  vte_set_size(&vte, (struct rect){.width = 10, .height = 4});
+  vte_process(&vte, u8_slice_from_cstr("\x1b]8;;kept\x1b\\K\x1b]8;;\x1b\\\r\n"));
+  /* push the linked line into the compressed archive */
+  for (int i = 0; i < SCREEN_HOT_LINES + 10; i++) vte_process(&vte, u8_slice_from_cstr("\r\n"));
+  struct screen *g = vte_get_current_screen(&vte);
+  int kept = -g->scroll.height;
+  assert_eq(g->archive->n_lines > 0, true, "hyperlink reclaim", "archived");
+
+  char buf[64];
+  int n_links = HYPERLINK_ID_MAX + 100;
+  for (int i = 0; i < n_links; i++) {
+    snprintf(buf, sizeof(buf), "\x1b[H\x1b]8;;%d\x1b\\A\x1b]8;;\x1b\\", i);
+    vte_process(&vte, u8_slice_from_cstr(buf));
+  }
+  assert_eq(vte.links.length <= HYPERLINK_ID_MAX, true, "hyperlink reclaim", "bounded ids");
+  assert_eq(vte.links_collected, true, "hyperlink reclaim", "collected");
+  hyperlink_id id = screen_get_line(g, 0)->cells[0].link;
+  assert_eq(id != 0, true, "hyperlink reclaim", "link past the limit");
+  snprintf(buf, sizeof(buf), "%d", n_links - 1);
+  assert_eq(u8_slice_equals(hyperlink_get_url(vte_get_hyperlink(&vte, id)), u8_slice_from_cstr(buf)), true,
+            "hyperlink reclaim", "url past the limit");
+  id = screen_get_line(g, kept)->cells[0].link;
+  assert_eq(id != 0, true, "hyperlink reclaim", "archived link kept");
+  assert_eq(u8_slice_equals(hyperlink_get_url(vte_get_hyperlink(&vte, id)), u8_slice_from_cstr("kept")), true,
+            "hyperlink reclaim", "archived url");
+  vte_destroy(&vte);
+}
+
+static void test_synchronized_update(void) {
+  struct vte vte = vte_default;
+  vte_set_size(&vte, (struct rect){.width = 10, .height = 2});
+  vte_process(&vte, u8_slice_from_cstr("abc\x1b[?2026h"));
+  assert_eq(vte_synchronized_update_pending(&vte), true, "synchronized update", "pending");
+  vte_process(&vte, u8_slice_from_cstr("\rxyz"));
+
+  /* the last complete frame is visible until the update is closed */
+  struct screen *visible = vte_get_visible_screen(&vte);
+  assert_eq(visible != vte_get_current_screen(&vte), true, "synchronized update", "visible screen");
+  assert_eq(screen_get_line(visible, 0)->cells[0].cp.value, 'a', "synchronized update", "frozen cell");
+  assert_eq(visible->cursor.column, 3, "synchronized update", "frozen cursor");
+
+  vte_process(&vte, u8_slice_from_cstr("\x1b[?2026$p"));
+  assert_eq(u8_slice_equals(string_as_u8_slice(vte.pending_input), u8_slice_from_cstr("\x1b[?2026;1$y")), true,
+            "synchronized update", "DECRQM");
+
+  vte_process(&vte, u8_slice_from_cstr("\x1b[?2026l"));
+  assert_eq(vte.synchronized_update.completed, true, "synchronized update", "completed");
+  visible = vte_get_visible_screen(&vte);
+  assert_eq(visible == vte_get_current_screen(&vte), true, "synchronized update", "live screen");
+  assert_eq(screen_get_line(visible, 0)->cells[0].cp.value, 'x', "synchronized update", "live cell");
+
+  /* an update which is never closed is abandoned */
+  vte.synchronized_update.completed = false;
+  vte_process(&vte, u8_slice_from_cstr("\x1b[?2026h"));
+  vte.synchronized_update.since -= VTE_SYNCHRONIZED_UPDATE_TIMEOUT;
+  assert_eq(vte_synchronized_update_pending(&vte), false, "synchronized update", "timeout");
+  assert_eq(vte.options.synchronized_update, true, "synchronized update", "pending is pure");
+  assert_eq(vte.synchronized_update.completed, false, "synchronized update", "pending is pure");
+  assert_eq(vte_synchronized_update_expire(&vte), true, "synchronized update", "expire");
+  assert_eq(vte.synchronized_update.completed, true, "synchronized update", "timeout completed");
+  assert_eq(vte_synchronized_update_expire(&vte), false, "synchronized update", "expire closed");
+
+  /* RIS closes an open update */
+  vte_process(&vte, u8_slice_from_cstr("\x1b[?2026h\x1b" "c"));
+  assert_eq(vte.options.synchronized_update, false, "synchronized update", "RIS");
+  assert_eq(vte_get_visible_screen(&vte) == vte_get_current_screen(&vte), true, "synchronized update", "RIS visible");
+  vte_destroy(&vte);
+}
+
+static void test_grapheme_clusters(void) {
+  struct grapheme_store store = {0};
+  uint32_t acute[] = {'e', 0x301};
+  uint32_t cluster[GRAPHEME_MAX_LENGTH];
+  assert_eq(grapheme_store_intern(&store, acute, 1), 'e', "grapheme store", "single codepoint");
+  uint32_t handle = grapheme_store_intern(&store, acute, 2);
+  assert_eq(grapheme_is_handle(handle), true, "grapheme store", "handle");
+  assert_eq(grapheme_store_intern(&store, acute, 2), handle, "grapheme store", "interned");
+  assert_eq(grapheme_store_get(&store, handle, cluster), 2, "grapheme store", "length");
+  assert_eq(cluster[1], 0x301, "grapheme store", "content");
+  grapheme_store_destroy(&store);
+
+  struct vte vte = vte_default;
+  vte_set_size(&vte, (struct rect){.width = 10, .height = 2});
+  /* combining acute, split across writes; ZWJ sequence; flags; emoji presentation selector */
+  vte_process(&vte, u8_slice_from_cstr("e\xcc"));
+  vte_process(&vte, u8_slice_from_cstr("\x81" "\xf0\x9f\x91\xa9\xe2\x80\x8d\xf0\x9f\x92\xbb"
+                                       "\xf0\x9f\x87\xb3\xf0\x9f\x87\xb4\xf0\x9f\x87\xb8\xf0\x9f\x87\xaa"
+                                       "\xe2\x9d\xa4\xef\xb8\x8f"));
+  struct screen *g = vte_get_current_screen(&vte);
+  struct screen_cell *cells = screen_get_line(g, 0)->cells;
+  uint32_t expected[][3] = {{'e', 0x301}, {0x1F469, 0x200D, 0x1F4BB}, {0x1F1F3, 0x1F1F4}, {0x1F1F8, 0x1F1EA}, {0x2764, 0xFE0F}};
+  int columns[] = {0, 1, 3, 5, 7};
+  for (int i = 0; i < LENGTH(columns); i++) {
+    int n = grapheme_store_get(&vte.graphemes, cells[columns[i]].cp.value, cluster);
+    bool equal = n == (expected[i][2] ? 3 : 2) && memcmp(cluster, expected[i], n * sizeof(*cluster)) == 0;
+    assert_eq(equal, true, "grapheme clusters", "cluster content");
+    assert_eq(cells[columns[i]].cp.is_wide, i > 0, "grapheme clusters", "cluster width");
+  }
+  assert_eq(g->cursor.column, 9, "grapheme clusters", "cursor");
+  int n;
+
+  /* a ZWJ only joins two pictographic codepoints (GB11). Anything else starts a new cluster after it. */
+  vte_process(&vte, u8_slice_from_cstr("\x1b[2;1Ha\xe2\x80\x8d" "b\xf0\x9f\x91\xa9\xe2\x80\x8d" "c"));
+  cells = screen_get_line(g, 1)->cells;
+  n = grapheme_store_get(&vte.graphemes, cells[0].cp.value, cluster);
+  assert_eq(n == 2 && cluster[0] == 'a' && cluster[1] == 0x200D, true, "grapheme clusters", "ZWJ after a letter");
+  assert_eq(cells[1].cp.value, 'b', "grapheme clusters", "letter after ZWJ");
+  n = grapheme_store_get(&vte.graphemes, cells[2].cp.value, cluster);
+  assert_eq(n == 2 && cluster[0] == 0x1F469 && cluster[1] == 0x200D, true, "grapheme clusters", "ZWJ after an emoji");
+  assert_eq(cells[4].cp.value, 'c', "grapheme clusters", "letter after emoji ZWJ");
+
+  /* clusters which are no longer referenced are reclaimed when the store is full.
+   * Clusters in the scrollback are kept. */
+  vte_process(&vte, u8_slice_from_cstr("\x1b[H\x1b[2Je\xcc\x81"));
+  uint32_t kept = screen_get_line(g, 0)->cells[0].cp.value;
+  vte_process(&vte, u8_slice_from_cstr("\r\n\n\n"));
+  for (int i = 0; i < GRAPHEME_STORE_CAPACITY; i++) {
+    struct string s = {0};
+    string_push_cstr(&s, "\x1b[H");
+    string_push_codepoint(&s, 'a' + i % 26);
+    string_push_codepoint(&s, 0x300 + (i / 26) % 112);
+    string_push_codepoint(&s, 0x300 + (i / 26 / 112) % 112);
+    vte_process(&vte, string_as_u8_slice(s));
+    string_destroy(&s);
+  }
+  n = grapheme_store_get(&vte.graphemes, screen_get_line(g, 0)->cells[0].cp.value, cluster);
+  assert_eq(n, 3, "grapheme clusters", "reclaimed clusters");
+  n = grapheme_store_get(&vte.graphemes, kept, cluster);
+  assert_eq(n == 2 && cluster[0] == 'e' && cluster[1] == 0x301, true, "grapheme clusters", "scrollback cluster kept");
+  assert_eq(vte.graphemes.n_clusters - vte.graphemes.n_free < GRAPHEME_STORE_CAPACITY / 2, true, "grapheme clusters",
+            "store swept");
+  vte_destroy(&vte);
+}
+
+static void test_style_table(void) {
+  assert_eq(sizeof(struct screen_cell), 8, "style table", "cell size");
+  struct vte vte = vte_default;
+  vte_set_size(&vte, (struct rect){.width = 10, .height = 2});
+  vte_process(&vte, u8_slice_from_cstr("\x1b[31ma\x1b[1mb\x1b[22ma\x1b[m "));
+  struct screen *g = vte_get_current_screen(&vte);
+  struct screen_cell *cells = screen_get_line(g, 0)->cells;
+  assert_eq(cells[0].style != 0, true, "style table", "styled cell");
+  assert_eq(cells[0].style != cells[1].style, true, "style table", "distinct styles");
+  assert_eq(cells[0].style, cells[2].style, "style table", "interned style");
+  assert_eq(cells[3].style, 0, "style table", "default style");
+  assert_eq(screen_get_style(g, cells[1].style).attr, ATTR_BOLD, "style table", "resolved attribute");
+  assert_eq(screen_get_style(g, cells[1].style).fg.c.table, 1, "style table", "resolved color");
+
+  /* styles which are no longer referenced are reclaimed when the table runs out of ids */
+  char buf[64];
+  for (int i = 0; i < STYLE_ID_MAX + 100; i++) {
+    snprintf(buf, sizeof(buf), "\x1b[H\x1b[38;2;%d;%d;%dmx", i & 0xff, (i >> 8) & 0xff, i >> 16);
+    vte_process(&vte, u8_slice_from_cstr(buf));
+  }
+  struct screen_cell_style last = screen_get_style(g, cells[0].style);
+  assert_eq(last.fg.c.rgb.g, ((STYLE_ID_MAX + 99) >> 8) & 0xff, "style table", "reclaimed ids");
+  assert_eq(screen_get_style(g, cells[1].style).attr, ATTR_BOLD, "style table", "live style kept");
+  vte_destroy(&vte);
+}
+
+static void test_lz(void) {
+  uint8_t src[4096], compressed[4096 + 64], out[4096];
+  for (size_t i = 0; i < sizeof(src); i++) src[i] = "line of text\r\n"[i % 14];
+  size_t n = lz_compress(src, sizeof(src), compressed);
+  assert_eq(n < sizeof(src) / 10, true, "lz", "repetitive input compresses");
+  assert_eq(lz_decompress(compressed, n, out, sizeof(out)), true, "lz", "round trip");
+  assert_eq(memcmp(src, out, sizeof(src)), 0, "lz", "round trip content");
+  assert_eq(lz_decompress(compressed, n, out, sizeof(out) - 1), false, "lz", "length mismatch");
+
+  uint32_t x = 1;
+  for (size_t i = 0; i < sizeof(src); i++) src[i] = (x = x * 1103515245 + 12345) >> 24;
+  n = lz_compress(src, sizeof(src), compressed);
+  assert_eq(n <= lz_compress_bound(sizeof(src)), true, "lz", "incompressible bound");
+  assert_eq(lz_decompress(compressed, n, out, sizeof(out)) && memcmp(src, out, sizeof(src)) == 0, true, "lz", "incompressible round trip");
+}
+
+static int line_number(struct screen_line *l) {
+  char buf[16] = {0};
+  for (int i = 0; i < l->eol && i < (int)sizeof(buf) - 1; i++) buf[i] = l->cells[i].cp.value;
+  return atoi(buf);
+}
+
+static void test_scrollback_archive(void) {
+  struct vte vte = vte_default;
+  vte_set_size(&vte, (struct rect){.width = 20, .height = 4});
+  char buf[64];
+  int n_lines = SCREEN_HOT_LINES * 3;
+  for (int i = 0; i < n_lines; i++) {
+    snprintf(buf, sizeof(buf), i % 7 ? "%d\r\n" : "\x1b[31m%d\x1b[m\r\n", i);
+    vte_process(&vte, u8_slice_from_cstr(buf));
+  }
+  struct screen *g = vte_get_current_screen(&vte);
+  /* the final line is the empty line at the cursor */
+  int history = n_lines - g->h + 1;
+  assert_eq(g->scroll.height, history, "scrollback archive", "scroll height");
+  assert_eq(g->archive->n_lines, history - SCREEN_HOT_LINES, "scrollback archive", "archived lines");
+  struct scrollback_stats stats = scrollback_get_stats(g->archive);
+  assert_eq(stats.bytes * 4 < stats.raw_bytes, true, "scrollback archive", "compression ratio");
+
+  assert_eq(line_number(screen_get_line(g, -history)), 0, "scrollback archive", "oldest line");
+  struct screen_line *l = screen_get_line(g, -history + 700);
+  assert_eq(line_number(l), 700, "scrollback archive", "archived line");
+  assert_eq(screen_get_style(g, l->cells[0].style).fg.c.table, 1, "scrollback archive", "archived style");
+  assert_eq(line_number(screen_get_line(g, -SCREEN_HOT_LINES)), history - SCREEN_HOT_LINES, "scrollback archive", "hot line");
+
+  /* reflowing reads the archive back */
+  vte_set_size(&vte, (struct rect){.width = 30, .height = 4});
+  g = vte_get_current_screen(&vte);
+  assert_eq(g->scroll.height, history, "scrollback archive", "reflowed height");
+  assert_eq(line_number(screen_get_line(g, -history + 1)), 1, "scrollback archive", "reflowed line");
+
+  /* lines beyond the scrollback limit are dropped */
+  for (int i = n_lines; i < g->scroll.max + n_lines; i++) {
+    snprintf(buf, sizeof(buf), "%d\r\n", i);
+    vte_process(&vte, u8_slice_from_cstr(buf));
+  }
+  assert_eq(g->scroll.height, g->scroll.max, "scrollback archive", "limited height");
+  assert_eq(line_number(screen_get_line(g, -g->scroll.max)), n_lines - g->h + 1, "scrollback archive", "oldest retained line");
+
+  vte_process(&vte, u8_slice_from_cstr("\x1b[3J"));
+  assert_eq(g->scroll.height, 0, "scrollback archive", "erased height");
+  assert_eq(g->archive->n_lines, 0, "scrollback archive", "erased archive");
+  vte_destroy(&vte);
+}
+
+static void test_line_arena(void) {
+  struct vte vte = vte_default;
+  vte_set_size(&vte, (struct rect){.width = 80, .height = 2});
+  char red_line[96];
+  snprintf(red_line, sizeof(red_line), "\x1b[41mred%77s\x1b[m\r\n", "");
+  vte_process(&vte, u8_slice_from_cstr(red_line));
+  vte_process(&vte, u8_slice_from_cstr("plain\r\n\r\n"));
+  struct screen *g = vte_get_current_screen(&vte);
+  assert_eq(g->scroll.height, 2, "line arena", "scroll height");
+  /* lines are stored trimmed. The red line is trimmed to its text since the trailing red spaces are its fill. */
+  assert_eq(g->history->n_cells, 3 + 5, "line arena", "trimmed cells");
+  struct screen_line *red = screen_get_line(g, -2);
+  assert_eq(red->cells[0].cp.value, 'r', "line arena", "stored cell");
+  assert_eq(screen_get_style(g, red->cells[79].style).bg.c.table, 1, "line arena", "fill style");
+  struct screen_line *plain = screen_get_line(g, -1);
+  assert_eq(plain->eol, 5, "line arena", "eol");
+  assert_eq(plain->has_newline, true, "line arena", "newline");
+  assert_eq(plain->cells[79].style, 0, "line arena", "default fill");
+  vte_destroy(&vte);
+}
+
+static void test_scroll_region_rotation(void) {
+  struct vte vte = vte_default;
+  vte_set_size(&vte, (struct rect){.width = 10, .height = 6});
+  struct screen *g = vte_get_current_screen(&vte);
+  vte_process(&vte, u8_slice_from_cstr("0\r\n1\r\n2\r\n3\r\n4\r\n5"));
+  /* scrolling a region rotates its rows */
+  vte_process(&vte, u8_slice_from_cstr("\x1b[2;5r\x1b[5H\n\n"));
+  assert_eq(g->rotation.n, 2, "scroll region rotation", "rotated");
+  assert_eq(line_number(screen_get_line(g, 1)), 3, "scroll region rotation", "rotated row");
+  assert_eq(screen_get_line(g, 3)->eol, 0, "scroll region rotation", "cleared row");
+  /* scrolling another region moves the rows into place first */
+  vte_process(&vte, u8_slice_from_cstr("\x1b[3;6r\x1b[3H\x1bM"));
+  assert_eq(line_number(screen_get_line(g, 0)), 0, "scroll region rotation", "row 0");
+  assert_eq(line_number(screen_get_line(g, 1)), 3, "scroll region rotation", "row 1");
+  assert_eq(screen_get_line(g, 2)->eol, 0, "scroll region rotation", "row 2");
+  assert_eq(line_number(screen_get_line(g, 3)), 4, "scroll region rotation", "row 3");
+  assert_eq(screen_get_line(g, 4)->eol, 0, "scroll region rotation", "row 4");
+  assert_eq(screen_get_line(g, 5)->eol, 0, "scroll region rotation", "row 5");
+  vte_destroy(&vte);
+}
+
+static void test_lazy_reflow(void) {
+  struct vte vte = vte_default;
+  vte_set_size(&vte, (struct rect){.width = 20, .height = 4});
+  char buf[32];
+  int n_lines = 2000;
+  for (int i = 0; i < n_lines; i++) {
+    snprintf(buf, sizeof(buf), "%015d\r\n", i);
+    vte_process(&vte, u8_slice_from_cstr(buf));
+  }
+  int history = n_lines - 4 + 1;
+
+  /* only the screen and a margin are re-wrapped. The rest of the scrollback is measured. */
+  vte_set_size(&vte, (struct rect){.width = 10, .height = 4});
+  struct screen *g = vte_get_current_screen(&vte);
+  assert_eq(g->reflow.n_lines > 0, true, "lazy reflow", "inherited lines");
+  assert_eq(g->history->n_lines < 16, true, "lazy reflow", "re-wrapped margin");
+  assert_eq(g->scroll.height, 2 * history + 3, "lazy reflow", "measured height");
+
+  /* a sequence of resizes does not re-wrap the scrollback */
+  for (int i = 0; i < 50; i++) vte_set_size(&vte, (struct rect){.width = 10 + (i * 7) % 25, .height = 4});
+  vte_set_size(&vte, (struct rect){.width = 20, .height = 4});
+  g = vte_get_current_screen(&vte);
+  assert_eq(g->reflow.n_lines > 0, true, "lazy reflow", "still inherited");
+  assert_eq(g->history->n_lines < 16, true, "lazy reflow", "resize storm");
+  assert_eq(g->scroll.height, history, "lazy reflow", "restored height");
+
+  /* reading the scrollback re-wraps it newest first, a block at a time */
+  int stored = g->scroll.height - g->reflow.height;
+  assert_eq(line_number(screen_get_line(g, -stored - 1)), history - stored - 1, "lazy reflow", "newest inherited line");
+  assert_eq(g->reflow.n_lines > 0, true, "lazy reflow", "re-wrapped block");
+  assert_eq(g->scroll.height - g->reflow.height - stored, SCROLLBACK_BLOCK_LINES, "lazy reflow", "block height");
+  assert_eq(line_number(screen_get_line(g, -stored - 2)), history - stored - 2, "lazy reflow", "block line");
+  assert_eq(line_number(screen_get_line(g, -history)), 0, "lazy reflow", "oldest line");
+  assert_eq(g->reflow.n_lines, 0, "lazy reflow", "re-wrapped");
+  assert_eq(line_number(screen_get_line(g, -history + 500)), 500, "lazy reflow", "re-wrapped line");
+  assert_eq(g->scroll.height, history, "lazy reflow", "re-wrapped height");
+  vte_destroy(&vte);
+}
+
+static void test_scrollback_spill(void) {
+  struct vte vte = vte_default;
+  vte_set_size(&vte, (struct rect){.width = 20, .height = 4});
+  struct screen *g = vte_get_current_screen(&vte);
+  screen_set_scrollback_limit(g, SCREEN_SCROLLBACK_UNLIMITED, true);
+  char buf[32];
+  int n_lines = VTE_SCROLLBACK_LINES * 2;
+  for (int i = 0; i < n_lines; i++) {
+    snprintf(buf, sizeof(buf), "%d\r\n", i);
+    vte_process(&vte, u8_slice_from_cstr(buf));
+  }
+  int history = n_lines - g->h + 1;
+  assert_eq(g->scroll.height, history, "scrollback spill", "unlimited height");
+  struct scrollback_stats stats = scrollback_get_stats(g->archive);
+  assert_eq(stats.spilled_bytes > 0, true, "scrollback spill", "blocks spilled");
+  assert_eq(g->archive->blocks[0].data == NULL, true, "scrollback spill", "block released");
+  assert_eq(line_number(screen_get_line(g, -history)), 0, "scrollback spill", "oldest line");
+  assert_eq(line_number(screen_get_line(g, -history + 5000)), 5000, "scrollback spill", "spilled line");
+
+  /* the spill mode survives reflow */
+  vte_set_size(&vte, (struct rect){.width = 30, .height = 4});
+  g = vte_get_current_screen(&vte);
+  assert_eq(line_number(screen_get_line(g, -history + 1)), 1, "scrollback spill", "reflowed line");
+  assert_eq(g->archive->spill_fd >= 0, true, "scrollback spill", "reflowed spill");
+
+  /* returning to memory drops lines beyond the limit and loads the rest */
+  screen_set_scrollback_limit(g, VTE_SCROLLBACK_LINES, false);
+  assert_eq(g->scroll.height, VTE_SCROLLBACK_LINES, "scrollback spill", "limited height");
+  assert_eq(scrollback_get_stats(g->archive).spilled_bytes, 0, "scrollback spill", "blocks loaded");
+  assert_eq(line_number(screen_get_line(g, -VTE_SCROLLBACK_LINES)), history - VTE_SCROLLBACK_LINES, "scrollback spill", "oldest retained line");
+  vte_destroy(&vte);
+}
+
+static void test_line_generations(void) {
+  struct vte vte = vte_default;
+  vte_set_size(&vte, (struct rect){.width = 10, .height = 4});
+  struct screen *g = vte_get_current_screen(&vte);
+  vte_process(&vte, u8_slice_from_cstr("a\r\nb\r\nc"));
+  uint64_t generation = screen_generation;
+  uint64_t first = screen_get_line(g, 0)->generation;
+  /* moving the cursor does not modify lines */
+  vte_process(&vte, u8_slice_from_cstr("\x1b[2;3H"));
+  assert_eq(screen_generation, generation, "line generations", "cursor movement");
+  vte_process(&vte, u8_slice_from_cstr("x"));
+  assert(screen_get_line(g, 1)->generation > generation);
+  assert_eq(screen_get_line(g, 0)->generation, first, "line generations", "untouched line");
+  vte_process(&vte, u8_slice_from_cstr("\x1b[1;1H\x1b[K"));
+  assert(screen_get_line(g, 0)->generation > first);
+  vte_destroy(&vte);
+}
+
+static void test_lazy_alternate_screen(void) {
+  struct vte vte = vte_default;
+  vte_set_size(&vte, (struct rect){.width = 10, .height = 4});
+  assert_eq(vte.alternate.cells == NULL, true, "lazy alternate screen", "not allocated");
+  vte_process(&vte, u8_slice_from_cstr("\x1b[?1049hx"));
+  assert_eq(vte.alternate.cells != NULL, true, "lazy alternate screen", "allocated");
+  vte_set_size(&vte, (struct rect){.width = 12, .height = 5});
+  assert_eq(vte.alternate.w, 12, "lazy alternate screen", "resized while active");
+  /* the screen is kept for a while after it is left, but not resized */
+  vte_process(&vte, u8_slice_from_cstr("\x1b[?1049l"));
+  assert_eq(vte.alternate.cells != NULL, true, "lazy alternate screen", "kept");
+  vte_set_size(&vte, (struct rect){.width = 10, .height = 4});
+  assert_eq(vte.alternate.cells == NULL, true, "lazy alternate screen", "released on resize");
+  vte_process(&vte, u8_slice_from_cstr("\x1b[?1049h"));
+  assert_eq(screen_get_line(&vte.alternate, 0)->cells[0].cp.value, ' ', "lazy alternate screen", "cleared");
+  /* the release is scheduled by the owner of the emulator, so it does not wait for more output */
+  vte_process(&vte, u8_slice_from_cstr("\x1b[?1049l"));
+  assert_eq(vte_alternate_screen_kept(&vte), true, "lazy alternate screen", "kept after leaving");
+  assert_eq(vte_alternate_screen_expire(&vte), false, "lazy alternate screen", "grace period");
+  vte.alternate_left -= VTE_ALTERNATE_SCREEN_GRACE;
+  assert_eq(vte_alternate_screen_expire(&vte), true, "lazy alternate screen", "expired");
+  assert_eq(vte.alternate.cells == NULL, true, "lazy alternate screen", "released after grace period");
+  vte_destroy(&vte);
+}
+
+static void test_scrollback_trimming(void) {
+  struct vte vte = vte_default;
+  vte_set_size(&vte, (struct rect){.width = 10, .height = 4});
+  struct screen *g = vte_get_current_screen(&vte);
+  char buf[32];
+  for (int i = 0; i < 2000; i++) {
+    snprintf(buf, sizeof(buf), "%d\r\n", i);
+    vte_process(&vte, u8_slice_from_cstr(buf));
+  }
+  int height = g->scroll.height;
+  size_t before = vte_memory_total(vte_get_memory(&vte));
+  screen_compress_history(g);
+  assert_eq(g->scroll.height, height, "scrollback trimming", "compressed height");
+  assert_eq(g->archive->n_lines, height, "scrollback trimming", "compressed lines");
+  assert_eq(vte_memory_total(vte_get_memory(&vte)) < before, true, "scrollback trimming", "compressed memory");
+  assert_eq(line_number(screen_get_line(g, -1)), 1996, "scrollback trimming", "newest line");
+  screen_drop_scrollback(g, 1000);
+  assert_eq(g->scroll.height, height - 1000, "scrollback trimming", "dropped height");
+  assert_eq(line_number(screen_get_line(g, -g->scroll.height)), 1000, "scrollback trimming", "oldest line");
+  /* new lines are stored uncompressed again */
+  vte_process(&vte, u8_slice_from_cstr("x\r\n"));
+  assert_eq(g->history->n_lines, 1, "scrollback trimming", "recent line");
+  vte_destroy(&vte);
+}
+
+static void render_to_string(struct u8_slice s, void *context) {
+  struct string *out = context;
+  string_push_slice(out, s);
+}
+
+static void test_scroll_rendering(void) {
+  struct velvet_scene m = velvet_scene_default;
+  m.size = (struct rect){.width = 20, .height = 6};
+  struct velvet_window win = {.id = 1, .geometry = m.size, .emulator = vte_default};
+  vte_set_size(&win.emulator, m.size);
+  vec_push(&m.windows, &win);
+  struct velvet_window *w = vec_nth(m.windows, 0);
+  struct vte host = vte_default;
+  vte_set_size(&host, m.size);
+  struct string out = {0};
+  char buf[32];
+  for (int i = 0; i < 20; i++) {
+    snprintf(buf, sizeof(buf), "\r\n%d", i);
+    vte_process(&w->emulator, u8_slice_from_cstr(buf));
+    string_clear(&out);
+    velvet_scene_render_damage(&m, render_to_string, &out);
+    vte_process(&host, string_as_u8_slice(out));
+  }
+  /* the last frame scrolled the terminal, and only drew the new line */
+  string_push_char(&out, 0);
+  assert_eq(strstr((char *)out.content, "\x1b[1S") != NULL, true, "scroll rendering", "scrolled");
+  assert_eq(strstr((char *)out.content, "18") == NULL, true, "scroll rendering", "unchanged lines");
+  struct screen *g = vte_get_current_screen(&host);
+  for (int row = 0; row < 6; row++)
+    assert_eq(line_number(screen_get_line(g, row)), 14 + row, "scroll rendering", "host lines");
+  string_destroy(&out);
+  vte_destroy(&host);
+  velvet_scene_destroy(&m);
+}
+
+static void test_render_encoding(void) {
+  struct velvet_scene m = velvet_scene_default;
+  m.size = (struct rect){.width = 20, .height = 3};
+  m.renderer.options.repeat_characters = true;
+  struct velvet_window win = {.id = 1, .geometry = m.size, .emulator = vte_default};
+  vte_set_size(&win.emulator, m.size);
+  vec_push(&m.windows, &win);
+  struct velvet_window *w = vec_nth(m.windows, 0);
+  struct vte host = vte_default;
+  vte_set_size(&host, m.size);
+  struct string out = {0};
+  const char *frames[] = {"", "hello", "!", "\r\n=========="};
+  const char *expected[] = {"\x1b[K", "hello", "!", "=\x1b[9b"};
+  const char *names[] = {"blank rows are erased", "text", "typing does not move the cursor", "runs are repeated"};
+  for (int i = 0; i < 4; i++) {
+    vte_process(&w->emulator, u8_slice_from_cstr(frames[i]));
+    string_clear(&out);
+    velvet_scene_render_damage(&m, render_to_string, &out);
+    vte_process(&host, string_as_u8_slice(out));
+    string_push_char(&out, 0);
+    assert_eq(strstr((char *)out.content, expected[i]) != NULL, true, "render encoding", names[i]);
+    if (i == 2) assert_eq(strchr((char *)out.content, 'H') == NULL, true, "render encoding", "no cursor motion");
+  }
+  /* blank runs with a background other than the theme background are written, not erased */
+  vte_process(&w->emulator, u8_slice_from_cstr("\x1b[3;1H\x1b[48;2;255;0;0m                  \x1b[mx"));
+  string_clear(&out);
+  velvet_scene_render_damage(&m, render_to_string, &out);
+  vte_process(&host, string_as_u8_slice(out));
+  string_push_char(&out, 0);
+  assert_eq(strstr((char *)out.content, "X") == NULL, true, "render encoding", "colored blanks are not erased");
+  struct screen *g = vte_get_current_screen(&host);
+  for (int col = 0; col < 18; col++) {
+    struct color bg = screen_get_style(g, screen_get_line(g, 2)->cells[col].style).bg;
+    assert_eq(bg.kind == VELVET_API_COLOR_KIND_RGB && bg.c.rgb.r == 255 && bg.c.rgb.g == 0, true, "render encoding",
+              "colored blanks");
+  }
+  const char *lines[] = {"hello!", "==========", "                  x"};
+  for (int row = 0; row < 3; row++) {
+    struct screen_line *l = screen_get_line(g, row);
+    for (int col = 0; col < m.size.width; col++) {
+      char ch = col < (int)strlen(lines[row]) ? lines[row][col] : ' ';
+      uint32_t cp = l->cells[col].cp.value ? l->cells[col].cp.value : ' ';
+      assert_eq(cp, (uint32_t)ch, "render encoding", "host content");
+    }
+  }
+  string_destroy(&out);
+  vte_destroy(&host);
+  velvet_scene_destroy(&m);
+}
+
 static void test_lua(void);
 
 static void test_shmem_allocator(void) {
@@ -635,6 +1406,27 @@ int main(void) {
   test_string_joinpath();
   test_base64();
   test_vec();
+  test_text_scanner();
+  test_utf8_decode_run();
+  test_unicode_table();
+  test_vte_table();
+  test_csi_push();
+  test_osc_clipboard_stream();
+  test_hyperlink_reclaim();
+  test_synchronized_update();
+  test_grapheme_clusters();
+  test_style_table();
+  test_lz();
+  test_line_arena();
+  test_scrollback_archive();
+  test_scrollback_spill();
+  test_lazy_reflow();
+  test_scroll_region_rotation();
+  test_line_generations();
+  test_lazy_alternate_screen();
+  test_scrollback_trimming();
+  test_scroll_rendering();
+  test_render_encoding();
   test_lua();
   return n_failures;
 }
@@ -1,7 +1,12 @@
+#include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 #include "collections.h"
 #include "platform.h"
+#include "vte.h"
+#include "velvet_scene.h"
 
 
 void pretty_bytes(uint64_t nb, double *rb, char **pf) {
@@ -34,9 +39,280 @@ uint64_t spam_write(int fd, char *buf, size_t bufsize, uint64_t timeout) {
   return written;
 }
 
+uint64_t spam_parse(struct vte *vte, char *buf, size_t bufsize, uint64_t timeout) {
+  uint64_t now = get_ms_since_startup();
+  uint64_t parsed = 0;
+  struct u8_slice s = { .content = (uint8_t*)buf, .len = bufsize };
+  while ((get_ms_since_startup() - now) < timeout) {
+    vte_process(vte, s);
+    parsed += bufsize;
+  }
+  return parsed;
+}
+
+/* fill |buf| with lines of |alphabet| separated by CRLF, mimicking log output */
+static void fill_lines(char *buf, size_t bufsize, const char *alphabet, int line_length) {
+  size_t n = strlen(alphabet);
+  int col = 0;
+  for (size_t i = 0; i < bufsize; i++) {
+    if (col >= line_length && (alphabet[i % n] & 0xC0) != 0x80) {
+      buf[i++] = '\r';
+      if (i < bufsize) buf[i] = '\n';
+      col = 0;
+      continue;
+    }
+    buf[i] = alphabet[i % n];
+    col++;
+  }
+}
+
+/* fill |buf| with OSC 2 sequences carrying large payloads, mimicking clipboard and image transfers */
+static void fill_strings(char *buf, size_t bufsize, int payload_length) {
+  static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  size_t i = 0;
+  while (i + payload_length + 6 <= bufsize) {
+    memcpy(buf + i, "\x1b]2;", 4);
+    i += 4;
+    for (int j = 0; j < payload_length; j++) buf[i++] = alphabet[j % (sizeof(alphabet) - 1)];
+    buf[i++] = '\x1b';
+    buf[i++] = '\\';
+  }
+  memset(buf + i, 'a', bufsize - i);
+}
+
+/* fill |buf| with lines scrolled through a scroll region in both directions, mimicking pagers and editors
+ * which keep status lines at the top and bottom of a screen of |height| lines */
+static void fill_region_scrolls(char *buf, size_t bufsize, int height) {
+  char pattern[1024];
+  int n = snprintf(pattern, sizeof(pattern), "\x1b[2;%dr\x1b[%dH", height - 1, height - 1);
+  for (int i = 0; i < 10; i++) n += snprintf(pattern + n, sizeof(pattern) - n, "\nscrolled forward %d\r", i);
+  n += snprintf(pattern + n, sizeof(pattern) - n, "\x1b[2H");
+  for (int i = 0; i < 10; i++) n += snprintf(pattern + n, sizeof(pattern) - n, "\x1bMscrolled back %d\r", i);
+  n += snprintf(pattern + n, sizeof(pattern) - n, "\x1b[r");
+  size_t i = 0;
+  for (; i + n <= bufsize; i += n) memcpy(buf + i, pattern, n);
+  memset(buf + i, 'a', bufsize - i);
+}
+
+/* fill |buf| with line edits of a screen of |height| lines, mimicking full screen applications which erase, insert,
+ * delete and repeat characters to update lines in place */
+static void fill_edits(char *buf, size_t bufsize, int height) {
+  char pattern[4096];
+  int n = 0;
+  for (int row = 1; row <= height; row++) {
+    n += snprintf(pattern + n, sizeof(pattern) - n, "\x1b[%dH\x1b[2Kline %d\x1b[4@\x1b[2P\x1b[8X-\x1b[40b\x1b[10G\x1b[K",
+                  row, row);
+  }
+  n += snprintf(pattern + n, sizeof(pattern) - n, "\x1b[H\x1b[J");
+  size_t i = 0;
+  for (; i + n <= bufsize; i += n) memcpy(buf + i, pattern, n);
+  memset(buf + i, 'a', bufsize - i);
+}
+
+/* parse a buffer in-process once for each available scanner implementation. This
+ * measures the emulator without the pty and the host terminal in the way. */
+static void bench_parse(int timeout) {
+  static char buf[1 << 16];
+  struct vte vte = vte_default;
+  vte_set_size(&vte, (struct rect){.width = 120, .height = 40});
+
+  enum text_scanner_kind kinds[] = { TEXT_SCANNER_SCALAR, TEXT_SCANNER_SSE2, TEXT_SCANNER_AVX2 };
+  struct { char *name; char *alphabet; } inputs[] = {
+    { "ascii", "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ" },
+    { "glyphs", "ø󰬄󰬞󱁬󱉈󰼃󰽗󱑶󰩡󰡾󱤞" },
+    /* colored output with cursor movement, typical of TUIs */
+    { "escapes", "\x1b[1;31mred\x1b[0m \x1b[38;5;208mfg\x1b[m \x1b[38;2;10;20;30;48:2::40:50:60mrgb\x1b[12;40H\x1b[K" },
+  };
+
+  for (int i = 0; i < LENGTH(inputs) + 3; i++) {
+    char *input;
+    if (i < LENGTH(inputs)) {
+      fill_lines(buf, LENGTH(buf), inputs[i].alphabet, 100);
+      input = inputs[i].name;
+    } else if (i == LENGTH(inputs)) {
+      fill_strings(buf, LENGTH(buf), 8000);
+      input = "strings";
+    } else if (i == LENGTH(inputs) + 1) {
+      fill_region_scrolls(buf, LENGTH(buf), 40);
+      input = "regions";
+    } else {
+      fill_edits(buf, LENGTH(buf), 40);
+      input = "edits";
+    }
+    for (int k = 0; k < LENGTH(kinds); k++) {
+      if (text_scanner_select(kinds[k]) != kinds[k]) continue;
+      uint64_t parsed = spam_parse(&vte, buf, LENGTH(buf), timeout);
+      char name[64];
+      snprintf(name, sizeof(name), "parse %s (%s)", input, text_scanner_name(kinds[k]));
+      report(name, (double)timeout / 1000, parsed);
+    }
+  }
+  text_scanner_select(TEXT_SCANNER_AUTO);
+  vte_destroy(&vte);
+}
+
+static uint32_t xorshift(uint32_t *state) {
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *state = x;
+}
+
+/* a line of source code, mimicking the content of an editor */
+static int source_line(char *buf, size_t bufsize, int n) {
+  static const char *words[] = {"if", "(state->count", ">", "limit)", "return", "update(value,", "offset);", "int",
+                                "total", "=", "0;", "for", "(i", "<", "n;", "i++)", "{", "}", "// comment"};
+  int indent = (n * 7 % 5) * 2;
+  int len = snprintf(buf, bufsize, "%*s", indent, "");
+  int words_in_line = n * 13 % 9;
+  for (int i = 0; i < words_in_line; i++)
+    len += snprintf(buf + len, bufsize - len, "%s%s", i ? " " : "", words[(n * 3 + i * 5) % LENGTH(words)]);
+  return len;
+}
+
+/* colored log lines tailing at the bottom of the window */
+static void feed_logs(struct vte *vte, int frame, uint32_t *seed) {
+  char buf[256];
+  for (int i = 0; i < 2; i++) {
+    int n = frame * 2 + i;
+    snprintf(buf, sizeof(buf), "\x1b[2m12:%02d:%02d\x1b[m \x1b[%dm%s\x1b[m request %u served in %ums\r\n", n / 60 % 60,
+             n % 60, n % 7 ? 32 : 31, n % 7 ? "INFO " : "ERROR", xorshift(seed) % 100000, xorshift(seed) % 500);
+    vte_process(vte, u8_slice_from_cstr(buf));
+  }
+}
+
+/* a full screen editor: a line is rewritten, a word is typed at a random position, and the status line is updated */
+static void feed_editor(struct vte *vte, int frame, uint32_t *seed) {
+  char buf[512];
+  int h = vte->ws.height;
+  if (frame == 0) {
+    vte_process(vte, u8_slice_from_cstr("\x1b[H\x1b[2J"));
+    for (int row = 1; row < h; row++) {
+      int n = snprintf(buf, sizeof(buf), "\x1b[%dH\x1b[33m%4d\x1b[m ", row, row);
+      source_line(buf + n, sizeof(buf) - n, row);
+      vte_process(vte, u8_slice_from_cstr(buf));
+    }
+  }
+  int row = 1 + xorshift(seed) % (h - 1);
+  int n = snprintf(buf, sizeof(buf), "\x1b[%dH\x1b[2K\x1b[33m%4d\x1b[m ", row, row);
+  source_line(buf + n, sizeof(buf) - n, frame);
+  vte_process(vte, u8_slice_from_cstr(buf));
+  snprintf(buf, sizeof(buf), "\x1b[%u;%uH\x1b[1mword%u\x1b[m", 1 + xorshift(seed) % (h - 1), 6 + xorshift(seed) % 60,
+           xorshift(seed) % 100);
+  vte_process(vte, u8_slice_from_cstr(buf));
+  snprintf(buf, sizeof(buf), "\x1b[%dH\x1b[7m NORMAL \x1b[m main.c\x1b[K\x1b[%dG%d:%d", h, vte->ws.width - 12, row, frame % 80);
+  vte_process(vte, u8_slice_from_cstr(buf));
+}
+
+/* a process monitor which updates a few numbers in a table every frame */
+static void feed_monitor(struct vte *vte, int frame, uint32_t *seed) {
+  char buf[256];
+  int h = vte->ws.height;
+  if (frame == 0) {
+    vte_process(vte, u8_slice_from_cstr("\x1b[H\x1b[2J\x1b[30;42m  PID USER      CPU%  MEM%  COMMAND\x1b[K\x1b[m"));
+    for (int row = 2; row <= h; row++) {
+      snprintf(buf, sizeof(buf), "\x1b[%dH%5d velvet   \x1b[10X\x1b[25Gprocess-%d", row, 1000 + row, row);
+      vte_process(vte, u8_slice_from_cstr(buf));
+    }
+  }
+  for (int i = 0; i < 8; i++) {
+    int row = 2 + xorshift(seed) % (h - 1);
+    snprintf(buf, sizeof(buf), "\x1b[%d;16H\x1b[%dm%4.1f  %4.1f\x1b[m", row, 31 + frame % 3, (xorshift(seed) % 1000) / 10.0,
+             (xorshift(seed) % 1000) / 10.0);
+    vte_process(vte, u8_slice_from_cstr(buf));
+  }
+}
+
+/* a pager which repaints the whole screen with the next page of a file below a ruler */
+static void feed_pager(struct vte *vte, int frame, uint32_t *seed) {
+  char buf[512];
+  (void)seed;
+  vte_process(vte, u8_slice_from_cstr("\x1b[H\x1b[2J"));
+  int n = snprintf(buf, sizeof(buf), "\x1b[1;34m");
+  int offset = frame % (vte->ws.width / 2);
+  for (int col = 0; col < offset; col++) n += snprintf(buf + n, sizeof(buf) - n, "─");
+  n += snprintf(buf + n, sizeof(buf) - n, " page %d ", frame);
+  for (int col = offset + 12; col < vte->ws.width; col++) n += snprintf(buf + n, sizeof(buf) - n, "─");
+  snprintf(buf + n, sizeof(buf) - n, "\x1b[m");
+  vte_process(vte, u8_slice_from_cstr(buf));
+  for (int row = 2; row <= vte->ws.height; row++) {
+    n = snprintf(buf, sizeof(buf), "\x1b[%dH", row);
+    source_line(buf + n, sizeof(buf) - n, frame * vte->ws.height + row);
+    vte_process(vte, u8_slice_from_cstr(buf));
+  }
+}
+
+static uint64_t now_us(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void count_bytes(struct u8_slice s, void *context) {
+  *(uint64_t *)context += s.len;
+}
+
+/* render frames of a scene while its windows produce output, and report the bytes written to the terminal. This
+ * measures the encoding of screen updates. */
+static void bench_render(int frames) {
+  struct {
+    char *name;
+    /* the number of windows, side by side */
+    int windows;
+    void (*feed)(struct vte *vte, int frame, uint32_t *seed);
+  } workloads[] = {
+    {"logs", 1, feed_logs},
+    {"tiled logs", 2, feed_logs},
+    {"editor", 1, feed_editor},
+    {"monitor", 1, feed_monitor},
+    {"pager", 1, feed_pager},
+  };
+
+  /* each workload is rendered as is, and with REP enabled */
+  for (int i = 0; i < LENGTH(workloads) * 2; i++) {
+    bool repeat = i >= LENGTH(workloads);
+    struct velvet_scene m = velvet_scene_default;
+    m.size = (struct rect){.width = 120, .height = 40};
+    m.renderer.options.repeat_characters = repeat;
+    int n_windows = workloads[i % LENGTH(workloads)].windows;
+    int width = m.size.width / n_windows;
+    for (int k = 0; k < n_windows; k++) {
+      struct velvet_window win = {.id = k + 1, .emulator = vte_default};
+      win.geometry = (struct rect){.left = k * width, .width = width, .height = m.size.height};
+      vte_set_size(&win.emulator, win.geometry);
+      vec_push(&m.windows, &win);
+    }
+
+    uint32_t seed = 0x9e3779b9;
+    uint64_t bytes = 0;
+    uint64_t elapsed = 0;
+    struct velvet_window *win;
+    for (int frame = 0; frame < frames; frame++) {
+      vec_foreach(win, m.windows) workloads[i % LENGTH(workloads)].feed(&win->emulator, frame, &seed);
+      uint64_t start = now_us();
+      velvet_scene_render_damage(&m, count_bytes, &bytes);
+      elapsed += now_us() - start;
+    }
+    printf("render %s%s: %.0f bytes/frame (%.1f us/frame)\n", workloads[i % LENGTH(workloads)].name,
+           repeat ? " (rep)" : "", (double)bytes / frames, (double)elapsed / frames);
+    velvet_scene_destroy(&m);
+  }
+}
+
 int main(int argc, char **argv) {
   uint64_t ascii_write = 0;
 
+  if (argc > 1 && strcmp(argv[1], "parse") == 0) {
+    bench_parse(argc > 2 ? atoi(argv[2]) : 1000);
+    return 0;
+  }
+
+  if (argc > 1 && strcmp(argv[1], "render") == 0) {
+    bench_render(argc > 2 ? atoi(argv[2]) : 2000);
+    return 0;
+  }
+
   int timeout = argc > 1 ? atoi(argv[1]) : 1000;
 
   char buf[1 << 16];
@@ -0,0 +1,520 @@
+/***************************************************
+************ DO NOT EDIT THIS BY HAND **************
+*** This file was auto generated by generate.lua ****
+***************************************************/
+
+#ifndef VELVET_API_H
+#define VELVET_API_H
+
+#include "lua.h"
+#include <stdbool.h>
+#include "collections.h"
+
+typedef lua_Integer lua_stackIndex;
+typedef lua_Integer lua_stackRetCount;
+struct velvet;
+/* The severity level of a message */
+enum velvet_api_severity {
+  VELVET_API_SEVERITY_DEBUG = 0,
+  VELVET_API_SEVERITY_INFO = 1,
+  VELVET_API_SEVERITY_WARNING = 2,
+  VELVET_API_SEVERITY_ERROR = 3,
+};
+
+/* Mouse reporting mode. */
+enum velvet_api_mouse_reporting {
+  /* Never report mouse events. */
+  VELVET_API_MOUSE_REPORTING_OFF = 0,
+  /* Report mouse click events. */
+  VELVET_API_MOUSE_REPORTING_CLICK = 1000,
+  /* Report mouse events on move while a mouse button is down. */
+  VELVET_API_MOUSE_REPORTING_CELL_MOTION = 1002,
+  /* Report mouse events on move. */
+  VELVET_API_MOUSE_REPORTING_ALL_MOTION = 1003,
+};
+
+/* The protocol to use for mouse reporting */
+enum velvet_api_mouse_protocol {
+  /* No mouse reporting. */
+  VELVET_API_MOUSE_PROTOCOL_OFF = 0,
+  /* Coordinates encoded as SGR sequences. */
+  VELVET_API_MOUSE_PROTOCOL_SGR = 1006,
+  /* Coordinates encoded as utf8. */
+  VELVET_API_MOUSE_PROTOCOL_UTF8 = 1005,
+  /* urxvt encoding */
+  VELVET_API_MOUSE_PROTOCOL_URXVT = 1015,
+  /* Coordinates encoded as SGR sequences. Encoded as pixel positions instead of cell coordinates. */
+  VELVET_API_MOUSE_PROTOCOL_SGR_PIXEL = 1016,
+};
+
+/* A named brush */
+enum velvet_api_brush {
+  VELVET_API_BRUSH_BACKGROUND = 0,
+  VELVET_API_BRUSH_FOREGROUND = 1,
+};
+
+/* The transparency mode of a window. This affects the behavior of the |alpha| setting. */
+enum velvet_api_transparency_mode {
+  /* Disable alpha blending */
+  VELVET_API_TRANSPARENCY_MODE_NONE = 0,
+  /* alpha blending applies to cells with no background color */
+  VELVET_API_TRANSPARENCY_MODE_CLEAR = 1,
+  /* alpha blending applies to all cells */
+  VELVET_API_TRANSPARENCY_MODE_ALL = 2,
+};
+
+/* Storage of the scrollback of a window. */
+enum velvet_api_scrollback_mode {
+  /* Keep a bounded scrollback in memory. Old lines are compressed. */
+  VELVET_API_SCROLLBACK_MODE_MEMORY = 0,
+  /* Keep an unlimited scrollback. Old lines are compressed and spilled to a memory-mapped temporary file. */
+  VELVET_API_SCROLLBACK_MODE_DISK = 1,
+};
+
+enum velvet_api_key_event_type {
+  VELVET_API_KEY_EVENT_TYPE_PRESS = 1,
+  VELVET_API_KEY_EVENT_TYPE_REPEAT = 2,
+  VELVET_API_KEY_EVENT_TYPE_RELEASE = 3,
+};
+
+enum velvet_api_key_modifier {
+  VELVET_API_KEY_MODIFIER_SHIFT = 1,
+  VELVET_API_KEY_MODIFIER_ALT = 2,
+  VELVET_API_KEY_MODIFIER_CONTROL = 4,
+  VELVET_API_KEY_MODIFIER_SUPER = 8,
+  VELVET_API_KEY_MODIFIER_HYPER = 16,
+  VELVET_API_KEY_MODIFIER_META = 32,
+  VELVET_API_KEY_MODIFIER_CAPS_LOCK = 64,
+  VELVET_API_KEY_MODIFIER_NUM_LOCK = 128,
+};
+
+enum velvet_api_scroll_direction {
+  VELVET_API_SCROLL_DIRECTION_UP = 0,
+  VELVET_API_SCROLL_DIRECTION_DOWN = 1,
+  VELVET_API_SCROLL_DIRECTION_LEFT = 2,
+  VELVET_API_SCROLL_DIRECTION_RIGHT = 3,
+};
+
+enum velvet_api_mouse_button {
+  VELVET_API_MOUSE_BUTTON_LEFT = 0,
+  VELVET_API_MOUSE_BUTTON_MIDDLE = 1,
+  VELVET_API_MOUSE_BUTTON_RIGHT = 2,
+  VELVET_API_MOUSE_BUTTON_NONE = 3,
+};
+
+enum velvet_api_mouse_event_type {
+  VELVET_API_MOUSE_EVENT_TYPE_MOUSE_DOWN = 1,
+  VELVET_API_MOUSE_EVENT_TYPE_MOUSE_UP = 2,
+};
+
+enum __attribute__((packed)) velvet_api_color_kind {
+  /* No color. Falls back to default background/foreground color. This also affects pseudotransparency behavior. If any background color is set except |reset|, a surface is considered opaque by the compositor. */
+  VELVET_API_COLOR_KIND_RESET = 0,
+  /* Indicates a full rgb color */
+  VELVET_API_COLOR_KIND_RGB = 1,
+  /* Indicates one of the 16 pre-defined ansi colors or an xterm-256color */
+  VELVET_API_COLOR_KIND_TABLE = 2,
+};
+
+/* Unix process signal. */
+enum velvet_api_unix_signal {
+  /* Hangup. */
+  VELVET_API_UNIX_SIGNAL_HUP = 0,
+  /* Interrupt. */
+  VELVET_API_UNIX_SIGNAL_INT = 1,
+  /* Quit and produce a core dump. */
+  VELVET_API_UNIX_SIGNAL_QUIT = 2,
+  /* Terminate immediately. This signal cannot be caught or ignored. */
+  VELVET_API_UNIX_SIGNAL_KILL = 3,
+  /* User-defined signal 1. */
+  VELVET_API_UNIX_SIGNAL_USR1 = 4,
+  /* User-defined signal 2. */
+  VELVET_API_UNIX_SIGNAL_USR2 = 5,
+  /* Alarm clock. */
+  VELVET_API_UNIX_SIGNAL_ALRM = 6,
+  /* Request graceful termination. */
+  VELVET_API_UNIX_SIGNAL_TERM = 7,
+  /* Suspend execution. This signal cannot be caught or ignored. */
+  VELVET_API_UNIX_SIGNAL_STOP = 8,
+  /* Resume a suspended process. */
+  VELVET_API_UNIX_SIGNAL_CONT = 9,
+};
+
+/* The mouse settings used by a specific window. */
+struct velvet_api_mouse_settings {
+  enum velvet_api_mouse_reporting reporting;
+  enum velvet_api_mouse_protocol protocol;
+};
+
+/* rgb color with colors values in the range 0 < |col| < 1 */
+struct velvet_api_rgb_color {
+  float red;
+  float green;
+  float blue;
+  struct {
+    float value;
+    bool set;
+  } alpha;
+};
+
+/* low level color */
+struct velvet_api_cell_color {
+  /* RGB color */
+  struct {
+    struct velvet_api_rgb_color value;
+    bool set;
+  } rgb;
+  /* xterm-256 color table value */
+  struct {
+    int value;
+    bool set;
+  } table;
+};
+
+struct velvet_api_theme {
+  /* Palette color 0 */
+  struct velvet_api_rgb_color black;
+  /* Palette color 1 */
+  struct velvet_api_rgb_color red;
+  /* Palette color 2 */
+  struct velvet_api_rgb_color green;
+  /* Palette color 3 */
+  struct velvet_api_rgb_color yellow;
+  /* Palette color 4 */
+  struct velvet_api_rgb_color blue;
+  /* Palette color 5 */
+  struct velvet_api_rgb_color magenta;
+  /* Palette color 6 */
+  struct velvet_api_rgb_color cyan;
+  /* Palette color 7 */
+  struct velvet_api_rgb_color white;
+  /* Palette color 8 */
+  struct velvet_api_rgb_color bright_black;
+  /* Palette color 9 */
+  struct velvet_api_rgb_color bright_red;
+  /* Palette color 10 */
+  struct velvet_api_rgb_color bright_green;
+  /* Palette color 11 */
+  struct velvet_api_rgb_color bright_yellow;
+  /* Palette color 12 */
+  struct velvet_api_rgb_color bright_blue;
+  /* Palette color 13 */
+  struct velvet_api_rgb_color bright_magenta;
+  /* Palette color 14 */
+  struct velvet_api_rgb_color bright_cyan;
+  /* Palette color 15 */
+  struct velvet_api_rgb_color bright_white;
+  /* The default text color */
+  struct velvet_api_rgb_color foreground;
+  /* The default background color */
+  struct velvet_api_rgb_color background;
+  /* The foreground color of the cell containing the cursor */
+  struct {
+    struct velvet_api_rgb_color value;
+    bool set;
+  } cursor_foreground;
+  /* The background color of the cell containing the cursor */
+  struct {
+    struct velvet_api_rgb_color value;
+    bool set;
+  } cursor_background;
+  /* Bright colors set cell style to bold */
+  struct {
+    bool value;
+    bool set;
+  } bold_bright_colors;
+};
+
+struct velvet_api_process_spawn_options {
+  /* The initial working directory of the new process. */
+  struct {
+    struct u8_slice value;
+    bool set;
+  } working_directory;
+  /* Optional table of environment variables to set in the new process. */
+  struct {
+    lua_stackIndex value;
+    bool set;
+  } environment;
+  /* If true, a pipe will be allocated for stdin. */
+  bool stdin_pipe;
+  /* Callback invoked when the process produces output on stdout. */
+  struct {
+    lua_Integer value;
+    bool set;
+  } on_stdout;
+  /* Callback invoked when the process produces output on stderr. */
+  struct {
+    lua_Integer value;
+    bool set;
+  } on_stderr;
+  /* Callback invoked when the process exits. */
+  struct {
+    lua_Integer value;
+    bool set;
+  } on_exit;
+};
+
+struct velvet_api_window_create_options {
+  /* The initial working directory of the new window. */
+  struct {
+    struct u8_slice value;
+    bool set;
+  } working_directory;
+  /* The parent window of this window. If set, this window will close with the parent. */
+  struct {
+    int value;
+    bool set;
+  } parent_window;
+  /* Optional table of environment variables to set in the new process. */
+  struct {
+    lua_stackIndex value;
+    bool set;
+  } environment;
+};
+
+struct velvet_api_rect {
+  /* The leftmost cell of the window. */
+  int left;
+  /* The topmost cell of the window. */
+  int top;
+  /* The width of the window */
+  int width;
+  /* The height of the window */
+  int height;
+};
+
+struct velvet_api_screen_geometry {
+  /* The width of the screen */
+  int width;
+  /* The height of the screen */
+  int height;
+};
+
+struct velvet_api_window_created_event_args {
+  /* The id of the newly created window. */
+  int win_id;
+};
+
+struct velvet_api_window_closed_event_args {
+  /* The id of the closed window. */
+  int win_id;
+};
+
+struct velvet_api_window_output_event_args {
+  /* The id of the window that received output. */
+  int win_id;
+};
+
+struct velvet_api_window_bell_event_args {
+  /* The id of the window that sent BEL. */
+  int win_id;
+};
+
+struct velvet_api_window_moved_event_args {
+  /* The id of the resized window. */
+  int win_id;
+  /* The old geometry of |id|. */
+  struct velvet_api_rect old_size;
+  /* The new geometry of |id|. */
+  struct velvet_api_rect new_size;
+};
+
+struct velvet_api_window_resized_event_args {
+  /* The id of the resized window. */
+  int win_id;
+  /* The old geometry of |id|. */
+  struct velvet_api_rect old_size;
+  /* The new geometry of |id|. */
+  struct velvet_api_rect new_size;
+};
+
+struct velvet_api_window_focus_changed_event_args {
+  /* The previous focused window. */
+  int old_focus;
+  /* The new focused window. */
+  int new_focus;
+};
+
+struct velvet_api_screen_resized_event_args {
+  /* The old screen size */
+  struct velvet_api_screen_geometry old_size;
+  /* The new screen size */
+  struct velvet_api_screen_geometry new_size;
+};
+
+struct velvet_api_window_key_event {
+  /* Unicode codepoint of the key generating the event. */
+  int codepoint;
+  /* Shifted unicode codepoint of the key generating the event. This is only set if the key was shifted. */
+  int alternate_codepoint;
+  /* Key name, such as 'F1' */
+  struct u8_slice name;
+  /* Event type, such as key press, repeat, and release. */
+  enum velvet_api_key_event_type event_type;
+  /* Key modifier such as super, shift, control, alt */
+  enum velvet_api_key_modifier modifiers;
+};
+
+struct velvet_api_window_on_key_event_args {
+  /* The id of the window the keys were sent to. */
+  int win_id;
+  /* The key which generated the event. */
+  struct velvet_api_window_key_event key;
+};
+
+/* A line of text extracted from a window */
+struct velvet_api_line {
+  /* Text content */
+  struct u8_slice text;
+  /* True if the line continues on the next row */
+  bool wraps;
+  /* True if the first cell is a continuation of a wide character. If set, the first character of |text| will be a space. */
+  bool truncated;
+};
+
+/* Memory usage of the compressed part of a scrollback. Recent lines are stored uncompressed and are not included. */
+struct velvet_api_scrollback_compression {
+  /* The number of compressed lines. */
+  int lines;
+  /* The size of the compressed lines if they were stored uncompressed. */
+  int raw_bytes;
+  /* The size of the compressed lines. */
+  int compressed_bytes;
+  /* The part of compressed_bytes which was spilled to disk. */
+  int spilled_bytes;
+  /* raw_bytes / compressed_bytes, or 1 if nothing is compressed. */
+  float ratio;
+};
+
+/* Heap memory used by the emulator of a window, in bytes. Scrollback spilled to disk is not included. */
+struct velvet_api_memory_usage {
+  /* The cells of the screens and of the recent scrollback lines. */
+  int cells;
+  /* Line bookkeeping of the screens and the scrollback. */
+  int lines;
+  /* The style tables of the screens. */
+  int styles;
+  /* The hyperlinks referenced by cells. */
+  int hyperlinks;
+  /* The compressed part of the scrollback. */
+  int scrollback;
+  /* The sum of the other fields. */
+  int total;
+};
+
+/* 1-indexed screen coordinate */
+struct velvet_api_coordinate {
+  /* row */
+  int row;
+  /* column */
+  int col;
+};
+
+struct velvet_api_on_key_event_args {
+  /* The key which generated the event. */
+  struct velvet_api_window_key_event key;
+};
+
+struct velvet_api_mouse_move_event_args {
+  /* The id of the topmost visible window at the coordinates. */
+  int win_id;
+  /* 1-indexed screen coordinate of the mouse when the event was raised. */
+  struct velvet_api_coordinate pos;
+  /* Mouse button state when the event was raised. */
+  enum velvet_api_mouse_button mouse_button;
+  /* The keyboard modifier which were held when the event was raised. */
+  enum velvet_api_key_modifier modifiers;
+};
+
+struct velvet_api_mouse_click_event_args {
+  /* The id of the topmost visible window at the coordinates. */
+  int win_id;
+  /* 1-indexed screen coordinate of the mouse when the event was raised. */
+  struct velvet_api_coordinate pos;
+  /* The mouse button which was clicked. */
+  enum velvet_api_mouse_button mouse_button;
+  /* Flag indicating if the button was pressed or released. */
+  enum velvet_api_mouse_event_type event_type;
+  /* The keyboard modifier which were held when the event was raised. */
+  enum velvet_api_key_modifier modifiers;
+};
+
+struct velvet_api_mouse_scroll_event_args {
+  /* The id of the topmost visible window at the coordinates. */
+  int win_id;
+  /* 1-indexed screen coordinate of the mouse when the event was raised. */
+  struct velvet_api_coordinate pos;
+  /* The scroll direction which raised the event. */
+  enum velvet_api_scroll_direction direction;
+  /* The keyboard modifier which were held when the event was raised. */
+  enum velvet_api_key_modifier modifiers;
+};
+
+struct velvet_api_pre_render_event_args {
+  /* The number of milliseconds elapsed since startup */
+  int time;
+  /* The reason for the render, such as 'io_idle' or 'io_max_exceeded' */
+  struct u8_slice cause;
+};
+
+struct velvet_api_system_message_event_args {
+  /* The message */
+  struct u8_slice message;
+  /* Error level */
+  enum velvet_api_severity level;
+};
+
+struct velvet_api_pre_reload_event_args {
+  /* The number of milliseconds elapsed since startup */
+  int time;
+};
+
+/* client specific options of an attached client. */
+struct velvet_api_client_options {
+  /* The number of horizontal pixels. */
+  int x_pixel;
+  /* The number of vertical pixels. */
+  int y_pixel;
+  /* The number of lines. */
+  int lines;
+  /* The number of columns. */
+  int columns;
+};
+
+struct optional_int { int value; bool set; };
+
+/* Raised when a key is pressed. */
+void velvet_api_raise_on_key(struct velvet *v, __attribute__((unused)) struct velvet_api_on_key_event_args args);
+/* Raised after a new window is created. */
+void velvet_api_raise_window_created(struct velvet *v, __attribute__((unused)) struct velvet_api_window_created_event_args args);
+/* Raised after a window is closed. */
+void velvet_api_raise_window_closed(struct velvet *v, __attribute__((unused)) struct velvet_api_window_closed_event_args args);
+/* Raised when a window produces output. */
+void velvet_api_raise_window_output(struct velvet *v, __attribute__((unused)) struct velvet_api_window_output_event_args args);
+/* Raised when a window sends BEL. */
+void velvet_api_raise_window_bell(struct velvet *v, __attribute__((unused)) struct velvet_api_window_bell_event_args args);
+/* Raised after a window is moved. */
+void velvet_api_raise_window_moved(struct velvet *v, __attribute__((unused)) struct velvet_api_window_moved_event_args args);
+/* Raised after a window is resized. */
+void velvet_api_raise_window_resized(struct velvet *v, __attribute__((unused)) struct velvet_api_window_resized_event_args args);
+/* Raised when a key is sent to a lua window. */
+void velvet_api_raise_window_on_key(struct velvet *v, __attribute__((unused)) struct velvet_api_window_on_key_event_args args);
+/* Raised after focus changes. */
+void velvet_api_raise_window_focus_changed(struct velvet *v, __attribute__((unused)) struct velvet_api_window_focus_changed_event_args args);
+/* Raised after the screen is resized. */
+void velvet_api_raise_screen_resized(struct velvet *v, __attribute__((unused)) struct velvet_api_screen_resized_event_args args);
+/* Raised when the mouse moves. */
+void velvet_api_raise_mouse_move(struct velvet *v, __attribute__((unused)) struct velvet_api_mouse_move_event_args args);
+/* Raised when the mouse is clicked. */
+void velvet_api_raise_mouse_click(struct velvet *v, __attribute__((unused)) struct velvet_api_mouse_click_event_args args);
+/* Raised when the mouse scrolls. */
+void velvet_api_raise_mouse_scroll(struct velvet *v, __attribute__((unused)) struct velvet_api_mouse_scroll_event_args args);
+/* Raised when the system logs an error message */
+void velvet_api_raise_system_message(struct velvet *v, __attribute__((unused)) struct velvet_api_system_message_event_args args);
+/* Raised right before content is rendered. This is useful for applying updates just-in-time. */
+void velvet_api_raise_pre_render(struct velvet *v, __attribute__((unused)) struct velvet_api_pre_render_event_args args);
+/* Raised before reloading. This event can be used to store state. */
+void velvet_api_raise_pre_reload(struct velvet *v, __attribute__((unused)) struct velvet_api_pre_reload_event_args args);
+
+#endif /* VELVET_API_H */
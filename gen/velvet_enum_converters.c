@@ -0,0 +1,459 @@
+/***************************************************
+************ DO NOT EDIT THIS BY HAND **************
+*** This file was auto generated by generate.lua ****
+***************************************************/
+#include "velvet_api.h"
+
+__attribute__((unused)) static int severity_slice_to_enum(struct u8_slice str) {
+  struct u8_slice debug_str = {.content = (const uint8_t *)"debug", .len = 5};
+  if (u8_slice_equals(str, debug_str))
+    return VELVET_API_SEVERITY_DEBUG;
+
+  struct u8_slice info_str = {.content = (const uint8_t *)"info", .len = 4};
+  if (u8_slice_equals(str, info_str))
+    return VELVET_API_SEVERITY_INFO;
+
+  struct u8_slice warning_str = {.content = (const uint8_t *)"warning", .len = 7};
+  if (u8_slice_equals(str, warning_str))
+    return VELVET_API_SEVERITY_WARNING;
+
+  struct u8_slice error_str = {.content = (const uint8_t *)"error", .len = 5};
+  if (u8_slice_equals(str, error_str))
+    return VELVET_API_SEVERITY_ERROR;
+
+  return ~0;
+}
+
+__attribute__((unused)) static struct u8_slice severity_to_slice(enum velvet_api_severity value) {
+  switch (value) {
+  case VELVET_API_SEVERITY_DEBUG:
+    return (struct u8_slice){.content = (const uint8_t *)"debug", .len = 5};
+  case VELVET_API_SEVERITY_INFO:
+    return (struct u8_slice){.content = (const uint8_t *)"info", .len = 4};
+  case VELVET_API_SEVERITY_WARNING:
+    return (struct u8_slice){.content = (const uint8_t *)"warning", .len = 7};
+  case VELVET_API_SEVERITY_ERROR:
+    return (struct u8_slice){.content = (const uint8_t *)"error", .len = 5};
+  default: assert(!"severity value out of range");
+  };
+}
+
+__attribute__((unused)) static int mouse_reporting_slice_to_enum(struct u8_slice str) {
+  struct u8_slice off_str = {.content = (const uint8_t *)"off", .len = 3};
+  if (u8_slice_equals(str, off_str))
+    return VELVET_API_MOUSE_REPORTING_OFF;
+
+  struct u8_slice click_str = {.content = (const uint8_t *)"click", .len = 5};
+  if (u8_slice_equals(str, click_str))
+    return VELVET_API_MOUSE_REPORTING_CLICK;
+
+  struct u8_slice cell_motion_str = {.content = (const uint8_t *)"cell_motion", .len = 11};
+  if (u8_slice_equals(str, cell_motion_str))
+    return VELVET_API_MOUSE_REPORTING_CELL_MOTION;
+
+  struct u8_slice all_motion_str = {.content = (const uint8_t *)"all_motion", .len = 10};
+  if (u8_slice_equals(str, all_motion_str))
+    return VELVET_API_MOUSE_REPORTING_ALL_MOTION;
+
+  return ~0;
+}
+
+__attribute__((unused)) static struct u8_slice mouse_reporting_to_slice(enum velvet_api_mouse_reporting value) {
+  switch (value) {
+  case VELVET_API_MOUSE_REPORTING_OFF:
+    return (struct u8_slice){.content = (const uint8_t *)"off", .len = 3};
+  case VELVET_API_MOUSE_REPORTING_CLICK:
+    return (struct u8_slice){.content = (const uint8_t *)"click", .len = 5};
+  case VELVET_API_MOUSE_REPORTING_CELL_MOTION:
+    return (struct u8_slice){.content = (const uint8_t *)"cell_motion", .len = 11};
+  case VELVET_API_MOUSE_REPORTING_ALL_MOTION:
+    return (struct u8_slice){.content = (const uint8_t *)"all_motion", .len = 10};
+  default: assert(!"mouse_reporting value out of range");
+  };
+}
+
+__attribute__((unused)) static int mouse_protocol_slice_to_enum(struct u8_slice str) {
+  struct u8_slice off_str = {.content = (const uint8_t *)"off", .len = 3};
+  if (u8_slice_equals(str, off_str))
+    return VELVET_API_MOUSE_PROTOCOL_OFF;
+
+  struct u8_slice sgr_str = {.content = (const uint8_t *)"sgr", .len = 3};
+  if (u8_slice_equals(str, sgr_str))
+    return VELVET_API_MOUSE_PROTOCOL_SGR;
+
+  struct u8_slice utf8_str = {.content = (const uint8_t *)"utf8", .len = 4};
+  if (u8_slice_equals(str, utf8_str))
+    return VELVET_API_MOUSE_PROTOCOL_UTF8;
+
+  struct u8_slice urxvt_str = {.content = (const uint8_t *)"urxvt", .len = 5};
+  if (u8_slice_equals(str, urxvt_str))
+    return VELVET_API_MOUSE_PROTOCOL_URXVT;
+
+  struct u8_slice sgr_pixel_str = {.content = (const uint8_t *)"sgr_pixel", .len = 9};
+  if (u8_slice_equals(str, sgr_pixel_str))
+    return VELVET_API_MOUSE_PROTOCOL_SGR_PIXEL;
+
+  return ~0;
+}
+
+__attribute__((unused)) static struct u8_slice mouse_protocol_to_slice(enum velvet_api_mouse_protocol value) {
+  switch (value) {
+  case VELVET_API_MOUSE_PROTOCOL_OFF:
+    return (struct u8_slice){.content = (const uint8_t *)"off", .len = 3};
+  case VELVET_API_MOUSE_PROTOCOL_SGR:
+    return (struct u8_slice){.content = (const uint8_t *)"sgr", .len = 3};
+  case VELVET_API_MOUSE_PROTOCOL_UTF8:
+    return (struct u8_slice){.content = (const uint8_t *)"utf8", .len = 4};
+  case VELVET_API_MOUSE_PROTOCOL_URXVT:
+    return (struct u8_slice){.content = (const uint8_t *)"urxvt", .len = 5};
+  case VELVET_API_MOUSE_PROTOCOL_SGR_PIXEL:
+    return (struct u8_slice){.content = (const uint8_t *)"sgr_pixel", .len = 9};
+  default: assert(!"mouse_protocol value out of range");
+  };
+}
+
+__attribute__((unused)) static int brush_slice_to_enum(struct u8_slice str) {
+  struct u8_slice background_str = {.content = (const uint8_t *)"background", .len = 10};
+  if (u8_slice_equals(str, background_str))
+    return VELVET_API_BRUSH_BACKGROUND;
+
+  struct u8_slice foreground_str = {.content = (const uint8_t *)"foreground", .len = 10};
+  if (u8_slice_equals(str, foreground_str))
+    return VELVET_API_BRUSH_FOREGROUND;
+
+  return ~0;
+}
+
+__attribute__((unused)) static struct u8_slice brush_to_slice(enum velvet_api_brush value) {
+  switch (value) {
+  case VELVET_API_BRUSH_BACKGROUND:
+    return (struct u8_slice){.content = (const uint8_t *)"background", .len = 10};
+  case VELVET_API_BRUSH_FOREGROUND:
+    return (struct u8_slice){.content = (const uint8_t *)"foreground", .len = 10};
+  default: assert(!"brush value out of range");
+  };
+}
+
+__attribute__((unused)) static int transparency_mode_slice_to_enum(struct u8_slice str) {
+  struct u8_slice none_str = {.content = (const uint8_t *)"none", .len = 4};
+  if (u8_slice_equals(str, none_str))
+    return VELVET_API_TRANSPARENCY_MODE_NONE;
+
+  struct u8_slice clear_str = {.content = (const uint8_t *)"clear", .len = 5};
+  if (u8_slice_equals(str, clear_str))
+    return VELVET_API_TRANSPARENCY_MODE_CLEAR;
+
+  struct u8_slice all_str = {.content = (const uint8_t *)"all", .len = 3};
+  if (u8_slice_equals(str, all_str))
+    return VELVET_API_TRANSPARENCY_MODE_ALL;
+
+  return ~0;
+}
+
+__attribute__((unused)) static struct u8_slice transparency_mode_to_slice(enum velvet_api_transparency_mode value) {
+  switch (value) {
+  case VELVET_API_TRANSPARENCY_MODE_NONE:
+    return (struct u8_slice){.content = (const uint8_t *)"none", .len = 4};
+  case VELVET_API_TRANSPARENCY_MODE_CLEAR:
+    return (struct u8_slice){.content = (const uint8_t *)"clear", .len = 5};
+  case VELVET_API_TRANSPARENCY_MODE_ALL:
+    return (struct u8_slice){.content = (const uint8_t *)"all", .len = 3};
+  default: assert(!"transparency_mode value out of range");
+  };
+}
+
+__attribute__((unused)) static int scrollback_mode_slice_to_enum(struct u8_slice str) {
+  struct u8_slice memory_str = {.content = (const uint8_t *)"memory", .len = 6};
+  if (u8_slice_equals(str, memory_str))
+    return VELVET_API_SCROLLBACK_MODE_MEMORY;
+
+  struct u8_slice disk_str = {.content = (const uint8_t *)"disk", .len = 4};
+  if (u8_slice_equals(str, disk_str))
+    return VELVET_API_SCROLLBACK_MODE_DISK;
+
+  return ~0;
+}
+
+__attribute__((unused)) static struct u8_slice scrollback_mode_to_slice(enum velvet_api_scrollback_mode value) {
+  switch (value) {
+  case VELVET_API_SCROLLBACK_MODE_MEMORY:
+    return (struct u8_slice){.content = (const uint8_t *)"memory", .len = 6};
+  case VELVET_API_SCROLLBACK_MODE_DISK:
+    return (struct u8_slice){.content = (const uint8_t *)"disk", .len = 4};
+  default: assert(!"scrollback_mode value out of range");
+  };
+}
+
+__attribute__((unused)) static int key_event_type_slice_to_enum(struct u8_slice str) {
+  struct u8_slice press_str = {.content = (const uint8_t *)"press", .len = 5};
+  if (u8_slice_equals(str, press_str))
+    return VELVET_API_KEY_EVENT_TYPE_PRESS;
+
+  struct u8_slice repeat_str = {.content = (const uint8_t *)"repeat", .len = 6};
+  if (u8_slice_equals(str, repeat_str))
+    return VELVET_API_KEY_EVENT_TYPE_REPEAT;
+
+  struct u8_slice release_str = {.content = (const uint8_t *)"release", .len = 7};
+  if (u8_slice_equals(str, release_str))
+    return VELVET_API_KEY_EVENT_TYPE_RELEASE;
+
+  return ~0;
+}
+
+__attribute__((unused)) static struct u8_slice key_event_type_to_slice(enum velvet_api_key_event_type value) {
+  switch (value) {
+  case VELVET_API_KEY_EVENT_TYPE_PRESS:
+    return (struct u8_slice){.content = (const uint8_t *)"press", .len = 5};
+  case VELVET_API_KEY_EVENT_TYPE_REPEAT:
+    return (struct u8_slice){.content = (const uint8_t *)"repeat", .len = 6};
+  case VELVET_API_KEY_EVENT_TYPE_RELEASE:
+    return (struct u8_slice){.content = (const uint8_t *)"release", .len = 7};
+  default: assert(!"key_event_type value out of range");
+  };
+}
+
+__attribute__((unused)) static int key_modifier_slice_to_enum(struct u8_slice str) {
+  struct u8_slice shift_str = {.content = (const uint8_t *)"shift", .len = 5};
+  if (u8_slice_equals(str, shift_str))
+    return VELVET_API_KEY_MODIFIER_SHIFT;
+
+  struct u8_slice alt_str = {.content = (const uint8_t *)"alt", .len = 3};
+  if (u8_slice_equals(str, alt_str))
+    return VELVET_API_KEY_MODIFIER_ALT;
+
+  struct u8_slice control_str = {.content = (const uint8_t *)"control", .len = 7};
+  if (u8_slice_equals(str, control_str))
+    return VELVET_API_KEY_MODIFIER_CONTROL;
+
+  struct u8_slice super_str = {.content = (const uint8_t *)"super", .len = 5};
+  if (u8_slice_equals(str, super_str))
+    return VELVET_API_KEY_MODIFIER_SUPER;
+
+  struct u8_slice hyper_str = {.content = (const uint8_t *)"hyper", .len = 5};
+  if (u8_slice_equals(str, hyper_str))
+    return VELVET_API_KEY_MODIFIER_HYPER;
+
+  struct u8_slice meta_str = {.content = (const uint8_t *)"meta", .len = 4};
+  if (u8_slice_equals(str, meta_str))
+    return VELVET_API_KEY_MODIFIER_META;
+
+  struct u8_slice caps_lock_str = {.content = (const uint8_t *)"caps_lock", .len = 9};
+  if (u8_slice_equals(str, caps_lock_str))
+    return VELVET_API_KEY_MODIFIER_CAPS_LOCK;
+
+  struct u8_slice num_lock_str = {.content = (const uint8_t *)"num_lock", .len = 8};
+  if (u8_slice_equals(str, num_lock_str))
+    return VELVET_API_KEY_MODIFIER_NUM_LOCK;
+
+  return ~0;
+}
+
+__attribute__((unused)) static struct u8_slice key_modifier_to_slice(enum velvet_api_key_modifier value) {
+  switch (value) {
+  case VELVET_API_KEY_MODIFIER_SHIFT:
+    return (struct u8_slice){.content = (const uint8_t *)"shift", .len = 5};
+  case VELVET_API_KEY_MODIFIER_ALT:
+    return (struct u8_slice){.content = (const uint8_t *)"alt", .len = 3};
+  case VELVET_API_KEY_MODIFIER_CONTROL:
+    return (struct u8_slice){.content = (const uint8_t *)"control", .len = 7};
+  case VELVET_API_KEY_MODIFIER_SUPER:
+    return (struct u8_slice){.content = (const uint8_t *)"super", .len = 5};
+  case VELVET_API_KEY_MODIFIER_HYPER:
+    return (struct u8_slice){.content = (const uint8_t *)"hyper", .len = 5};
+  case VELVET_API_KEY_MODIFIER_META:
+    return (struct u8_slice){.content = (const uint8_t *)"meta", .len = 4};
+  case VELVET_API_KEY_MODIFIER_CAPS_LOCK:
+    return (struct u8_slice){.content = (const uint8_t *)"caps_lock", .len = 9};
+  case VELVET_API_KEY_MODIFIER_NUM_LOCK:
+    return (struct u8_slice){.content = (const uint8_t *)"num_lock", .len = 8};
+  default: assert(!"key_modifier value out of range");
+  };
+}
+
+__attribute__((unused)) static int scroll_direction_slice_to_enum(struct u8_slice str) {
+  struct u8_slice up_str = {.content = (const uint8_t *)"up", .len = 2};
+  if (u8_slice_equals(str, up_str))
+    return VELVET_API_SCROLL_DIRECTION_UP;
+
+  struct u8_slice down_str = {.content = (const uint8_t *)"down", .len = 4};
+  if (u8_slice_equals(str, down_str))
+    return VELVET_API_SCROLL_DIRECTION_DOWN;
+
+  struct u8_slice left_str = {.content = (const uint8_t *)"left", .len = 4};
+  if (u8_slice_equals(str, left_str))
+    return VELVET_API_SCROLL_DIRECTION_LEFT;
+
+  struct u8_slice right_str = {.content = (const uint8_t *)"right", .len = 5};
+  if (u8_slice_equals(str, right_str))
+    return VELVET_API_SCROLL_DIRECTION_RIGHT;
+
+  return ~0;
+}
+
+__attribute__((unused)) static struct u8_slice scroll_direction_to_slice(enum velvet_api_scroll_direction value) {
+  switch (value) {
+  case VELVET_API_SCROLL_DIRECTION_UP:
+    return (struct u8_slice){.content = (const uint8_t *)"up", .len = 2};
+  case VELVET_API_SCROLL_DIRECTION_DOWN:
+    return (struct u8_slice){.content = (const uint8_t *)"down", .len = 4};
+  case VELVET_API_SCROLL_DIRECTION_LEFT:
+    return (struct u8_slice){.content = (const uint8_t *)"left", .len = 4};
+  case VELVET_API_SCROLL_DIRECTION_RIGHT:
+    return (struct u8_slice){.content = (const uint8_t *)"right", .len = 5};
+  default: assert(!"scroll_direction value out of range");
+  };
+}
+
+__attribute__((unused)) static int mouse_button_slice_to_enum(struct u8_slice str) {
+  struct u8_slice left_str = {.content = (const uint8_t *)"left", .len = 4};
+  if (u8_slice_equals(str, left_str))
+    return VELVET_API_MOUSE_BUTTON_LEFT;
+
+  struct u8_slice middle_str = {.content = (const uint8_t *)"middle", .len = 6};
+  if (u8_slice_equals(str, middle_str))
+    return VELVET_API_MOUSE_BUTTON_MIDDLE;
+
+  struct u8_slice right_str = {.content = (const uint8_t *)"right", .len = 5};
+  if (u8_slice_equals(str, right_str))
+    return VELVET_API_MOUSE_BUTTON_RIGHT;
+
+  struct u8_slice none_str = {.content = (const uint8_t *)"none", .len = 4};
+  if (u8_slice_equals(str, none_str))
+    return VELVET_API_MOUSE_BUTTON_NONE;
+
+  return ~0;
+}
+
+__attribute__((unused)) static struct u8_slice mouse_button_to_slice(enum velvet_api_mouse_button value) {
+  switch (value) {
+  case VELVET_API_MOUSE_BUTTON_LEFT:
+    return (struct u8_slice){.content = (const uint8_t *)"left", .len = 4};
+  case VELVET_API_MOUSE_BUTTON_MIDDLE:
+    return (struct u8_slice){.content = (const uint8_t *)"middle", .len = 6};
+  case VELVET_API_MOUSE_BUTTON_RIGHT:
+    return (struct u8_slice){.content = (const uint8_t *)"right", .len = 5};
+  case VELVET_API_MOUSE_BUTTON_NONE:
+    return (struct u8_slice){.content = (const uint8_t *)"none", .len = 4};
+  default: assert(!"mouse_button value out of range");
+  };
+}
+
+__attribute__((unused)) static int mouse_event_type_slice_to_enum(struct u8_slice str) {
+  struct u8_slice mouse_down_str = {.content = (const uint8_t *)"mouse_down", .len = 10};
+  if (u8_slice_equals(str, mouse_down_str))
+    return VELVET_API_MOUSE_EVENT_TYPE_MOUSE_DOWN;
+
+  struct u8_slice mouse_up_str = {.content = (const uint8_t *)"mouse_up", .len = 8};
+  if (u8_slice_equals(str, mouse_up_str))
+    return VELVET_API_MOUSE_EVENT_TYPE_MOUSE_UP;
+
+  return ~0;
+}
+
+__attribute__((unused)) static struct u8_slice mouse_event_type_to_slice(enum velvet_api_mouse_event_type value) {
+  switch (value) {
+  case VELVET_API_MOUSE_EVENT_TYPE_MOUSE_DOWN:
+    return (struct u8_slice){.content = (const uint8_t *)"mouse_down", .len = 10};
+  case VELVET_API_MOUSE_EVENT_TYPE_MOUSE_UP:
+    return (struct u8_slice){.content = (const uint8_t *)"mouse_up", .len = 8};
+  default: assert(!"mouse_event_type value out of range");
+  };
+}
+
+__attribute__((unused)) static int color_kind_slice_to_enum(struct u8_slice str) {
+  struct u8_slice reset_str = {.content = (const uint8_t *)"reset", .len = 5};
+  if (u8_slice_equals(str, reset_str))
+    return VELVET_API_COLOR_KIND_RESET;
+
+  struct u8_slice rgb_str = {.content = (const uint8_t *)"rgb", .len = 3};
+  if (u8_slice_equals(str, rgb_str))
+    return VELVET_API_COLOR_KIND_RGB;
+
+  struct u8_slice table_str = {.content = (const uint8_t *)"table", .len = 5};
+  if (u8_slice_equals(str, table_str))
+    return VELVET_API_COLOR_KIND_TABLE;
+
+  return ~0;
+}
+
+__attribute__((unused)) static struct u8_slice color_kind_to_slice(enum velvet_api_color_kind value) {
+  switch (value) {
+  case VELVET_API_COLOR_KIND_RESET:
+    return (struct u8_slice){.content = (const uint8_t *)"reset", .len = 5};
+  case VELVET_API_COLOR_KIND_RGB:
+    return (struct u8_slice){.content = (const uint8_t *)"rgb", .len = 3};
+  case VELVET_API_COLOR_KIND_TABLE:
+    return (struct u8_slice){.content = (const uint8_t *)"table", .len = 5};
+  default: assert(!"color_kind value out of range");
+  };
+}
+
+__attribute__((unused)) static int unix_signal_slice_to_enum(struct u8_slice str) {
+  struct u8_slice hup_str = {.content = (const uint8_t *)"hup", .len = 3};
+  if (u8_slice_equals(str, hup_str))
+    return VELVET_API_UNIX_SIGNAL_HUP;
+
+  struct u8_slice int_str = {.content = (const uint8_t *)"int", .len = 3};
+  if (u8_slice_equals(str, int_str))
+    return VELVET_API_UNIX_SIGNAL_INT;
+
+  struct u8_slice quit_str = {.content = (const uint8_t *)"quit", .len = 4};
+  if (u8_slice_equals(str, quit_str))
+    return VELVET_API_UNIX_SIGNAL_QUIT;
+
+  struct u8_slice kill_str = {.content = (const uint8_t *)"kill", .len = 4};
+  if (u8_slice_equals(str, kill_str))
+    return VELVET_API_UNIX_SIGNAL_KILL;
+
+  struct u8_slice usr1_str = {.content = (const uint8_t *)"usr1", .len = 4};
+  if (u8_slice_equals(str, usr1_str))
+    return VELVET_API_UNIX_SIGNAL_USR1;
+
+  struct u8_slice usr2_str = {.content = (const uint8_t *)"usr2", .len = 4};
+  if (u8_slice_equals(str, usr2_str))
+    return VELVET_API_UNIX_SIGNAL_USR2;
+
+  struct u8_slice alrm_str = {.content = (const uint8_t *)"alrm", .len = 4};
+  if (u8_slice_equals(str, alrm_str))
+    return VELVET_API_UNIX_SIGNAL_ALRM;
+
+  struct u8_slice term_str = {.content = (const uint8_t *)"term", .len = 4};
+  if (u8_slice_equals(str, term_str))
+    return VELVET_API_UNIX_SIGNAL_TERM;
+
+  struct u8_slice stop_str = {.content = (const uint8_t *)"stop", .len = 4};
+  if (u8_slice_equals(str, stop_str))
+    return VELVET_API_UNIX_SIGNAL_STOP;
+
+  struct u8_slice cont_str = {.content = (const uint8_t *)"cont", .len = 4};
+  if (u8_slice_equals(str, cont_str))
+    return VELVET_API_UNIX_SIGNAL_CONT;
+
+  return ~0;
+}
+
+__attribute__((unused)) static struct u8_slice unix_signal_to_slice(enum velvet_api_unix_signal value) {
+  switch (value) {
+  case VELVET_API_UNIX_SIGNAL_HUP:
+    return (struct u8_slice){.content = (const uint8_t *)"hup", .len = 3};
+  case VELVET_API_UNIX_SIGNAL_INT:
+    return (struct u8_slice){.content = (const uint8_t *)"int", .len = 3};
+  case VELVET_API_UNIX_SIGNAL_QUIT:
+    return (struct u8_slice){.content = (const uint8_t *)"quit", .len = 4};
+  case VELVET_API_UNIX_SIGNAL_KILL:
+    return (struct u8_slice){.content = (const uint8_t *)"kill", .len = 4};
+  case VELVET_API_UNIX_SIGNAL_USR1:
+    return (struct u8_slice){.content = (const uint8_t *)"usr1", .len = 4};
+  case VELVET_API_UNIX_SIGNAL_USR2:
+    return (struct u8_slice){.content = (const uint8_t *)"usr2", .len = 4};
+  case VELVET_API_UNIX_SIGNAL_ALRM:
+    return (struct u8_slice){.content = (const uint8_t *)"alrm", .len = 4};
+  case VELVET_API_UNIX_SIGNAL_TERM:
+    return (struct u8_slice){.content = (const uint8_t *)"term", .len = 4};
+  case VELVET_API_UNIX_SIGNAL_STOP:
+    return (struct u8_slice){.content = (const uint8_t *)"stop", .len = 4};
+  case VELVET_API_UNIX_SIGNAL_CONT:
+    return (struct u8_slice){.content = (const uint8_t *)"cont", .len = 4};
+  default: assert(!"unix_signal value out of range");
+  };
+}
\ No newline at end of file
@@ -0,0 +1,2709 @@
+/***************************************************
+************ DO NOT EDIT THIS BY HAND **************
+*** This file was auto generated by generate.lua ****
+***************************************************/
+
+#include "lua.h"
+#include "lauxlib.h"
+#include "velvet_api.h"
+#include "velvet_lua.h"
+#include "velvet.h"
+#include "velvet_enum_converters.c"
+
+static int l_vv_api_get_screen_geometry(lua_State *L) {
+  lua_Integer argtop = 0;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  struct velvet_api_screen_geometry ret = vv_api_get_screen_geometry(v);
+  lua_newtable(L); /* ret = new screen.geometry */
+  lua_pushinteger(L, ret.width);
+  lua_setfield(L, -2, "width"); /* ret.width = width */
+  lua_pushinteger(L, ret.height);
+  lua_setfield(L, -2, "height"); /* ret.height = height */
+  return 1;
+}
+
+static int l_vv_api_schedule_cancel(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int cancellation_id = luaL_checkinteger(L, 1); /* poggies */
+  bool ret = vv_api_schedule_cancel(v, cancellation_id);
+  lua_pushboolean(L, ret);
+  return 1;
+}
+
+static int l_vv_api_schedule_after(lua_State *L) {
+  lua_Integer argtop = 2;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int delay = luaL_checkinteger(L, 1); /* poggies */
+  lua_Integer func = luaL_checkfunction(L, 2); /* poggies */
+  int ret = vv_api_schedule_after(v, delay, func);
+  lua_pushinteger(L, ret);
+  return 1;
+}
+
+static int l_vv_api_get_current_tick(lua_State *L) {
+  lua_Integer argtop = 0;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int ret = vv_api_get_current_tick(v);
+  lua_pushinteger(L, ret);
+  return 1;
+}
+
+static int l_vv_api_get_clients(lua_State *L) {
+  lua_Integer argtop = 0;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  return vv_api_get_clients(v);
+}
+
+static int l_vv_api_set_active_client(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int client_id = luaL_checkinteger(L, 1); /* poggies */
+  vv_api_set_active_client(v, client_id);
+  return 0;
+}
+
+static int l_vv_api_get_active_client(lua_State *L) {
+  lua_Integer argtop = 0;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int ret = vv_api_get_active_client(v);
+  lua_pushinteger(L, ret);
+  return 1;
+}
+
+static int l_vv_api_client_detach(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int id = luaL_checkinteger(L, 1); /* poggies */
+  vv_api_client_detach(v, id);
+  return 0;
+}
+
+static int l_vv_api_client_reattach(lua_State *L) {
+  lua_Integer argtop = 2;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int id = luaL_checkinteger(L, 1); /* poggies */
+  struct u8_slice server = luaL_checkslice(L, 2); /* poggies */
+  vv_api_client_reattach(v, id, server);
+  return 0;
+}
+
+static int l_vv_api_client_set_options(lua_State *L) {
+  lua_Integer argtop = 2;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int client_id = luaL_checkinteger(L, 1); /* poggies */
+  luaL_checktype(L, 2, LUA_TTABLE);
+  struct velvet_api_client_options options = {0};
+  if (!lua_isnoneornil(L, 2)) {
+    luaL_checktype(L, 2, LUA_TTABLE);
+    lua_pushvalue(L, 2); /* push table to the top of the stack */
+
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "x_pixel"); /* get options.x_pixel */
+    options.x_pixel = luaL_checkinteger(L, -1);
+    lua_pop(L, 1); /* pop options.x_pixel */
+    lua_getfield(L, -1, "y_pixel"); /* get options.y_pixel */
+    options.y_pixel = luaL_checkinteger(L, -1);
+    lua_pop(L, 1); /* pop options.y_pixel */
+    lua_getfield(L, -1, "lines"); /* get options.lines */
+    options.lines = luaL_checkinteger(L, -1);
+    lua_pop(L, 1); /* pop options.lines */
+    lua_getfield(L, -1, "columns"); /* get options.columns */
+    options.columns = luaL_checkinteger(L, -1);
+    lua_pop(L, 1); /* pop options.columns */
+    lua_pop(L, 1); /* pop pushed table */
+  }
+  vv_api_client_set_options(v, client_id, options);
+  return 0;
+}
+
+static int l_vv_api_quit(lua_State *L) {
+  lua_Integer argtop = 0;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  vv_api_quit(v);
+  return 0;
+}
+
+static int l_vv_api_reload(lua_State *L) {
+  lua_Integer argtop = 0;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  vv_api_reload(v);
+  return 0;
+}
+
+static int l_vv_api_get_startup_directory(lua_State *L) {
+  lua_Integer argtop = 0;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  struct u8_slice ret = vv_api_get_startup_directory(v);
+  lua_pushslice(L, ret);
+  return 1;
+}
+
+static int l_vv_api_get_mouse_position(lua_State *L) {
+  lua_Integer argtop = 0;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  struct velvet_api_coordinate ret = vv_api_get_mouse_position(v);
+  lua_newtable(L); /* ret = new coordinate */
+  lua_pushinteger(L, ret.row);
+  lua_setfield(L, -2, "row"); /* ret.row = row */
+  lua_pushinteger(L, ret.col);
+  lua_setfield(L, -2, "col"); /* ret.col = col */
+  return 1;
+}
+
+static int l_vv_api_get_memory_usage(lua_State *L) {
+  lua_Integer argtop = 0;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  struct velvet_api_memory_usage ret = vv_api_get_memory_usage(v);
+  lua_newtable(L); /* ret = new memory_usage */
+  lua_pushinteger(L, ret.cells);
+  lua_setfield(L, -2, "cells"); /* ret.cells = cells */
+  lua_pushinteger(L, ret.lines);
+  lua_setfield(L, -2, "lines"); /* ret.lines = lines */
+  lua_pushinteger(L, ret.styles);
+  lua_setfield(L, -2, "styles"); /* ret.styles = styles */
+  lua_pushinteger(L, ret.hyperlinks);
+  lua_setfield(L, -2, "hyperlinks"); /* ret.hyperlinks = hyperlinks */
+  lua_pushinteger(L, ret.scrollback);
+  lua_setfield(L, -2, "scrollback"); /* ret.scrollback = scrollback */
+  lua_pushinteger(L, ret.total);
+  lua_setfield(L, -2, "total"); /* ret.total = total */
+  return 1;
+}
+
+static int l_vv_api_get_windows(lua_State *L) {
+  lua_Integer argtop = 0;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  return vv_api_get_windows(v);
+}
+
+static int l_vv_api_window_set_z_index(lua_State *L) {
+  lua_Integer argtop = 2;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  int z = luaL_checkinteger(L, 2); /* poggies */
+  vv_api_window_set_z_index(v, win_id, z);
+  return 0;
+}
+
+static int l_vv_api_window_get_z_index(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  int ret = vv_api_window_get_z_index(v, win_id);
+  lua_pushinteger(L, ret);
+  return 1;
+}
+
+static int l_vv_api_window_set_hidden(lua_State *L) {
+  lua_Integer argtop = 2;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  bool hidden = luaL_checkboolean(L, 2); /* poggies */
+  vv_api_window_set_hidden(v, win_id, hidden);
+  return 0;
+}
+
+static int l_vv_api_window_get_hidden(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  bool ret = vv_api_window_get_hidden(v, win_id);
+  lua_pushboolean(L, ret);
+  return 1;
+}
+
+static int l_vv_api_window_get_alpha(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  float ret = vv_api_window_get_alpha(v, win_id);
+  lua_pushnumber(L, ret);
+  return 1;
+}
+
+static int l_vv_api_window_get_text(lua_State *L) {
+  lua_Integer argtop = 2;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  luaL_checktype(L, 2, LUA_TTABLE);
+  struct velvet_api_rect region = {0};
+  if (!lua_isnoneornil(L, 2)) {
+    luaL_checktype(L, 2, LUA_TTABLE);
+    lua_pushvalue(L, 2); /* push table to the top of the stack */
+
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "left"); /* get region.left */
+    region.left = luaL_checkinteger(L, -1);
+    lua_pop(L, 1); /* pop region.left */
+    lua_getfield(L, -1, "top"); /* get region.top */
+    region.top = luaL_checkinteger(L, -1);
+    lua_pop(L, 1); /* pop region.top */
+    lua_getfield(L, -1, "width"); /* get region.width */
+    region.width = luaL_checkinteger(L, -1);
+    lua_pop(L, 1); /* pop region.width */
+    lua_getfield(L, -1, "height"); /* get region.height */
+    region.height = luaL_checkinteger(L, -1);
+    lua_pop(L, 1); /* pop region.height */
+    lua_pop(L, 1); /* pop pushed table */
+  }
+  return vv_api_window_get_text(v, win_id, region);
+}
+
+static int l_vv_api_window_get_cells(lua_State *L) {
+  lua_Integer argtop = 2;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  luaL_checktype(L, 2, LUA_TTABLE);
+  struct velvet_api_rect region = {0};
+  if (!lua_isnoneornil(L, 2)) {
+    luaL_checktype(L, 2, LUA_TTABLE);
+    lua_pushvalue(L, 2); /* push table to the top of the stack */
+
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "left"); /* get region.left */
+    region.left = luaL_checkinteger(L, -1);
+    lua_pop(L, 1); /* pop region.left */
+    lua_getfield(L, -1, "top"); /* get region.top */
+    region.top = luaL_checkinteger(L, -1);
+    lua_pop(L, 1); /* pop region.top */
+    lua_getfield(L, -1, "width"); /* get region.width */
+    region.width = luaL_checkinteger(L, -1);
+    lua_pop(L, 1); /* pop region.width */
+    lua_getfield(L, -1, "height"); /* get region.height */
+    region.height = luaL_checkinteger(L, -1);
+    lua_pop(L, 1); /* pop region.height */
+    lua_pop(L, 1); /* pop pushed table */
+  }
+  return vv_api_window_get_cells(v, win_id, region);
+}
+
+static int l_vv_api_window_get_mouse_settings(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  struct velvet_api_mouse_settings ret = vv_api_window_get_mouse_settings(v, win_id);
+  lua_newtable(L); /* ret = new mouse_settings */
+  lua_pushslice(L, mouse_reporting_to_slice(ret.reporting));
+  lua_setfield(L, -2, "reporting"); /* ret.reporting = reporting */
+  lua_pushslice(L, mouse_protocol_to_slice(ret.protocol));
+  lua_setfield(L, -2, "protocol"); /* ret.protocol = protocol */
+  return 1;
+}
+
+static int l_vv_api_window_set_alpha(lua_State *L) {
+  lua_Integer argtop = 2;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  float alpha = luaL_checknumber(L, 2); /* poggies */
+  vv_api_window_set_alpha(v, win_id, alpha);
+  return 0;
+}
+
+static int l_vv_api_window_get_transparency_mode(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  enum velvet_api_transparency_mode ret = vv_api_window_get_transparency_mode(v, win_id);
+  lua_pushslice(L, transparency_mode_to_slice(ret));
+  return 1;
+}
+
+static int l_vv_api_window_set_transparency_mode(lua_State *L) {
+  lua_Integer argtop = 2;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  struct u8_slice mode_str = luaL_checkslice(L, 2);
+  enum velvet_api_transparency_mode mode = transparency_mode_slice_to_enum(mode_str);
+  vv_api_window_set_transparency_mode(v, win_id, mode);
+  return 0;
+}
+
+static int l_vv_api_window_get_dim_factor(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  float ret = vv_api_window_get_dim_factor(v, win_id);
+  lua_pushnumber(L, ret);
+  return 1;
+}
+
+static int l_vv_api_window_set_dim_factor(lua_State *L) {
+  lua_Integer argtop = 2;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  float factor = luaL_checknumber(L, 2); /* poggies */
+  vv_api_window_set_dim_factor(v, win_id, factor);
+  return 0;
+}
+
+static int l_vv_api_get_focused_window(lua_State *L) {
+  lua_Integer argtop = 0;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  struct optional_int ret = vv_api_get_focused_window(v);
+  if (!ret.set) {
+    return 0;
+  }
+  lua_pushinteger(L, ret.value);
+  return 1;
+}
+
+static int l_vv_api_set_focused_window(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  vv_api_set_focused_window(v, win_id);
+  return 0;
+}
+
+static int l_vv_api_window_get_geometry(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  struct velvet_api_rect ret = vv_api_window_get_geometry(v, win_id);
+  lua_newtable(L); /* ret = new rect */
+  lua_pushinteger(L, ret.left);
+  lua_setfield(L, -2, "left"); /* ret.left = left */
+  lua_pushinteger(L, ret.top);
+  lua_setfield(L, -2, "top"); /* ret.top = top */
+  lua_pushinteger(L, ret.width);
+  lua_setfield(L, -2, "width"); /* ret.width = width */
+  lua_pushinteger(L, ret.height);
+  lua_setfield(L, -2, "height"); /* ret.height = height */
+  return 1;
+}
+
+static int l_vv_api_window_set_geometry(lua_State *L) {
+  lua_Integer argtop = 2;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  luaL_checktype(L, 2, LUA_TTABLE);
+  struct velvet_api_rect geometry = {0};
+  if (!lua_isnoneornil(L, 2)) {
+    luaL_checktype(L, 2, LUA_TTABLE);
+    lua_pushvalue(L, 2); /* push table to the top of the stack */
+
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "left"); /* get geometry.left */
+    geometry.left = luaL_checkinteger(L, -1);
+    lua_pop(L, 1); /* pop geometry.left */
+    lua_getfield(L, -1, "top"); /* get geometry.top */
+    geometry.top = luaL_checkinteger(L, -1);
+    lua_pop(L, 1); /* pop geometry.top */
+    lua_getfield(L, -1, "width"); /* get geometry.width */
+    geometry.width = luaL_checkinteger(L, -1);
+    lua_pop(L, 1); /* pop geometry.width */
+    lua_getfield(L, -1, "height"); /* get geometry.height */
+    geometry.height = luaL_checkinteger(L, -1);
+    lua_pop(L, 1); /* pop geometry.height */
+    lua_pop(L, 1); /* pop pushed table */
+  }
+  vv_api_window_set_geometry(v, win_id, geometry);
+  return 0;
+}
+
+static int l_vv_api_window_close(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  vv_api_window_close(v, win_id);
+  return 0;
+}
+
+static int l_vv_api_window_get_title(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  struct u8_slice ret = vv_api_window_get_title(v, win_id);
+  lua_pushslice(L, ret);
+  return 1;
+}
+
+static int l_vv_api_window_set_title(lua_State *L) {
+  lua_Integer argtop = 2;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  struct u8_slice title = luaL_checkslice(L, 2); /* poggies */
+  vv_api_window_set_title(v, win_id, title);
+  return 0;
+}
+
+static int l_vv_api_window_send_raw_key(lua_State *L) {
+  lua_Integer argtop = 2;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  luaL_checktype(L, 2, LUA_TTABLE);
+  struct velvet_api_window_key_event key = {0};
+  if (!lua_isnoneornil(L, 2)) {
+    luaL_checktype(L, 2, LUA_TTABLE);
+    lua_pushvalue(L, 2); /* push table to the top of the stack */
+
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "codepoint"); /* get key.codepoint */
+    key.codepoint = luaL_checkinteger(L, -1);
+    lua_pop(L, 1); /* pop key.codepoint */
+    lua_getfield(L, -1, "alternate_codepoint"); /* get key.alternate_codepoint */
+    key.alternate_codepoint = luaL_checkinteger(L, -1);
+    lua_pop(L, 1); /* pop key.alternate_codepoint */
+    lua_getfield(L, -1, "name"); /* get key.name */
+    key.name = luaL_checkslice(L, -1);
+    lua_pop(L, 1); /* pop key.name */
+    lua_getfield(L, -1, "event_type"); /* get key.event_type */
+    struct u8_slice key_event_type_str = luaL_checkslice(L, -1);
+    int key_event_type_conv = key_event_type_slice_to_enum(key_event_type_str);
+    if (key_event_type_conv == ~0) {
+      lua_pushstring(L, " is not a valid key_event_type value.");
+      lua_concat(L, 2);
+      lua_error(L);
+    }
+    key.event_type = key_event_type_conv;
+    lua_pop(L, 1); /* pop key.event_type */
+    lua_getfield(L, -1, "modifiers"); /* get key.modifiers */
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "shift");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      key.modifiers |= VELVET_API_KEY_MODIFIER_SHIFT;
+    lua_pop(L, 1);
+
+    lua_getfield(L, -1, "alt");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      key.modifiers |= VELVET_API_KEY_MODIFIER_ALT;
+    lua_pop(L, 1);
+
+    lua_getfield(L, -1, "control");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      key.modifiers |= VELVET_API_KEY_MODIFIER_CONTROL;
+    lua_pop(L, 1);
+
+    lua_getfield(L, -1, "super");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      key.modifiers |= VELVET_API_KEY_MODIFIER_SUPER;
+    lua_pop(L, 1);
+
+    lua_getfield(L, -1, "hyper");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      key.modifiers |= VELVET_API_KEY_MODIFIER_HYPER;
+    lua_pop(L, 1);
+
+    lua_getfield(L, -1, "meta");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      key.modifiers |= VELVET_API_KEY_MODIFIER_META;
+    lua_pop(L, 1);
+
+    lua_getfield(L, -1, "caps_lock");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      key.modifiers |= VELVET_API_KEY_MODIFIER_CAPS_LOCK;
+    lua_pop(L, 1);
+
+    lua_getfield(L, -1, "num_lock");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      key.modifiers |= VELVET_API_KEY_MODIFIER_NUM_LOCK;
+    lua_pop(L, 1);
+
+    lua_pop(L, 1); /* pop key.modifiers */
+    lua_pop(L, 1); /* pop pushed table */
+  }
+  vv_api_window_send_raw_key(v, win_id, key);
+  return 0;
+}
+
+static int l_vv_api_window_send_keys(lua_State *L) {
+  lua_Integer argtop = 2;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  struct u8_slice keys = luaL_checkslice(L, 2); /* poggies */
+  vv_api_window_send_keys(v, win_id, keys);
+  return 0;
+}
+
+static int l_vv_api_window_paste_text(lua_State *L) {
+  lua_Integer argtop = 2;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  struct u8_slice text = luaL_checkslice(L, 2); /* poggies */
+  vv_api_window_paste_text(v, win_id, text);
+  return 0;
+}
+
+static int l_vv_api_window_send_mouse_move(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  luaL_checktype(L, 1, LUA_TTABLE);
+  struct velvet_api_mouse_move_event_args mouse_move = {0};
+  if (!lua_isnoneornil(L, 1)) {
+    luaL_checktype(L, 1, LUA_TTABLE);
+    lua_pushvalue(L, 1); /* push table to the top of the stack */
+
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "win_id"); /* get mouse_move.win_id */
+    mouse_move.win_id = luaL_checkinteger(L, -1);
+    lua_pop(L, 1); /* pop mouse_move.win_id */
+    lua_getfield(L, -1, "pos"); /* get mouse_move.pos */
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "row"); /* get mouse_move.pos.row */
+    mouse_move.pos.row = luaL_checkinteger(L, -1);
+    lua_pop(L, 1); /* pop mouse_move.pos.row */
+    lua_getfield(L, -1, "col"); /* get mouse_move.pos.col */
+    mouse_move.pos.col = luaL_checkinteger(L, -1);
+    lua_pop(L, 1); /* pop mouse_move.pos.col */
+    lua_pop(L, 1); /* pop mouse_move.pos */
+    lua_getfield(L, -1, "mouse_button"); /* get mouse_move.mouse_button */
+    struct u8_slice mouse_move_mouse_button_str = luaL_checkslice(L, -1);
+    int mouse_button_conv = mouse_button_slice_to_enum(mouse_move_mouse_button_str);
+    if (mouse_button_conv == ~0) {
+      lua_pushstring(L, " is not a valid mouse_button value.");
+      lua_concat(L, 2);
+      lua_error(L);
+    }
+    mouse_move.mouse_button = mouse_button_conv;
+    lua_pop(L, 1); /* pop mouse_move.mouse_button */
+    lua_getfield(L, -1, "modifiers"); /* get mouse_move.modifiers */
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "shift");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      mouse_move.modifiers |= VELVET_API_KEY_MODIFIER_SHIFT;
+    lua_pop(L, 1);
+
+    lua_getfield(L, -1, "alt");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      mouse_move.modifiers |= VELVET_API_KEY_MODIFIER_ALT;
+    lua_pop(L, 1);
+
+    lua_getfield(L, -1, "control");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      mouse_move.modifiers |= VELVET_API_KEY_MODIFIER_CONTROL;
+    lua_pop(L, 1);
+
+    lua_getfield(L, -1, "super");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      mouse_move.modifiers |= VELVET_API_KEY_MODIFIER_SUPER;
+    lua_pop(L, 1);
+
+    lua_getfield(L, -1, "hyper");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      mouse_move.modifiers |= VELVET_API_KEY_MODIFIER_HYPER;
+    lua_pop(L, 1);
+
+    lua_getfield(L, -1, "meta");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      mouse_move.modifiers |= VELVET_API_KEY_MODIFIER_META;
+    lua_pop(L, 1);
+
+    lua_getfield(L, -1, "caps_lock");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      mouse_move.modifiers |= VELVET_API_KEY_MODIFIER_CAPS_LOCK;
+    lua_pop(L, 1);
+
+    lua_getfield(L, -1, "num_lock");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      mouse_move.modifiers |= VELVET_API_KEY_MODIFIER_NUM_LOCK;
+    lua_pop(L, 1);
+
+    lua_pop(L, 1); /* pop mouse_move.modifiers */
+    lua_pop(L, 1); /* pop pushed table */
+  }
+  vv_api_window_send_mouse_move(v, mouse_move);
+  return 0;
+}
+
+static int l_vv_api_window_send_mouse_click(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  luaL_checktype(L, 1, LUA_TTABLE);
+  struct velvet_api_mouse_click_event_args mouse_click = {0};
+  if (!lua_isnoneornil(L, 1)) {
+    luaL_checktype(L, 1, LUA_TTABLE);
+    lua_pushvalue(L, 1); /* push table to the top of the stack */
+
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "win_id"); /* get mouse_click.win_id */
+    mouse_click.win_id = luaL_checkinteger(L, -1);
+    lua_pop(L, 1); /* pop mouse_click.win_id */
+    lua_getfield(L, -1, "pos"); /* get mouse_click.pos */
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "row"); /* get mouse_click.pos.row */
+    mouse_click.pos.row = luaL_checkinteger(L, -1);
+    lua_pop(L, 1); /* pop mouse_click.pos.row */
+    lua_getfield(L, -1, "col"); /* get mouse_click.pos.col */
+    mouse_click.pos.col = luaL_checkinteger(L, -1);
+    lua_pop(L, 1); /* pop mouse_click.pos.col */
+    lua_pop(L, 1); /* pop mouse_click.pos */
+    lua_getfield(L, -1, "mouse_button"); /* get mouse_click.mouse_button */
+    struct u8_slice mouse_click_mouse_button_str = luaL_checkslice(L, -1);
+    int mouse_button_conv = mouse_button_slice_to_enum(mouse_click_mouse_button_str);
+    if (mouse_button_conv == ~0) {
+      lua_pushstring(L, " is not a valid mouse_button value.");
+      lua_concat(L, 2);
+      lua_error(L);
+    }
+    mouse_click.mouse_button = mouse_button_conv;
+    lua_pop(L, 1); /* pop mouse_click.mouse_button */
+    lua_getfield(L, -1, "event_type"); /* get mouse_click.event_type */
+    struct u8_slice mouse_click_event_type_str = luaL_checkslice(L, -1);
+    int mouse_event_type_conv = mouse_event_type_slice_to_enum(mouse_click_event_type_str);
+    if (mouse_event_type_conv == ~0) {
+      lua_pushstring(L, " is not a valid mouse_event_type value.");
+      lua_concat(L, 2);
+      lua_error(L);
+    }
+    mouse_click.event_type = mouse_event_type_conv;
+    lua_pop(L, 1); /* pop mouse_click.event_type */
+    lua_getfield(L, -1, "modifiers"); /* get mouse_click.modifiers */
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "shift");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      mouse_click.modifiers |= VELVET_API_KEY_MODIFIER_SHIFT;
+    lua_pop(L, 1);
+
+    lua_getfield(L, -1, "alt");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      mouse_click.modifiers |= VELVET_API_KEY_MODIFIER_ALT;
+    lua_pop(L, 1);
+
+    lua_getfield(L, -1, "control");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      mouse_click.modifiers |= VELVET_API_KEY_MODIFIER_CONTROL;
+    lua_pop(L, 1);
+
+    lua_getfield(L, -1, "super");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      mouse_click.modifiers |= VELVET_API_KEY_MODIFIER_SUPER;
+    lua_pop(L, 1);
+
+    lua_getfield(L, -1, "hyper");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      mouse_click.modifiers |= VELVET_API_KEY_MODIFIER_HYPER;
+    lua_pop(L, 1);
+
+    lua_getfield(L, -1, "meta");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      mouse_click.modifiers |= VELVET_API_KEY_MODIFIER_META;
+    lua_pop(L, 1);
+
+    lua_getfield(L, -1, "caps_lock");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      mouse_click.modifiers |= VELVET_API_KEY_MODIFIER_CAPS_LOCK;
+    lua_pop(L, 1);
+
+    lua_getfield(L, -1, "num_lock");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      mouse_click.modifiers |= VELVET_API_KEY_MODIFIER_NUM_LOCK;
+    lua_pop(L, 1);
+
+    lua_pop(L, 1); /* pop mouse_click.modifiers */
+    lua_pop(L, 1); /* pop pushed table */
+  }
+  vv_api_window_send_mouse_click(v, mouse_click);
+  return 0;
+}
+
+static int l_vv_api_window_send_mouse_scroll(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  luaL_checktype(L, 1, LUA_TTABLE);
+  struct velvet_api_mouse_scroll_event_args mouse_scroll = {0};
+  if (!lua_isnoneornil(L, 1)) {
+    luaL_checktype(L, 1, LUA_TTABLE);
+    lua_pushvalue(L, 1); /* push table to the top of the stack */
+
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "win_id"); /* get mouse_scroll.win_id */
+    mouse_scroll.win_id = luaL_checkinteger(L, -1);
+    lua_pop(L, 1); /* pop mouse_scroll.win_id */
+    lua_getfield(L, -1, "pos"); /* get mouse_scroll.pos */
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "row"); /* get mouse_scroll.pos.row */
+    mouse_scroll.pos.row = luaL_checkinteger(L, -1);
+    lua_pop(L, 1); /* pop mouse_scroll.pos.row */
+    lua_getfield(L, -1, "col"); /* get mouse_scroll.pos.col */
+    mouse_scroll.pos.col = luaL_checkinteger(L, -1);
+    lua_pop(L, 1); /* pop mouse_scroll.pos.col */
+    lua_pop(L, 1); /* pop mouse_scroll.pos */
+    lua_getfield(L, -1, "direction"); /* get mouse_scroll.direction */
+    struct u8_slice mouse_scroll_direction_str = luaL_checkslice(L, -1);
+    int scroll_direction_conv = scroll_direction_slice_to_enum(mouse_scroll_direction_str);
+    if (scroll_direction_conv == ~0) {
+      lua_pushstring(L, " is not a valid scroll_direction value.");
+      lua_concat(L, 2);
+      lua_error(L);
+    }
+    mouse_scroll.direction = scroll_direction_conv;
+    lua_pop(L, 1); /* pop mouse_scroll.direction */
+    lua_getfield(L, -1, "modifiers"); /* get mouse_scroll.modifiers */
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "shift");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      mouse_scroll.modifiers |= VELVET_API_KEY_MODIFIER_SHIFT;
+    lua_pop(L, 1);
+
+    lua_getfield(L, -1, "alt");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      mouse_scroll.modifiers |= VELVET_API_KEY_MODIFIER_ALT;
+    lua_pop(L, 1);
+
+    lua_getfield(L, -1, "control");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      mouse_scroll.modifiers |= VELVET_API_KEY_MODIFIER_CONTROL;
+    lua_pop(L, 1);
+
+    lua_getfield(L, -1, "super");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      mouse_scroll.modifiers |= VELVET_API_KEY_MODIFIER_SUPER;
+    lua_pop(L, 1);
+
+    lua_getfield(L, -1, "hyper");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      mouse_scroll.modifiers |= VELVET_API_KEY_MODIFIER_HYPER;
+    lua_pop(L, 1);
+
+    lua_getfield(L, -1, "meta");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      mouse_scroll.modifiers |= VELVET_API_KEY_MODIFIER_META;
+    lua_pop(L, 1);
+
+    lua_getfield(L, -1, "caps_lock");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      mouse_scroll.modifiers |= VELVET_API_KEY_MODIFIER_CAPS_LOCK;
+    lua_pop(L, 1);
+
+    lua_getfield(L, -1, "num_lock");
+    if (!lua_isnoneornil(L, -1) && luaL_checkboolean(L, -1))
+      mouse_scroll.modifiers |= VELVET_API_KEY_MODIFIER_NUM_LOCK;
+    lua_pop(L, 1);
+
+    lua_pop(L, 1); /* pop mouse_scroll.modifiers */
+    lua_pop(L, 1); /* pop pushed table */
+  }
+  vv_api_window_send_mouse_scroll(v, mouse_scroll);
+  return 0;
+}
+
+static int l_vv_api_window_create(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  struct velvet_api_window_create_options options = {0};
+  if (!lua_isnoneornil(L, 1)) {
+    luaL_checktype(L, 1, LUA_TTABLE);
+    lua_pushvalue(L, 1); /* push table to the top of the stack */
+
+    lua_getfield(L, -1, "working_directory"); /* get options.working_directory */
+
+    if (!lua_isnoneornil(L, -1)) {
+      options.working_directory.set = true;
+      options.working_directory.value = luaL_checkslice(L, -1);
+    }
+
+    lua_pop(L, 1); /* pop options.working_directory */
+    lua_getfield(L, -1, "parent_window"); /* get options.parent_window */
+
+    if (!lua_isnoneornil(L, -1)) {
+      options.parent_window.set = true;
+      options.parent_window.value = luaL_checkinteger(L, -1);
+    }
+
+    lua_pop(L, 1); /* pop options.parent_window */
+    lua_getfield(L, -1, "environment"); /* get options.environment */
+
+    if (!lua_isnoneornil(L, -1)) {
+      options.environment.set = true;
+      options.environment.value = luaL_checktable_and_shift(L, -1, ++argtop);
+    }
+
+    lua_pop(L, 1); /* pop options.environment */
+    lua_pop(L, 1); /* pop pushed table */
+  }
+  int ret = vv_api_window_create(v, options);
+  lua_pushinteger(L, ret);
+  return 1;
+}
+
+static int l_vv_api_window_create_process(lua_State *L) {
+  lua_Integer argtop = 2;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  lua_Integer cmd = 1;
+  struct velvet_api_window_create_options options = {0};
+  if (!lua_isnoneornil(L, 2)) {
+    luaL_checktype(L, 2, LUA_TTABLE);
+    lua_pushvalue(L, 2); /* push table to the top of the stack */
+
+    lua_getfield(L, -1, "working_directory"); /* get options.working_directory */
+
+    if (!lua_isnoneornil(L, -1)) {
+      options.working_directory.set = true;
+      options.working_directory.value = luaL_checkslice(L, -1);
+    }
+
+    lua_pop(L, 1); /* pop options.working_directory */
+    lua_getfield(L, -1, "parent_window"); /* get options.parent_window */
+
+    if (!lua_isnoneornil(L, -1)) {
+      options.parent_window.set = true;
+      options.parent_window.value = luaL_checkinteger(L, -1);
+    }
+
+    lua_pop(L, 1); /* pop options.parent_window */
+    lua_getfield(L, -1, "environment"); /* get options.environment */
+
+    if (!lua_isnoneornil(L, -1)) {
+      options.environment.set = true;
+      options.environment.value = luaL_checktable_and_shift(L, -1, ++argtop);
+    }
+
+    lua_pop(L, 1); /* pop options.environment */
+    lua_pop(L, 1); /* pop pushed table */
+  }
+  return vv_api_window_create_process(v, cmd, options);
+}
+
+static int l_vv_api_window_get_working_directory(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  struct u8_slice ret = vv_api_window_get_working_directory(v, win_id);
+  lua_pushslice(L, ret);
+  return 1;
+}
+
+static int l_vv_api_window_get_foreground_process_name(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  struct u8_slice ret = vv_api_window_get_foreground_process_name(v, win_id);
+  lua_pushslice(L, ret);
+  return 1;
+}
+
+static int l_vv_api_window_get_parent(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  struct optional_int ret = vv_api_window_get_parent(v, win_id);
+  if (!ret.set) {
+    return 0;
+  }
+  lua_pushinteger(L, ret.value);
+  return 1;
+}
+
+static int l_vv_api_window_set_parent(lua_State *L) {
+  lua_Integer argtop = 2;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  struct optional_int parent = {0};
+  if (lua_isinteger(L, 2)) {
+    parent.set = true;
+    parent.value = luaL_checkinteger(L, 2);
+  }
+  vv_api_window_set_parent(v, win_id, parent);
+  return 0;
+}
+
+static int l_vv_api_window_is_lua(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  bool ret = vv_api_window_is_lua(v, win_id);
+  lua_pushboolean(L, ret);
+  return 1;
+}
+
+static int l_vv_api_window_is_valid(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  struct optional_int win_id = {0};
+  if (lua_isinteger(L, 1)) {
+    win_id.set = true;
+    win_id.value = luaL_checkinteger(L, 1);
+  }
+  bool ret = vv_api_window_is_valid(v, win_id);
+  lua_pushboolean(L, ret);
+  return 1;
+}
+
+static int l_vv_api_window_get_scrollback_size(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  int ret = vv_api_window_get_scrollback_size(v, win_id);
+  lua_pushinteger(L, ret);
+  return 1;
+}
+
+static int l_vv_api_window_get_scrollback_compression(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  struct velvet_api_scrollback_compression ret = vv_api_window_get_scrollback_compression(v, win_id);
+  lua_newtable(L); /* ret = new scrollback_compression */
+  lua_pushinteger(L, ret.lines);
+  lua_setfield(L, -2, "lines"); /* ret.lines = lines */
+  lua_pushinteger(L, ret.raw_bytes);
+  lua_setfield(L, -2, "raw_bytes"); /* ret.raw_bytes = raw_bytes */
+  lua_pushinteger(L, ret.compressed_bytes);
+  lua_setfield(L, -2, "compressed_bytes"); /* ret.compressed_bytes = compressed_bytes */
+  lua_pushinteger(L, ret.spilled_bytes);
+  lua_setfield(L, -2, "spilled_bytes"); /* ret.spilled_bytes = spilled_bytes */
+  lua_pushnumber(L, ret.ratio);
+  lua_setfield(L, -2, "ratio"); /* ret.ratio = ratio */
+  return 1;
+}
+
+static int l_vv_api_window_get_memory_usage(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  struct velvet_api_memory_usage ret = vv_api_window_get_memory_usage(v, win_id);
+  lua_newtable(L); /* ret = new memory_usage */
+  lua_pushinteger(L, ret.cells);
+  lua_setfield(L, -2, "cells"); /* ret.cells = cells */
+  lua_pushinteger(L, ret.lines);
+  lua_setfield(L, -2, "lines"); /* ret.lines = lines */
+  lua_pushinteger(L, ret.styles);
+  lua_setfield(L, -2, "styles"); /* ret.styles = styles */
+  lua_pushinteger(L, ret.hyperlinks);
+  lua_setfield(L, -2, "hyperlinks"); /* ret.hyperlinks = hyperlinks */
+  lua_pushinteger(L, ret.scrollback);
+  lua_setfield(L, -2, "scrollback"); /* ret.scrollback = scrollback */
+  lua_pushinteger(L, ret.total);
+  lua_setfield(L, -2, "total"); /* ret.total = total */
+  return 1;
+}
+
+static int l_vv_api_window_get_scrollback_mode(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  enum velvet_api_scrollback_mode ret = vv_api_window_get_scrollback_mode(v, win_id);
+  lua_pushslice(L, scrollback_mode_to_slice(ret));
+  return 1;
+}
+
+static int l_vv_api_window_set_scrollback_mode(lua_State *L) {
+  lua_Integer argtop = 2;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  struct u8_slice mode_str = luaL_checkslice(L, 2);
+  enum velvet_api_scrollback_mode mode = scrollback_mode_slice_to_enum(mode_str);
+  vv_api_window_set_scrollback_mode(v, win_id, mode);
+  return 0;
+}
+
+static int l_vv_api_window_get_scroll_offset(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  int ret = vv_api_window_get_scroll_offset(v, win_id);
+  lua_pushinteger(L, ret);
+  return 1;
+}
+
+static int l_vv_api_window_set_scroll_offset(lua_State *L) {
+  lua_Integer argtop = 2;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  int scroll_offset = luaL_checkinteger(L, 2); /* poggies */
+  vv_api_window_set_scroll_offset(v, win_id, scroll_offset);
+  return 0;
+}
+
+static int l_vv_api_window_write(lua_State *L) {
+  lua_Integer argtop = 2;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  struct u8_slice text = luaL_checkslice(L, 2); /* poggies */
+  vv_api_window_write(v, win_id, text);
+  return 0;
+}
+
+static int l_vv_api_window_set_drawing_color(lua_State *L) {
+  lua_Integer argtop = 3;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  struct u8_slice brush_str = luaL_checkslice(L, 2);
+  enum velvet_api_brush brush = brush_slice_to_enum(brush_str);
+  luaL_checktype(L, 3, LUA_TTABLE);
+  struct velvet_api_rgb_color color = {0};
+  if (!lua_isnoneornil(L, 3)) {
+    luaL_checktype(L, 3, LUA_TTABLE);
+    lua_pushvalue(L, 3); /* push table to the top of the stack */
+
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "red"); /* get color.red */
+    color.red = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop color.red */
+    lua_getfield(L, -1, "green"); /* get color.green */
+    color.green = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop color.green */
+    lua_getfield(L, -1, "blue"); /* get color.blue */
+    color.blue = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop color.blue */
+    lua_getfield(L, -1, "alpha"); /* get color.alpha */
+
+    if (!lua_isnoneornil(L, -1)) {
+      color.alpha.set = true;
+      color.alpha.value = luaL_checknumber(L, -1);
+    }
+
+    lua_pop(L, 1); /* pop color.alpha */
+    lua_pop(L, 1); /* pop pushed table */
+  }
+  vv_api_window_set_drawing_color(v, win_id, brush, color);
+  return 0;
+}
+
+static int l_vv_api_window_get_cursor_position(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  struct velvet_api_coordinate ret = vv_api_window_get_cursor_position(v, win_id);
+  lua_newtable(L); /* ret = new coordinate */
+  lua_pushinteger(L, ret.row);
+  lua_setfield(L, -2, "row"); /* ret.row = row */
+  lua_pushinteger(L, ret.col);
+  lua_setfield(L, -2, "col"); /* ret.col = col */
+  return 1;
+}
+
+static int l_vv_api_window_set_cursor_position(lua_State *L) {
+  lua_Integer argtop = 2;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int win_id = luaL_checkinteger(L, 1); /* poggies */
+  luaL_checktype(L, 2, LUA_TTABLE);
+  struct velvet_api_coordinate pos = {0};
+  if (!lua_isnoneornil(L, 2)) {
+    luaL_checktype(L, 2, LUA_TTABLE);
+    lua_pushvalue(L, 2); /* push table to the top of the stack */
+
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "row"); /* get pos.row */
+    pos.row = luaL_checkinteger(L, -1);
+    lua_pop(L, 1); /* pop pos.row */
+    lua_getfield(L, -1, "col"); /* get pos.col */
+    pos.col = luaL_checkinteger(L, -1);
+    lua_pop(L, 1); /* pop pos.col */
+    lua_pop(L, 1); /* pop pushed table */
+  }
+  vv_api_window_set_cursor_position(v, win_id, pos);
+  return 0;
+}
+
+static int l_vv_api_clipboard_set(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  struct u8_slice text = luaL_checkslice(L, 1); /* poggies */
+  vv_api_clipboard_set(v, text);
+  return 0;
+}
+
+static int l_vv_api_string_display_width(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  struct u8_slice string = luaL_checkslice(L, 1); /* poggies */
+  int ret = vv_api_string_display_width(v, string);
+  lua_pushinteger(L, ret);
+  return 1;
+}
+
+static int l_vv_api_string_lower(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  struct u8_slice string = luaL_checkslice(L, 1); /* poggies */
+  struct u8_slice ret = vv_api_string_lower(v, string);
+  lua_pushslice(L, ret);
+  return 1;
+}
+
+static int l_vv_api_string_upper(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  struct u8_slice string = luaL_checkslice(L, 1); /* poggies */
+  struct u8_slice ret = vv_api_string_upper(v, string);
+  lua_pushslice(L, ret);
+  return 1;
+}
+
+static int l_vv_api_runtime_store_value(lua_State *L) {
+  lua_Integer argtop = 2;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  struct u8_slice name = luaL_checkslice(L, 1); /* poggies */
+  lua_Integer value = 2;
+  return vv_api_runtime_store_value(v, name, value);
+}
+
+static int l_vv_api_runtime_load_value(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  struct u8_slice name = luaL_checkslice(L, 1); /* poggies */
+  return vv_api_runtime_load_value(v, name);
+}
+
+static int l_vv_api_debug_set_display_damage(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  bool mode = luaL_checkboolean(L, 1); /* poggies */
+  vv_api_debug_set_display_damage(v, mode);
+  return 0;
+}
+
+static int l_vv_api_get_servernames(lua_State *L) {
+  lua_Integer argtop = 0;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  return vv_api_get_servernames(v);
+}
+
+static int l_vv_api_get_servername(lua_State *L) {
+  lua_Integer argtop = 0;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  struct u8_slice ret = vv_api_get_servername(v);
+  lua_pushslice(L, ret);
+  return 1;
+}
+
+static int l_vv_api_get_processes(lua_State *L) {
+  lua_Integer argtop = 0;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  return vv_api_get_processes(v);
+}
+
+static int l_vv_api_process_kill(lua_State *L) {
+  lua_Integer argtop = 2;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int id = luaL_checkinteger(L, 1); /* poggies */
+  struct u8_slice signal_str;
+  if (lua_isstring(L, 2)) {
+    signal_str = luaL_checkslice(L, 2);
+  } else {
+    signal_str = u8_slice_from_cstr("term");
+  }
+  enum velvet_api_unix_signal signal = unix_signal_slice_to_enum(signal_str);
+  vv_api_process_kill(v, id, signal);
+  return 0;
+}
+
+static int l_vv_api_process_write_stdin(lua_State *L) {
+  lua_Integer argtop = 2;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int id = luaL_checkinteger(L, 1); /* poggies */
+  struct u8_slice text = luaL_checkslice(L, 2); /* poggies */
+  vv_api_process_write_stdin(v, id, text);
+  return 0;
+}
+
+static int l_vv_api_process_close_stdin(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int id = luaL_checkinteger(L, 1); /* poggies */
+  vv_api_process_close_stdin(v, id);
+  return 0;
+}
+
+static int l_vv_api_process_spawn(lua_State *L) {
+  lua_Integer argtop = 2;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  lua_Integer cmd = 1;
+  struct velvet_api_process_spawn_options options = {0};
+  if (!lua_isnoneornil(L, 2)) {
+    luaL_checktype(L, 2, LUA_TTABLE);
+    lua_pushvalue(L, 2); /* push table to the top of the stack */
+
+    lua_getfield(L, -1, "working_directory"); /* get options.working_directory */
+
+    if (!lua_isnoneornil(L, -1)) {
+      options.working_directory.set = true;
+      options.working_directory.value = luaL_checkslice(L, -1);
+    }
+
+    lua_pop(L, 1); /* pop options.working_directory */
+    lua_getfield(L, -1, "environment"); /* get options.environment */
+
+    if (!lua_isnoneornil(L, -1)) {
+      options.environment.set = true;
+      options.environment.value = luaL_checktable_and_shift(L, -1, ++argtop);
+    }
+
+    lua_pop(L, 1); /* pop options.environment */
+    lua_getfield(L, -1, "stdin_pipe"); /* get options.stdin_pipe */
+    if (lua_isnoneornil(L, -1)) {
+      options.stdin_pipe = false;
+    } else {
+      options.stdin_pipe = luaL_checkboolean(L, -1);
+    }
+    lua_pop(L, 1); /* pop options.stdin_pipe */
+    lua_getfield(L, -1, "on_stdout"); /* get options.on_stdout */
+
+    if (!lua_isnoneornil(L, -1)) {
+      options.on_stdout.set = true;
+      options.on_stdout.value = luaL_checkfunction_and_shift(L, -1, ++argtop);
+    }
+
+    lua_pop(L, 1); /* pop options.on_stdout */
+    lua_getfield(L, -1, "on_stderr"); /* get options.on_stderr */
+
+    if (!lua_isnoneornil(L, -1)) {
+      options.on_stderr.set = true;
+      options.on_stderr.value = luaL_checkfunction_and_shift(L, -1, ++argtop);
+    }
+
+    lua_pop(L, 1); /* pop options.on_stderr */
+    lua_getfield(L, -1, "on_exit"); /* get options.on_exit */
+
+    if (!lua_isnoneornil(L, -1)) {
+      options.on_exit.set = true;
+      options.on_exit.value = luaL_checkfunction_and_shift(L, -1, ++argtop);
+    }
+
+    lua_pop(L, 1); /* pop options.on_exit */
+    lua_pop(L, 1); /* pop pushed table */
+  }
+  return vv_api_process_spawn(v, cmd, options);
+}
+
+static int l_vv_api_get_environment(lua_State *L) {
+  lua_Integer argtop = 0;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  return vv_api_get_environment(v);
+}
+
+static int l_vv_api_get_scrollback_scroll_multiplier(lua_State *L) {
+  lua_Integer argtop = 0;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int ret = vv_api_get_scrollback_scroll_multiplier(v);
+  lua_pushinteger(L, ret);
+  return 1;
+}
+
+static int l_vv_api_set_scrollback_scroll_multiplier(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int value = luaL_checkinteger(L, 1); /* poggies */
+  vv_api_set_scrollback_scroll_multiplier(v, value);
+  return 0;
+}
+
+static int l_vv_api_get_scrollback_memory_budget(lua_State *L) {
+  lua_Integer argtop = 0;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int ret = vv_api_get_scrollback_memory_budget(v);
+  lua_pushinteger(L, ret);
+  return 1;
+}
+
+static int l_vv_api_set_scrollback_memory_budget(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int value = luaL_checkinteger(L, 1); /* poggies */
+  vv_api_set_scrollback_memory_budget(v, value);
+  return 0;
+}
+
+static int l_vv_api_get_left_right_margins(lua_State *L) {
+  lua_Integer argtop = 0;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  bool ret = vv_api_get_left_right_margins(v);
+  lua_pushboolean(L, ret);
+  return 1;
+}
+
+static int l_vv_api_set_left_right_margins(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  bool value = luaL_checkboolean(L, 1); /* poggies */
+  vv_api_set_left_right_margins(v, value);
+  return 0;
+}
+
+static int l_vv_api_get_repeat_characters(lua_State *L) {
+  lua_Integer argtop = 0;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  bool ret = vv_api_get_repeat_characters(v);
+  lua_pushboolean(L, ret);
+  return 1;
+}
+
+static int l_vv_api_set_repeat_characters(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  bool value = luaL_checkboolean(L, 1); /* poggies */
+  vv_api_set_repeat_characters(v, value);
+  return 0;
+}
+
+static int l_vv_api_get_theme(lua_State *L) {
+  lua_Integer argtop = 0;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  struct velvet_api_theme ret = vv_api_get_theme(v);
+  lua_newtable(L); /* ret = new theme */
+  lua_newtable(L); /* ret.black = new rgb_color */
+  lua_pushnumber(L, ret.black.red);
+  lua_setfield(L, -2, "red"); /* ret.black.red = red */
+  lua_pushnumber(L, ret.black.green);
+  lua_setfield(L, -2, "green"); /* ret.black.green = green */
+  lua_pushnumber(L, ret.black.blue);
+  lua_setfield(L, -2, "blue"); /* ret.black.blue = blue */
+  lua_pushnumber(L, ret.black.alpha.value);
+  lua_setfield(L, -2, "alpha"); /* ret.black.alpha.value = alpha */
+  lua_setfield(L, -2, "black"); /* ret.black = black */
+  lua_newtable(L); /* ret.red = new rgb_color */
+  lua_pushnumber(L, ret.red.red);
+  lua_setfield(L, -2, "red"); /* ret.red.red = red */
+  lua_pushnumber(L, ret.red.green);
+  lua_setfield(L, -2, "green"); /* ret.red.green = green */
+  lua_pushnumber(L, ret.red.blue);
+  lua_setfield(L, -2, "blue"); /* ret.red.blue = blue */
+  lua_pushnumber(L, ret.red.alpha.value);
+  lua_setfield(L, -2, "alpha"); /* ret.red.alpha.value = alpha */
+  lua_setfield(L, -2, "red"); /* ret.red = red */
+  lua_newtable(L); /* ret.green = new rgb_color */
+  lua_pushnumber(L, ret.green.red);
+  lua_setfield(L, -2, "red"); /* ret.green.red = red */
+  lua_pushnumber(L, ret.green.green);
+  lua_setfield(L, -2, "green"); /* ret.green.green = green */
+  lua_pushnumber(L, ret.green.blue);
+  lua_setfield(L, -2, "blue"); /* ret.green.blue = blue */
+  lua_pushnumber(L, ret.green.alpha.value);
+  lua_setfield(L, -2, "alpha"); /* ret.green.alpha.value = alpha */
+  lua_setfield(L, -2, "green"); /* ret.green = green */
+  lua_newtable(L); /* ret.yellow = new rgb_color */
+  lua_pushnumber(L, ret.yellow.red);
+  lua_setfield(L, -2, "red"); /* ret.yellow.red = red */
+  lua_pushnumber(L, ret.yellow.green);
+  lua_setfield(L, -2, "green"); /* ret.yellow.green = green */
+  lua_pushnumber(L, ret.yellow.blue);
+  lua_setfield(L, -2, "blue"); /* ret.yellow.blue = blue */
+  lua_pushnumber(L, ret.yellow.alpha.value);
+  lua_setfield(L, -2, "alpha"); /* ret.yellow.alpha.value = alpha */
+  lua_setfield(L, -2, "yellow"); /* ret.yellow = yellow */
+  lua_newtable(L); /* ret.blue = new rgb_color */
+  lua_pushnumber(L, ret.blue.red);
+  lua_setfield(L, -2, "red"); /* ret.blue.red = red */
+  lua_pushnumber(L, ret.blue.green);
+  lua_setfield(L, -2, "green"); /* ret.blue.green = green */
+  lua_pushnumber(L, ret.blue.blue);
+  lua_setfield(L, -2, "blue"); /* ret.blue.blue = blue */
+  lua_pushnumber(L, ret.blue.alpha.value);
+  lua_setfield(L, -2, "alpha"); /* ret.blue.alpha.value = alpha */
+  lua_setfield(L, -2, "blue"); /* ret.blue = blue */
+  lua_newtable(L); /* ret.magenta = new rgb_color */
+  lua_pushnumber(L, ret.magenta.red);
+  lua_setfield(L, -2, "red"); /* ret.magenta.red = red */
+  lua_pushnumber(L, ret.magenta.green);
+  lua_setfield(L, -2, "green"); /* ret.magenta.green = green */
+  lua_pushnumber(L, ret.magenta.blue);
+  lua_setfield(L, -2, "blue"); /* ret.magenta.blue = blue */
+  lua_pushnumber(L, ret.magenta.alpha.value);
+  lua_setfield(L, -2, "alpha"); /* ret.magenta.alpha.value = alpha */
+  lua_setfield(L, -2, "magenta"); /* ret.magenta = magenta */
+  lua_newtable(L); /* ret.cyan = new rgb_color */
+  lua_pushnumber(L, ret.cyan.red);
+  lua_setfield(L, -2, "red"); /* ret.cyan.red = red */
+  lua_pushnumber(L, ret.cyan.green);
+  lua_setfield(L, -2, "green"); /* ret.cyan.green = green */
+  lua_pushnumber(L, ret.cyan.blue);
+  lua_setfield(L, -2, "blue"); /* ret.cyan.blue = blue */
+  lua_pushnumber(L, ret.cyan.alpha.value);
+  lua_setfield(L, -2, "alpha"); /* ret.cyan.alpha.value = alpha */
+  lua_setfield(L, -2, "cyan"); /* ret.cyan = cyan */
+  lua_newtable(L); /* ret.white = new rgb_color */
+  lua_pushnumber(L, ret.white.red);
+  lua_setfield(L, -2, "red"); /* ret.white.red = red */
+  lua_pushnumber(L, ret.white.green);
+  lua_setfield(L, -2, "green"); /* ret.white.green = green */
+  lua_pushnumber(L, ret.white.blue);
+  lua_setfield(L, -2, "blue"); /* ret.white.blue = blue */
+  lua_pushnumber(L, ret.white.alpha.value);
+  lua_setfield(L, -2, "alpha"); /* ret.white.alpha.value = alpha */
+  lua_setfield(L, -2, "white"); /* ret.white = white */
+  lua_newtable(L); /* ret.bright_black = new rgb_color */
+  lua_pushnumber(L, ret.bright_black.red);
+  lua_setfield(L, -2, "red"); /* ret.bright_black.red = red */
+  lua_pushnumber(L, ret.bright_black.green);
+  lua_setfield(L, -2, "green"); /* ret.bright_black.green = green */
+  lua_pushnumber(L, ret.bright_black.blue);
+  lua_setfield(L, -2, "blue"); /* ret.bright_black.blue = blue */
+  lua_pushnumber(L, ret.bright_black.alpha.value);
+  lua_setfield(L, -2, "alpha"); /* ret.bright_black.alpha.value = alpha */
+  lua_setfield(L, -2, "bright_black"); /* ret.bright_black = bright_black */
+  lua_newtable(L); /* ret.bright_red = new rgb_color */
+  lua_pushnumber(L, ret.bright_red.red);
+  lua_setfield(L, -2, "red"); /* ret.bright_red.red = red */
+  lua_pushnumber(L, ret.bright_red.green);
+  lua_setfield(L, -2, "green"); /* ret.bright_red.green = green */
+  lua_pushnumber(L, ret.bright_red.blue);
+  lua_setfield(L, -2, "blue"); /* ret.bright_red.blue = blue */
+  lua_pushnumber(L, ret.bright_red.alpha.value);
+  lua_setfield(L, -2, "alpha"); /* ret.bright_red.alpha.value = alpha */
+  lua_setfield(L, -2, "bright_red"); /* ret.bright_red = bright_red */
+  lua_newtable(L); /* ret.bright_green = new rgb_color */
+  lua_pushnumber(L, ret.bright_green.red);
+  lua_setfield(L, -2, "red"); /* ret.bright_green.red = red */
+  lua_pushnumber(L, ret.bright_green.green);
+  lua_setfield(L, -2, "green"); /* ret.bright_green.green = green */
+  lua_pushnumber(L, ret.bright_green.blue);
+  lua_setfield(L, -2, "blue"); /* ret.bright_green.blue = blue */
+  lua_pushnumber(L, ret.bright_green.alpha.value);
+  lua_setfield(L, -2, "alpha"); /* ret.bright_green.alpha.value = alpha */
+  lua_setfield(L, -2, "bright_green"); /* ret.bright_green = bright_green */
+  lua_newtable(L); /* ret.bright_yellow = new rgb_color */
+  lua_pushnumber(L, ret.bright_yellow.red);
+  lua_setfield(L, -2, "red"); /* ret.bright_yellow.red = red */
+  lua_pushnumber(L, ret.bright_yellow.green);
+  lua_setfield(L, -2, "green"); /* ret.bright_yellow.green = green */
+  lua_pushnumber(L, ret.bright_yellow.blue);
+  lua_setfield(L, -2, "blue"); /* ret.bright_yellow.blue = blue */
+  lua_pushnumber(L, ret.bright_yellow.alpha.value);
+  lua_setfield(L, -2, "alpha"); /* ret.bright_yellow.alpha.value = alpha */
+  lua_setfield(L, -2, "bright_yellow"); /* ret.bright_yellow = bright_yellow */
+  lua_newtable(L); /* ret.bright_blue = new rgb_color */
+  lua_pushnumber(L, ret.bright_blue.red);
+  lua_setfield(L, -2, "red"); /* ret.bright_blue.red = red */
+  lua_pushnumber(L, ret.bright_blue.green);
+  lua_setfield(L, -2, "green"); /* ret.bright_blue.green = green */
+  lua_pushnumber(L, ret.bright_blue.blue);
+  lua_setfield(L, -2, "blue"); /* ret.bright_blue.blue = blue */
+  lua_pushnumber(L, ret.bright_blue.alpha.value);
+  lua_setfield(L, -2, "alpha"); /* ret.bright_blue.alpha.value = alpha */
+  lua_setfield(L, -2, "bright_blue"); /* ret.bright_blue = bright_blue */
+  lua_newtable(L); /* ret.bright_magenta = new rgb_color */
+  lua_pushnumber(L, ret.bright_magenta.red);
+  lua_setfield(L, -2, "red"); /* ret.bright_magenta.red = red */
+  lua_pushnumber(L, ret.bright_magenta.green);
+  lua_setfield(L, -2, "green"); /* ret.bright_magenta.green = green */
+  lua_pushnumber(L, ret.bright_magenta.blue);
+  lua_setfield(L, -2, "blue"); /* ret.bright_magenta.blue = blue */
+  lua_pushnumber(L, ret.bright_magenta.alpha.value);
+  lua_setfield(L, -2, "alpha"); /* ret.bright_magenta.alpha.value = alpha */
+  lua_setfield(L, -2, "bright_magenta"); /* ret.bright_magenta = bright_magenta */
+  lua_newtable(L); /* ret.bright_cyan = new rgb_color */
+  lua_pushnumber(L, ret.bright_cyan.red);
+  lua_setfield(L, -2, "red"); /* ret.bright_cyan.red = red */
+  lua_pushnumber(L, ret.bright_cyan.green);
+  lua_setfield(L, -2, "green"); /* ret.bright_cyan.green = green */
+  lua_pushnumber(L, ret.bright_cyan.blue);
+  lua_setfield(L, -2, "blue"); /* ret.bright_cyan.blue = blue */
+  lua_pushnumber(L, ret.bright_cyan.alpha.value);
+  lua_setfield(L, -2, "alpha"); /* ret.bright_cyan.alpha.value = alpha */
+  lua_setfield(L, -2, "bright_cyan"); /* ret.bright_cyan = bright_cyan */
+  lua_newtable(L); /* ret.bright_white = new rgb_color */
+  lua_pushnumber(L, ret.bright_white.red);
+  lua_setfield(L, -2, "red"); /* ret.bright_white.red = red */
+  lua_pushnumber(L, ret.bright_white.green);
+  lua_setfield(L, -2, "green"); /* ret.bright_white.green = green */
+  lua_pushnumber(L, ret.bright_white.blue);
+  lua_setfield(L, -2, "blue"); /* ret.bright_white.blue = blue */
+  lua_pushnumber(L, ret.bright_white.alpha.value);
+  lua_setfield(L, -2, "alpha"); /* ret.bright_white.alpha.value = alpha */
+  lua_setfield(L, -2, "bright_white"); /* ret.bright_white = bright_white */
+  lua_newtable(L); /* ret.foreground = new rgb_color */
+  lua_pushnumber(L, ret.foreground.red);
+  lua_setfield(L, -2, "red"); /* ret.foreground.red = red */
+  lua_pushnumber(L, ret.foreground.green);
+  lua_setfield(L, -2, "green"); /* ret.foreground.green = green */
+  lua_pushnumber(L, ret.foreground.blue);
+  lua_setfield(L, -2, "blue"); /* ret.foreground.blue = blue */
+  lua_pushnumber(L, ret.foreground.alpha.value);
+  lua_setfield(L, -2, "alpha"); /* ret.foreground.alpha.value = alpha */
+  lua_setfield(L, -2, "foreground"); /* ret.foreground = foreground */
+  lua_newtable(L); /* ret.background = new rgb_color */
+  lua_pushnumber(L, ret.background.red);
+  lua_setfield(L, -2, "red"); /* ret.background.red = red */
+  lua_pushnumber(L, ret.background.green);
+  lua_setfield(L, -2, "green"); /* ret.background.green = green */
+  lua_pushnumber(L, ret.background.blue);
+  lua_setfield(L, -2, "blue"); /* ret.background.blue = blue */
+  lua_pushnumber(L, ret.background.alpha.value);
+  lua_setfield(L, -2, "alpha"); /* ret.background.alpha.value = alpha */
+  lua_setfield(L, -2, "background"); /* ret.background = background */
+  lua_newtable(L); /* ret.cursor_foreground.value = new rgb_color */
+  lua_pushnumber(L, ret.cursor_foreground.value.red);
+  lua_setfield(L, -2, "red"); /* ret.cursor_foreground.value.red = red */
+  lua_pushnumber(L, ret.cursor_foreground.value.green);
+  lua_setfield(L, -2, "green"); /* ret.cursor_foreground.value.green = green */
+  lua_pushnumber(L, ret.cursor_foreground.value.blue);
+  lua_setfield(L, -2, "blue"); /* ret.cursor_foreground.value.blue = blue */
+  lua_pushnumber(L, ret.cursor_foreground.value.alpha.value);
+  lua_setfield(L, -2, "alpha"); /* ret.cursor_foreground.value.alpha.value = alpha */
+  lua_setfield(L, -2, "cursor_foreground"); /* ret.cursor_foreground.value = cursor_foreground */
+  lua_newtable(L); /* ret.cursor_background.value = new rgb_color */
+  lua_pushnumber(L, ret.cursor_background.value.red);
+  lua_setfield(L, -2, "red"); /* ret.cursor_background.value.red = red */
+  lua_pushnumber(L, ret.cursor_background.value.green);
+  lua_setfield(L, -2, "green"); /* ret.cursor_background.value.green = green */
+  lua_pushnumber(L, ret.cursor_background.value.blue);
+  lua_setfield(L, -2, "blue"); /* ret.cursor_background.value.blue = blue */
+  lua_pushnumber(L, ret.cursor_background.value.alpha.value);
+  lua_setfield(L, -2, "alpha"); /* ret.cursor_background.value.alpha.value = alpha */
+  lua_setfield(L, -2, "cursor_background"); /* ret.cursor_background.value = cursor_background */
+  lua_pushboolean(L, ret.bold_bright_colors.value);
+  lua_setfield(L, -2, "bold_bright_colors"); /* ret.bold_bright_colors.value = bold_bright_colors */
+  return 1;
+}
+
+static int l_vv_api_set_theme(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  luaL_checktype(L, 1, LUA_TTABLE);
+  struct velvet_api_theme value = {0};
+  if (!lua_isnoneornil(L, 1)) {
+    luaL_checktype(L, 1, LUA_TTABLE);
+    lua_pushvalue(L, 1); /* push table to the top of the stack */
+
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "black"); /* get value.black */
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "red"); /* get value.black.red */
+    value.black.red = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.black.red */
+    lua_getfield(L, -1, "green"); /* get value.black.green */
+    value.black.green = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.black.green */
+    lua_getfield(L, -1, "blue"); /* get value.black.blue */
+    value.black.blue = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.black.blue */
+    lua_getfield(L, -1, "alpha"); /* get value.black.alpha */
+
+    if (!lua_isnoneornil(L, -1)) {
+      value.black.alpha.set = true;
+      value.black.alpha.value = luaL_checknumber(L, -1);
+    }
+
+    lua_pop(L, 1); /* pop value.black.alpha */
+    lua_pop(L, 1); /* pop value.black */
+    lua_getfield(L, -1, "red"); /* get value.red */
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "red"); /* get value.red.red */
+    value.red.red = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.red.red */
+    lua_getfield(L, -1, "green"); /* get value.red.green */
+    value.red.green = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.red.green */
+    lua_getfield(L, -1, "blue"); /* get value.red.blue */
+    value.red.blue = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.red.blue */
+    lua_getfield(L, -1, "alpha"); /* get value.red.alpha */
+
+    if (!lua_isnoneornil(L, -1)) {
+      value.red.alpha.set = true;
+      value.red.alpha.value = luaL_checknumber(L, -1);
+    }
+
+    lua_pop(L, 1); /* pop value.red.alpha */
+    lua_pop(L, 1); /* pop value.red */
+    lua_getfield(L, -1, "green"); /* get value.green */
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "red"); /* get value.green.red */
+    value.green.red = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.green.red */
+    lua_getfield(L, -1, "green"); /* get value.green.green */
+    value.green.green = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.green.green */
+    lua_getfield(L, -1, "blue"); /* get value.green.blue */
+    value.green.blue = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.green.blue */
+    lua_getfield(L, -1, "alpha"); /* get value.green.alpha */
+
+    if (!lua_isnoneornil(L, -1)) {
+      value.green.alpha.set = true;
+      value.green.alpha.value = luaL_checknumber(L, -1);
+    }
+
+    lua_pop(L, 1); /* pop value.green.alpha */
+    lua_pop(L, 1); /* pop value.green */
+    lua_getfield(L, -1, "yellow"); /* get value.yellow */
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "red"); /* get value.yellow.red */
+    value.yellow.red = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.yellow.red */
+    lua_getfield(L, -1, "green"); /* get value.yellow.green */
+    value.yellow.green = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.yellow.green */
+    lua_getfield(L, -1, "blue"); /* get value.yellow.blue */
+    value.yellow.blue = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.yellow.blue */
+    lua_getfield(L, -1, "alpha"); /* get value.yellow.alpha */
+
+    if (!lua_isnoneornil(L, -1)) {
+      value.yellow.alpha.set = true;
+      value.yellow.alpha.value = luaL_checknumber(L, -1);
+    }
+
+    lua_pop(L, 1); /* pop value.yellow.alpha */
+    lua_pop(L, 1); /* pop value.yellow */
+    lua_getfield(L, -1, "blue"); /* get value.blue */
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "red"); /* get value.blue.red */
+    value.blue.red = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.blue.red */
+    lua_getfield(L, -1, "green"); /* get value.blue.green */
+    value.blue.green = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.blue.green */
+    lua_getfield(L, -1, "blue"); /* get value.blue.blue */
+    value.blue.blue = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.blue.blue */
+    lua_getfield(L, -1, "alpha"); /* get value.blue.alpha */
+
+    if (!lua_isnoneornil(L, -1)) {
+      value.blue.alpha.set = true;
+      value.blue.alpha.value = luaL_checknumber(L, -1);
+    }
+
+    lua_pop(L, 1); /* pop value.blue.alpha */
+    lua_pop(L, 1); /* pop value.blue */
+    lua_getfield(L, -1, "magenta"); /* get value.magenta */
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "red"); /* get value.magenta.red */
+    value.magenta.red = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.magenta.red */
+    lua_getfield(L, -1, "green"); /* get value.magenta.green */
+    value.magenta.green = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.magenta.green */
+    lua_getfield(L, -1, "blue"); /* get value.magenta.blue */
+    value.magenta.blue = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.magenta.blue */
+    lua_getfield(L, -1, "alpha"); /* get value.magenta.alpha */
+
+    if (!lua_isnoneornil(L, -1)) {
+      value.magenta.alpha.set = true;
+      value.magenta.alpha.value = luaL_checknumber(L, -1);
+    }
+
+    lua_pop(L, 1); /* pop value.magenta.alpha */
+    lua_pop(L, 1); /* pop value.magenta */
+    lua_getfield(L, -1, "cyan"); /* get value.cyan */
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "red"); /* get value.cyan.red */
+    value.cyan.red = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.cyan.red */
+    lua_getfield(L, -1, "green"); /* get value.cyan.green */
+    value.cyan.green = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.cyan.green */
+    lua_getfield(L, -1, "blue"); /* get value.cyan.blue */
+    value.cyan.blue = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.cyan.blue */
+    lua_getfield(L, -1, "alpha"); /* get value.cyan.alpha */
+
+    if (!lua_isnoneornil(L, -1)) {
+      value.cyan.alpha.set = true;
+      value.cyan.alpha.value = luaL_checknumber(L, -1);
+    }
+
+    lua_pop(L, 1); /* pop value.cyan.alpha */
+    lua_pop(L, 1); /* pop value.cyan */
+    lua_getfield(L, -1, "white"); /* get value.white */
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "red"); /* get value.white.red */
+    value.white.red = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.white.red */
+    lua_getfield(L, -1, "green"); /* get value.white.green */
+    value.white.green = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.white.green */
+    lua_getfield(L, -1, "blue"); /* get value.white.blue */
+    value.white.blue = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.white.blue */
+    lua_getfield(L, -1, "alpha"); /* get value.white.alpha */
+
+    if (!lua_isnoneornil(L, -1)) {
+      value.white.alpha.set = true;
+      value.white.alpha.value = luaL_checknumber(L, -1);
+    }
+
+    lua_pop(L, 1); /* pop value.white.alpha */
+    lua_pop(L, 1); /* pop value.white */
+    lua_getfield(L, -1, "bright_black"); /* get value.bright_black */
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "red"); /* get value.bright_black.red */
+    value.bright_black.red = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.bright_black.red */
+    lua_getfield(L, -1, "green"); /* get value.bright_black.green */
+    value.bright_black.green = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.bright_black.green */
+    lua_getfield(L, -1, "blue"); /* get value.bright_black.blue */
+    value.bright_black.blue = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.bright_black.blue */
+    lua_getfield(L, -1, "alpha"); /* get value.bright_black.alpha */
+
+    if (!lua_isnoneornil(L, -1)) {
+      value.bright_black.alpha.set = true;
+      value.bright_black.alpha.value = luaL_checknumber(L, -1);
+    }
+
+    lua_pop(L, 1); /* pop value.bright_black.alpha */
+    lua_pop(L, 1); /* pop value.bright_black */
+    lua_getfield(L, -1, "bright_red"); /* get value.bright_red */
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "red"); /* get value.bright_red.red */
+    value.bright_red.red = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.bright_red.red */
+    lua_getfield(L, -1, "green"); /* get value.bright_red.green */
+    value.bright_red.green = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.bright_red.green */
+    lua_getfield(L, -1, "blue"); /* get value.bright_red.blue */
+    value.bright_red.blue = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.bright_red.blue */
+    lua_getfield(L, -1, "alpha"); /* get value.bright_red.alpha */
+
+    if (!lua_isnoneornil(L, -1)) {
+      value.bright_red.alpha.set = true;
+      value.bright_red.alpha.value = luaL_checknumber(L, -1);
+    }
+
+    lua_pop(L, 1); /* pop value.bright_red.alpha */
+    lua_pop(L, 1); /* pop value.bright_red */
+    lua_getfield(L, -1, "bright_green"); /* get value.bright_green */
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "red"); /* get value.bright_green.red */
+    value.bright_green.red = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.bright_green.red */
+    lua_getfield(L, -1, "green"); /* get value.bright_green.green */
+    value.bright_green.green = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.bright_green.green */
+    lua_getfield(L, -1, "blue"); /* get value.bright_green.blue */
+    value.bright_green.blue = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.bright_green.blue */
+    lua_getfield(L, -1, "alpha"); /* get value.bright_green.alpha */
+
+    if (!lua_isnoneornil(L, -1)) {
+      value.bright_green.alpha.set = true;
+      value.bright_green.alpha.value = luaL_checknumber(L, -1);
+    }
+
+    lua_pop(L, 1); /* pop value.bright_green.alpha */
+    lua_pop(L, 1); /* pop value.bright_green */
+    lua_getfield(L, -1, "bright_yellow"); /* get value.bright_yellow */
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "red"); /* get value.bright_yellow.red */
+    value.bright_yellow.red = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.bright_yellow.red */
+    lua_getfield(L, -1, "green"); /* get value.bright_yellow.green */
+    value.bright_yellow.green = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.bright_yellow.green */
+    lua_getfield(L, -1, "blue"); /* get value.bright_yellow.blue */
+    value.bright_yellow.blue = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.bright_yellow.blue */
+    lua_getfield(L, -1, "alpha"); /* get value.bright_yellow.alpha */
+
+    if (!lua_isnoneornil(L, -1)) {
+      value.bright_yellow.alpha.set = true;
+      value.bright_yellow.alpha.value = luaL_checknumber(L, -1);
+    }
+
+    lua_pop(L, 1); /* pop value.bright_yellow.alpha */
+    lua_pop(L, 1); /* pop value.bright_yellow */
+    lua_getfield(L, -1, "bright_blue"); /* get value.bright_blue */
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "red"); /* get value.bright_blue.red */
+    value.bright_blue.red = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.bright_blue.red */
+    lua_getfield(L, -1, "green"); /* get value.bright_blue.green */
+    value.bright_blue.green = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.bright_blue.green */
+    lua_getfield(L, -1, "blue"); /* get value.bright_blue.blue */
+    value.bright_blue.blue = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.bright_blue.blue */
+    lua_getfield(L, -1, "alpha"); /* get value.bright_blue.alpha */
+
+    if (!lua_isnoneornil(L, -1)) {
+      value.bright_blue.alpha.set = true;
+      value.bright_blue.alpha.value = luaL_checknumber(L, -1);
+    }
+
+    lua_pop(L, 1); /* pop value.bright_blue.alpha */
+    lua_pop(L, 1); /* pop value.bright_blue */
+    lua_getfield(L, -1, "bright_magenta"); /* get value.bright_magenta */
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "red"); /* get value.bright_magenta.red */
+    value.bright_magenta.red = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.bright_magenta.red */
+    lua_getfield(L, -1, "green"); /* get value.bright_magenta.green */
+    value.bright_magenta.green = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.bright_magenta.green */
+    lua_getfield(L, -1, "blue"); /* get value.bright_magenta.blue */
+    value.bright_magenta.blue = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.bright_magenta.blue */
+    lua_getfield(L, -1, "alpha"); /* get value.bright_magenta.alpha */
+
+    if (!lua_isnoneornil(L, -1)) {
+      value.bright_magenta.alpha.set = true;
+      value.bright_magenta.alpha.value = luaL_checknumber(L, -1);
+    }
+
+    lua_pop(L, 1); /* pop value.bright_magenta.alpha */
+    lua_pop(L, 1); /* pop value.bright_magenta */
+    lua_getfield(L, -1, "bright_cyan"); /* get value.bright_cyan */
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "red"); /* get value.bright_cyan.red */
+    value.bright_cyan.red = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.bright_cyan.red */
+    lua_getfield(L, -1, "green"); /* get value.bright_cyan.green */
+    value.bright_cyan.green = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.bright_cyan.green */
+    lua_getfield(L, -1, "blue"); /* get value.bright_cyan.blue */
+    value.bright_cyan.blue = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.bright_cyan.blue */
+    lua_getfield(L, -1, "alpha"); /* get value.bright_cyan.alpha */
+
+    if (!lua_isnoneornil(L, -1)) {
+      value.bright_cyan.alpha.set = true;
+      value.bright_cyan.alpha.value = luaL_checknumber(L, -1);
+    }
+
+    lua_pop(L, 1); /* pop value.bright_cyan.alpha */
+    lua_pop(L, 1); /* pop value.bright_cyan */
+    lua_getfield(L, -1, "bright_white"); /* get value.bright_white */
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "red"); /* get value.bright_white.red */
+    value.bright_white.red = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.bright_white.red */
+    lua_getfield(L, -1, "green"); /* get value.bright_white.green */
+    value.bright_white.green = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.bright_white.green */
+    lua_getfield(L, -1, "blue"); /* get value.bright_white.blue */
+    value.bright_white.blue = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.bright_white.blue */
+    lua_getfield(L, -1, "alpha"); /* get value.bright_white.alpha */
+
+    if (!lua_isnoneornil(L, -1)) {
+      value.bright_white.alpha.set = true;
+      value.bright_white.alpha.value = luaL_checknumber(L, -1);
+    }
+
+    lua_pop(L, 1); /* pop value.bright_white.alpha */
+    lua_pop(L, 1); /* pop value.bright_white */
+    lua_getfield(L, -1, "foreground"); /* get value.foreground */
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "red"); /* get value.foreground.red */
+    value.foreground.red = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.foreground.red */
+    lua_getfield(L, -1, "green"); /* get value.foreground.green */
+    value.foreground.green = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.foreground.green */
+    lua_getfield(L, -1, "blue"); /* get value.foreground.blue */
+    value.foreground.blue = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.foreground.blue */
+    lua_getfield(L, -1, "alpha"); /* get value.foreground.alpha */
+
+    if (!lua_isnoneornil(L, -1)) {
+      value.foreground.alpha.set = true;
+      value.foreground.alpha.value = luaL_checknumber(L, -1);
+    }
+
+    lua_pop(L, 1); /* pop value.foreground.alpha */
+    lua_pop(L, 1); /* pop value.foreground */
+    lua_getfield(L, -1, "background"); /* get value.background */
+    luaL_checktype(L, -1, LUA_TTABLE);
+    lua_getfield(L, -1, "red"); /* get value.background.red */
+    value.background.red = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.background.red */
+    lua_getfield(L, -1, "green"); /* get value.background.green */
+    value.background.green = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.background.green */
+    lua_getfield(L, -1, "blue"); /* get value.background.blue */
+    value.background.blue = luaL_checknumber(L, -1);
+    lua_pop(L, 1); /* pop value.background.blue */
+    lua_getfield(L, -1, "alpha"); /* get value.background.alpha */
+
+    if (!lua_isnoneornil(L, -1)) {
+      value.background.alpha.set = true;
+      value.background.alpha.value = luaL_checknumber(L, -1);
+    }
+
+    lua_pop(L, 1); /* pop value.background.alpha */
+    lua_pop(L, 1); /* pop value.background */
+    lua_getfield(L, -1, "cursor_foreground"); /* get value.cursor_foreground */
+
+    if (!lua_isnoneornil(L, -1)) {
+      value.cursor_foreground.set = true;
+      luaL_checktype(L, -1, LUA_TTABLE);
+      lua_getfield(L, -1, "red"); /* get value.cursor_foreground.value.red */
+      value.cursor_foreground.value.red = luaL_checknumber(L, -1);
+      lua_pop(L, 1); /* pop value.cursor_foreground.value.red */
+      lua_getfield(L, -1, "green"); /* get value.cursor_foreground.value.green */
+      value.cursor_foreground.value.green = luaL_checknumber(L, -1);
+      lua_pop(L, 1); /* pop value.cursor_foreground.value.green */
+      lua_getfield(L, -1, "blue"); /* get value.cursor_foreground.value.blue */
+      value.cursor_foreground.value.blue = luaL_checknumber(L, -1);
+      lua_pop(L, 1); /* pop value.cursor_foreground.value.blue */
+      lua_getfield(L, -1, "alpha"); /* get value.cursor_foreground.value.alpha */
+
+      if (!lua_isnoneornil(L, -1)) {
+        value.cursor_foreground.value.alpha.set = true;
+        value.cursor_foreground.value.alpha.value = luaL_checknumber(L, -1);
+      }
+
+      lua_pop(L, 1); /* pop value.cursor_foreground.value.alpha */
+    }
+
+    lua_pop(L, 1); /* pop value.cursor_foreground */
+    lua_getfield(L, -1, "cursor_background"); /* get value.cursor_background */
+
+    if (!lua_isnoneornil(L, -1)) {
+      value.cursor_background.set = true;
+      luaL_checktype(L, -1, LUA_TTABLE);
+      lua_getfield(L, -1, "red"); /* get value.cursor_background.value.red */
+      value.cursor_background.value.red = luaL_checknumber(L, -1);
+      lua_pop(L, 1); /* pop value.cursor_background.value.red */
+      lua_getfield(L, -1, "green"); /* get value.cursor_background.value.green */
+      value.cursor_background.value.green = luaL_checknumber(L, -1);
+      lua_pop(L, 1); /* pop value.cursor_background.value.green */
+      lua_getfield(L, -1, "blue"); /* get value.cursor_background.value.blue */
+      value.cursor_background.value.blue = luaL_checknumber(L, -1);
+      lua_pop(L, 1); /* pop value.cursor_background.value.blue */
+      lua_getfield(L, -1, "alpha"); /* get value.cursor_background.value.alpha */
+
+      if (!lua_isnoneornil(L, -1)) {
+        value.cursor_background.value.alpha.set = true;
+        value.cursor_background.value.alpha.value = luaL_checknumber(L, -1);
+      }
+
+      lua_pop(L, 1); /* pop value.cursor_background.value.alpha */
+    }
+
+    lua_pop(L, 1); /* pop value.cursor_background */
+    lua_getfield(L, -1, "bold_bright_colors"); /* get value.bold_bright_colors */
+
+    if (!lua_isnoneornil(L, -1)) {
+      value.bold_bright_colors.set = true;
+      value.bold_bright_colors.value = luaL_checkboolean(L, -1);
+    }
+
+    lua_pop(L, 1); /* pop value.bold_bright_colors */
+    lua_pop(L, 1); /* pop pushed table */
+  }
+  vv_api_set_theme(v, value);
+  return 0;
+}
+
+static int l_vv_api_get_fps_target(lua_State *L) {
+  lua_Integer argtop = 0;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int ret = vv_api_get_fps_target(v);
+  lua_pushinteger(L, ret);
+  return 1;
+}
+
+static int l_vv_api_set_fps_target(lua_State *L) {
+  lua_Integer argtop = 1;
+  (void)argtop;
+  struct velvet *v = *(struct velvet **)lua_getextraspace(L);
+  if (v->reloading) {
+    lua_pushstring(L, "vv.api cannot be used after calling reload.");
+    lua_error(L);
+  }
+  v->current = L;
+
+  int value = luaL_checkinteger(L, 1); /* poggies */
+  vv_api_set_fps_target(v, value);
+  return 0;
+}
+
+static const struct luaL_Reg velvet_lua_function_table[] = {
+  { "get_scrollback_scroll_multiplier", l_vv_api_get_scrollback_scroll_multiplier },
+  { "set_scrollback_scroll_multiplier", l_vv_api_set_scrollback_scroll_multiplier },
+  { "get_scrollback_memory_budget", l_vv_api_get_scrollback_memory_budget },
+  { "set_scrollback_memory_budget", l_vv_api_set_scrollback_memory_budget },
+  { "get_left_right_margins", l_vv_api_get_left_right_margins },
+  { "set_left_right_margins", l_vv_api_set_left_right_margins },
+  { "get_repeat_characters", l_vv_api_get_repeat_characters },
+  { "set_repeat_characters", l_vv_api_set_repeat_characters },
+  { "get_theme", l_vv_api_get_theme },
+  { "set_theme", l_vv_api_set_theme },
+  { "get_fps_target", l_vv_api_get_fps_target },
+  { "set_fps_target", l_vv_api_set_fps_target },
+  { "get_screen_geometry", l_vv_api_get_screen_geometry },
+  { "schedule_cancel", l_vv_api_schedule_cancel },
+  { "schedule_after", l_vv_api_schedule_after },
+  { "get_current_tick", l_vv_api_get_current_tick },
+  { "get_clients", l_vv_api_get_clients },
+  { "set_active_client", l_vv_api_set_active_client },
+  { "get_active_client", l_vv_api_get_active_client },
+  { "client_detach", l_vv_api_client_detach },
+  { "client_reattach", l_vv_api_client_reattach },
+  { "client_set_options", l_vv_api_client_set_options },
+  { "quit", l_vv_api_quit },
+  { "reload", l_vv_api_reload },
+  { "get_startup_directory", l_vv_api_get_startup_directory },
+  { "get_mouse_position", l_vv_api_get_mouse_position },
+  { "get_memory_usage", l_vv_api_get_memory_usage },
+  { "get_windows", l_vv_api_get_windows },
+  { "window_set_z_index", l_vv_api_window_set_z_index },
+  { "window_get_z_index", l_vv_api_window_get_z_index },
+  { "window_set_hidden", l_vv_api_window_set_hidden },
+  { "window_get_hidden", l_vv_api_window_get_hidden },
+  { "window_get_alpha", l_vv_api_window_get_alpha },
+  { "window_get_text", l_vv_api_window_get_text },
+  { "window_get_cells", l_vv_api_window_get_cells },
+  { "window_get_mouse_settings", l_vv_api_window_get_mouse_settings },
+  { "window_set_alpha", l_vv_api_window_set_alpha },
+  { "window_get_transparency_mode", l_vv_api_window_get_transparency_mode },
+  { "window_set_transparency_mode", l_vv_api_window_set_transparency_mode },
+  { "window_get_dim_factor", l_vv_api_window_get_dim_factor },
+  { "window_set_dim_factor", l_vv_api_window_set_dim_factor },
+  { "get_focused_window", l_vv_api_get_focused_window },
+  { "set_focused_window", l_vv_api_set_focused_window },
+  { "window_get_geometry", l_vv_api_window_get_geometry },
+  { "window_set_geometry", l_vv_api_window_set_geometry },
+  { "window_close", l_vv_api_window_close },
+  { "window_get_title", l_vv_api_window_get_title },
+  { "window_set_title", l_vv_api_window_set_title },
+  { "window_send_raw_key", l_vv_api_window_send_raw_key },
+  { "window_send_keys", l_vv_api_window_send_keys },
+  { "window_paste_text", l_vv_api_window_paste_text },
+  { "window_send_mouse_move", l_vv_api_window_send_mouse_move },
+  { "window_send_mouse_click", l_vv_api_window_send_mouse_click },
+  { "window_send_mouse_scroll", l_vv_api_window_send_mouse_scroll },
+  { "window_create", l_vv_api_window_create },
+  { "window_create_process", l_vv_api_window_create_process },
+  { "window_get_working_directory", l_vv_api_window_get_working_directory },
+  { "window_get_foreground_process_name", l_vv_api_window_get_foreground_process_name },
+  { "window_get_parent", l_vv_api_window_get_parent },
+  { "window_set_parent", l_vv_api_window_set_parent },
+  { "window_is_lua", l_vv_api_window_is_lua },
+  { "window_is_valid", l_vv_api_window_is_valid },
+  { "window_get_scrollback_size", l_vv_api_window_get_scrollback_size },
+  { "window_get_scrollback_compression", l_vv_api_window_get_scrollback_compression },
+  { "window_get_memory_usage", l_vv_api_window_get_memory_usage },
+  { "window_get_scrollback_mode", l_vv_api_window_get_scrollback_mode },
+  { "window_set_scrollback_mode", l_vv_api_window_set_scrollback_mode },
+  { "window_get_scroll_offset", l_vv_api_window_get_scroll_offset },
+  { "window_set_scroll_offset", l_vv_api_window_set_scroll_offset },
+  { "window_write", l_vv_api_window_write },
+  { "window_set_drawing_color", l_vv_api_window_set_drawing_color },
+  { "window_get_cursor_position", l_vv_api_window_get_cursor_position },
+  { "window_set_cursor_position", l_vv_api_window_set_cursor_position },
+  { "clipboard_set", l_vv_api_clipboard_set },
+  { "string_display_width", l_vv_api_string_display_width },
+  { "string_lower", l_vv_api_string_lower },
+  { "string_upper", l_vv_api_string_upper },
+  { "runtime_store_value", l_vv_api_runtime_store_value },
+  { "runtime_load_value", l_vv_api_runtime_load_value },
+  { "debug_set_display_damage", l_vv_api_debug_set_display_damage },
+  { "get_servernames", l_vv_api_get_servernames },
+  { "get_servername", l_vv_api_get_servername },
+  { "get_processes", l_vv_api_get_processes },
+  { "process_kill", l_vv_api_process_kill },
+  { "process_write_stdin", l_vv_api_process_write_stdin },
+  { "process_close_stdin", l_vv_api_process_close_stdin },
+  { "process_spawn", l_vv_api_process_spawn },
+  { "get_environment", l_vv_api_get_environment },
+  { "get_scrollback_scroll_multiplier", l_vv_api_get_scrollback_scroll_multiplier },
+  { "set_scrollback_scroll_multiplier", l_vv_api_set_scrollback_scroll_multiplier },
+  { "get_scrollback_memory_budget", l_vv_api_get_scrollback_memory_budget },
+  { "set_scrollback_memory_budget", l_vv_api_set_scrollback_memory_budget },
+  { "get_left_right_margins", l_vv_api_get_left_right_margins },
+  { "set_left_right_margins", l_vv_api_set_left_right_margins },
+  { "get_repeat_characters", l_vv_api_get_repeat_characters },
+  { "set_repeat_characters", l_vv_api_set_repeat_characters },
+  { "get_theme", l_vv_api_get_theme },
+  { "set_theme", l_vv_api_set_theme },
+  { "get_fps_target", l_vv_api_get_fps_target },
+  { "set_fps_target", l_vv_api_set_fps_target },
+  {0} /* sentinel */
+};
@@ -0,0 +1,666 @@
+/***************************************************
+************ DO NOT EDIT THIS BY HAND **************
+*** This file was auto generated by generate.lua ****
+***************************************************/
+
+#include "lua.h"
+#include "velvet_api.h"
+#include "velvet_lua.h"
+#include "velvet.h"
+#include "utils.h"
+#include "velvet_enum_converters.c"
+
+void velvet_api_raise_on_key(struct velvet *v, __attribute__((unused)) struct velvet_api_on_key_event_args args) {
+  lua_State *L = v->L;
+  if (!L) return;
+  lua_getglobal(L, "vv");
+  lua_getfield(L, -1, "events");
+  lua_getfield(L, -1, "emit");
+  lua_pushlstring(L, "on_key", 6); /* event name */
+  
+  lua_newtable(L); /* args = new on_key.event_args */
+  lua_newtable(L); /* args.key = new window.key_event */
+  lua_pushinteger(L, args.key.codepoint);
+  lua_setfield(L, -2, "codepoint"); /* args.key.codepoint = codepoint */
+  lua_pushinteger(L, args.key.alternate_codepoint);
+  lua_setfield(L, -2, "alternate_codepoint"); /* args.key.alternate_codepoint = alternate_codepoint */
+  lua_pushslice(L, args.key.name);
+  lua_setfield(L, -2, "name"); /* args.key.name = name */
+  lua_pushslice(L, key_event_type_to_slice(args.key.event_type));
+  lua_setfield(L, -2, "event_type"); /* args.key.event_type = event_type */
+  lua_newtable(L); /* args.key.modifiers = key_modifier flags */
+  if (args.key.modifiers & VELVET_API_KEY_MODIFIER_SHIFT) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_SHIFT));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.key.modifiers & VELVET_API_KEY_MODIFIER_ALT) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_ALT));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.key.modifiers & VELVET_API_KEY_MODIFIER_CONTROL) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_CONTROL));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.key.modifiers & VELVET_API_KEY_MODIFIER_SUPER) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_SUPER));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.key.modifiers & VELVET_API_KEY_MODIFIER_HYPER) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_HYPER));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.key.modifiers & VELVET_API_KEY_MODIFIER_META) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_META));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.key.modifiers & VELVET_API_KEY_MODIFIER_CAPS_LOCK) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_CAPS_LOCK));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.key.modifiers & VELVET_API_KEY_MODIFIER_NUM_LOCK) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_NUM_LOCK));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  lua_setfield(L, -2, "modifiers"); /* args.key.modifiers = modifiers */
+  lua_setfield(L, -2, "key"); /* args.key = key */
+  /* vv.events.emit(args) */
+  if (lua_pcall(L, 2, 0, 0) != LUA_OK) {
+    const char *err = lua_tostring(L, -1);
+    velvet_log("lua emit: %s", err);
+    lua_pop(L, 1);
+  }
+  lua_pop(L, 2);
+}
+void velvet_api_raise_window_created(struct velvet *v, __attribute__((unused)) struct velvet_api_window_created_event_args args) {
+  lua_State *L = v->L;
+  if (!L) return;
+  lua_getglobal(L, "vv");
+  lua_getfield(L, -1, "events");
+  lua_getfield(L, -1, "emit");
+  lua_pushlstring(L, "window_created", 14); /* event name */
+  
+  lua_newtable(L); /* args = new window_created.event_args */
+  lua_pushinteger(L, args.win_id);
+  lua_setfield(L, -2, "win_id"); /* args.win_id = win_id */
+  /* vv.events.emit(args) */
+  if (lua_pcall(L, 2, 0, 0) != LUA_OK) {
+    const char *err = lua_tostring(L, -1);
+    velvet_log("lua emit: %s", err);
+    lua_pop(L, 1);
+  }
+  lua_pop(L, 2);
+}
+void velvet_api_raise_window_closed(struct velvet *v, __attribute__((unused)) struct velvet_api_window_closed_event_args args) {
+  lua_State *L = v->L;
+  if (!L) return;
+  lua_getglobal(L, "vv");
+  lua_getfield(L, -1, "events");
+  lua_getfield(L, -1, "emit");
+  lua_pushlstring(L, "window_closed", 13); /* event name */
+  
+  lua_newtable(L); /* args = new window_closed.event_args */
+  lua_pushinteger(L, args.win_id);
+  lua_setfield(L, -2, "win_id"); /* args.win_id = win_id */
+  /* vv.events.emit(args) */
+  if (lua_pcall(L, 2, 0, 0) != LUA_OK) {
+    const char *err = lua_tostring(L, -1);
+    velvet_log("lua emit: %s", err);
+    lua_pop(L, 1);
+  }
+  lua_pop(L, 2);
+}
+void velvet_api_raise_window_output(struct velvet *v, __attribute__((unused)) struct velvet_api_window_output_event_args args) {
+  lua_State *L = v->L;
+  if (!L) return;
+  lua_getglobal(L, "vv");
+  lua_getfield(L, -1, "events");
+  lua_getfield(L, -1, "emit");
+  lua_pushlstring(L, "window_output", 13); /* event name */
+  
+  lua_newtable(L); /* args = new window_output.event_args */
+  lua_pushinteger(L, args.win_id);
+  lua_setfield(L, -2, "win_id"); /* args.win_id = win_id */
+  /* vv.events.emit(args) */
+  if (lua_pcall(L, 2, 0, 0) != LUA_OK) {
+    const char *err = lua_tostring(L, -1);
+    velvet_log("lua emit: %s", err);
+    lua_pop(L, 1);
+  }
+  lua_pop(L, 2);
+}
+void velvet_api_raise_window_bell(struct velvet *v, __attribute__((unused)) struct velvet_api_window_bell_event_args args) {
+  lua_State *L = v->L;
+  if (!L) return;
+  lua_getglobal(L, "vv");
+  lua_getfield(L, -1, "events");
+  lua_getfield(L, -1, "emit");
+  lua_pushlstring(L, "window_bell", 11); /* event name */
+  
+  lua_newtable(L); /* args = new window_bell.event_args */
+  lua_pushinteger(L, args.win_id);
+  lua_setfield(L, -2, "win_id"); /* args.win_id = win_id */
+  /* vv.events.emit(args) */
+  if (lua_pcall(L, 2, 0, 0) != LUA_OK) {
+    const char *err = lua_tostring(L, -1);
+    velvet_log("lua emit: %s", err);
+    lua_pop(L, 1);
+  }
+  lua_pop(L, 2);
+}
+void velvet_api_raise_window_moved(struct velvet *v, __attribute__((unused)) struct velvet_api_window_moved_event_args args) {
+  lua_State *L = v->L;
+  if (!L) return;
+  lua_getglobal(L, "vv");
+  lua_getfield(L, -1, "events");
+  lua_getfield(L, -1, "emit");
+  lua_pushlstring(L, "window_moved", 12); /* event name */
+  
+  lua_newtable(L); /* args = new window_moved.event_args */
+  lua_pushinteger(L, args.win_id);
+  lua_setfield(L, -2, "win_id"); /* args.win_id = win_id */
+  lua_newtable(L); /* args.old_size = new rect */
+  lua_pushinteger(L, args.old_size.left);
+  lua_setfield(L, -2, "left"); /* args.old_size.left = left */
+  lua_pushinteger(L, args.old_size.top);
+  lua_setfield(L, -2, "top"); /* args.old_size.top = top */
+  lua_pushinteger(L, args.old_size.width);
+  lua_setfield(L, -2, "width"); /* args.old_size.width = width */
+  lua_pushinteger(L, args.old_size.height);
+  lua_setfield(L, -2, "height"); /* args.old_size.height = height */
+  lua_setfield(L, -2, "old_size"); /* args.old_size = old_size */
+  lua_newtable(L); /* args.new_size = new rect */
+  lua_pushinteger(L, args.new_size.left);
+  lua_setfield(L, -2, "left"); /* args.new_size.left = left */
+  lua_pushinteger(L, args.new_size.top);
+  lua_setfield(L, -2, "top"); /* args.new_size.top = top */
+  lua_pushinteger(L, args.new_size.width);
+  lua_setfield(L, -2, "width"); /* args.new_size.width = width */
+  lua_pushinteger(L, args.new_size.height);
+  lua_setfield(L, -2, "height"); /* args.new_size.height = height */
+  lua_setfield(L, -2, "new_size"); /* args.new_size = new_size */
+  /* vv.events.emit(args) */
+  if (lua_pcall(L, 2, 0, 0) != LUA_OK) {
+    const char *err = lua_tostring(L, -1);
+    velvet_log("lua emit: %s", err);
+    lua_pop(L, 1);
+  }
+  lua_pop(L, 2);
+}
+void velvet_api_raise_window_resized(struct velvet *v, __attribute__((unused)) struct velvet_api_window_resized_event_args args) {
+  lua_State *L = v->L;
+  if (!L) return;
+  lua_getglobal(L, "vv");
+  lua_getfield(L, -1, "events");
+  lua_getfield(L, -1, "emit");
+  lua_pushlstring(L, "window_resized", 14); /* event name */
+  
+  lua_newtable(L); /* args = new window_resized.event_args */
+  lua_pushinteger(L, args.win_id);
+  lua_setfield(L, -2, "win_id"); /* args.win_id = win_id */
+  lua_newtable(L); /* args.old_size = new rect */
+  lua_pushinteger(L, args.old_size.left);
+  lua_setfield(L, -2, "left"); /* args.old_size.left = left */
+  lua_pushinteger(L, args.old_size.top);
+  lua_setfield(L, -2, "top"); /* args.old_size.top = top */
+  lua_pushinteger(L, args.old_size.width);
+  lua_setfield(L, -2, "width"); /* args.old_size.width = width */
+  lua_pushinteger(L, args.old_size.height);
+  lua_setfield(L, -2, "height"); /* args.old_size.height = height */
+  lua_setfield(L, -2, "old_size"); /* args.old_size = old_size */
+  lua_newtable(L); /* args.new_size = new rect */
+  lua_pushinteger(L, args.new_size.left);
+  lua_setfield(L, -2, "left"); /* args.new_size.left = left */
+  lua_pushinteger(L, args.new_size.top);
+  lua_setfield(L, -2, "top"); /* args.new_size.top = top */
+  lua_pushinteger(L, args.new_size.width);
+  lua_setfield(L, -2, "width"); /* args.new_size.width = width */
+  lua_pushinteger(L, args.new_size.height);
+  lua_setfield(L, -2, "height"); /* args.new_size.height = height */
+  lua_setfield(L, -2, "new_size"); /* args.new_size = new_size */
+  /* vv.events.emit(args) */
+  if (lua_pcall(L, 2, 0, 0) != LUA_OK) {
+    const char *err = lua_tostring(L, -1);
+    velvet_log("lua emit: %s", err);
+    lua_pop(L, 1);
+  }
+  lua_pop(L, 2);
+}
+void velvet_api_raise_window_on_key(struct velvet *v, __attribute__((unused)) struct velvet_api_window_on_key_event_args args) {
+  lua_State *L = v->L;
+  if (!L) return;
+  lua_getglobal(L, "vv");
+  lua_getfield(L, -1, "events");
+  lua_getfield(L, -1, "emit");
+  lua_pushlstring(L, "window_on_key", 13); /* event name */
+  
+  lua_newtable(L); /* args = new window_on_key.event_args */
+  lua_pushinteger(L, args.win_id);
+  lua_setfield(L, -2, "win_id"); /* args.win_id = win_id */
+  lua_newtable(L); /* args.key = new window.key_event */
+  lua_pushinteger(L, args.key.codepoint);
+  lua_setfield(L, -2, "codepoint"); /* args.key.codepoint = codepoint */
+  lua_pushinteger(L, args.key.alternate_codepoint);
+  lua_setfield(L, -2, "alternate_codepoint"); /* args.key.alternate_codepoint = alternate_codepoint */
+  lua_pushslice(L, args.key.name);
+  lua_setfield(L, -2, "name"); /* args.key.name = name */
+  lua_pushslice(L, key_event_type_to_slice(args.key.event_type));
+  lua_setfield(L, -2, "event_type"); /* args.key.event_type = event_type */
+  lua_newtable(L); /* args.key.modifiers = key_modifier flags */
+  if (args.key.modifiers & VELVET_API_KEY_MODIFIER_SHIFT) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_SHIFT));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.key.modifiers & VELVET_API_KEY_MODIFIER_ALT) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_ALT));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.key.modifiers & VELVET_API_KEY_MODIFIER_CONTROL) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_CONTROL));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.key.modifiers & VELVET_API_KEY_MODIFIER_SUPER) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_SUPER));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.key.modifiers & VELVET_API_KEY_MODIFIER_HYPER) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_HYPER));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.key.modifiers & VELVET_API_KEY_MODIFIER_META) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_META));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.key.modifiers & VELVET_API_KEY_MODIFIER_CAPS_LOCK) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_CAPS_LOCK));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.key.modifiers & VELVET_API_KEY_MODIFIER_NUM_LOCK) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_NUM_LOCK));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  lua_setfield(L, -2, "modifiers"); /* args.key.modifiers = modifiers */
+  lua_setfield(L, -2, "key"); /* args.key = key */
+  /* vv.events.emit(args) */
+  if (lua_pcall(L, 2, 0, 0) != LUA_OK) {
+    const char *err = lua_tostring(L, -1);
+    velvet_log("lua emit: %s", err);
+    lua_pop(L, 1);
+  }
+  lua_pop(L, 2);
+}
+void velvet_api_raise_window_focus_changed(struct velvet *v, __attribute__((unused)) struct velvet_api_window_focus_changed_event_args args) {
+  lua_State *L = v->L;
+  if (!L) return;
+  lua_getglobal(L, "vv");
+  lua_getfield(L, -1, "events");
+  lua_getfield(L, -1, "emit");
+  lua_pushlstring(L, "window_focus_changed", 20); /* event name */
+  
+  lua_newtable(L); /* args = new window_focus_changed.event_args */
+  lua_pushinteger(L, args.old_focus);
+  lua_setfield(L, -2, "old_focus"); /* args.old_focus = old_focus */
+  lua_pushinteger(L, args.new_focus);
+  lua_setfield(L, -2, "new_focus"); /* args.new_focus = new_focus */
+  /* vv.events.emit(args) */
+  if (lua_pcall(L, 2, 0, 0) != LUA_OK) {
+    const char *err = lua_tostring(L, -1);
+    velvet_log("lua emit: %s", err);
+    lua_pop(L, 1);
+  }
+  lua_pop(L, 2);
+}
+void velvet_api_raise_screen_resized(struct velvet *v, __attribute__((unused)) struct velvet_api_screen_resized_event_args args) {
+  lua_State *L = v->L;
+  if (!L) return;
+  lua_getglobal(L, "vv");
+  lua_getfield(L, -1, "events");
+  lua_getfield(L, -1, "emit");
+  lua_pushlstring(L, "screen_resized", 14); /* event name */
+  
+  lua_newtable(L); /* args = new screen_resized.event_args */
+  lua_newtable(L); /* args.old_size = new screen.geometry */
+  lua_pushinteger(L, args.old_size.width);
+  lua_setfield(L, -2, "width"); /* args.old_size.width = width */
+  lua_pushinteger(L, args.old_size.height);
+  lua_setfield(L, -2, "height"); /* args.old_size.height = height */
+  lua_setfield(L, -2, "old_size"); /* args.old_size = old_size */
+  lua_newtable(L); /* args.new_size = new screen.geometry */
+  lua_pushinteger(L, args.new_size.width);
+  lua_setfield(L, -2, "width"); /* args.new_size.width = width */
+  lua_pushinteger(L, args.new_size.height);
+  lua_setfield(L, -2, "height"); /* args.new_size.height = height */
+  lua_setfield(L, -2, "new_size"); /* args.new_size = new_size */
+  /* vv.events.emit(args) */
+  if (lua_pcall(L, 2, 0, 0) != LUA_OK) {
+    const char *err = lua_tostring(L, -1);
+    velvet_log("lua emit: %s", err);
+    lua_pop(L, 1);
+  }
+  lua_pop(L, 2);
+}
+void velvet_api_raise_mouse_move(struct velvet *v, __attribute__((unused)) struct velvet_api_mouse_move_event_args args) {
+  lua_State *L = v->L;
+  if (!L) return;
+  lua_getglobal(L, "vv");
+  lua_getfield(L, -1, "events");
+  lua_getfield(L, -1, "emit");
+  lua_pushlstring(L, "mouse_move", 10); /* event name */
+  
+  lua_newtable(L); /* args = new mouse_move.event_args */
+  lua_pushinteger(L, args.win_id);
+  lua_setfield(L, -2, "win_id"); /* args.win_id = win_id */
+  lua_newtable(L); /* args.pos = new coordinate */
+  lua_pushinteger(L, args.pos.row);
+  lua_setfield(L, -2, "row"); /* args.pos.row = row */
+  lua_pushinteger(L, args.pos.col);
+  lua_setfield(L, -2, "col"); /* args.pos.col = col */
+  lua_setfield(L, -2, "pos"); /* args.pos = pos */
+  lua_pushslice(L, mouse_button_to_slice(args.mouse_button));
+  lua_setfield(L, -2, "mouse_button"); /* args.mouse_button = mouse_button */
+  lua_newtable(L); /* args.modifiers = key_modifier flags */
+  if (args.modifiers & VELVET_API_KEY_MODIFIER_SHIFT) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_SHIFT));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.modifiers & VELVET_API_KEY_MODIFIER_ALT) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_ALT));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.modifiers & VELVET_API_KEY_MODIFIER_CONTROL) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_CONTROL));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.modifiers & VELVET_API_KEY_MODIFIER_SUPER) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_SUPER));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.modifiers & VELVET_API_KEY_MODIFIER_HYPER) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_HYPER));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.modifiers & VELVET_API_KEY_MODIFIER_META) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_META));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.modifiers & VELVET_API_KEY_MODIFIER_CAPS_LOCK) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_CAPS_LOCK));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.modifiers & VELVET_API_KEY_MODIFIER_NUM_LOCK) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_NUM_LOCK));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  lua_setfield(L, -2, "modifiers"); /* args.modifiers = modifiers */
+  /* vv.events.emit(args) */
+  if (lua_pcall(L, 2, 0, 0) != LUA_OK) {
+    const char *err = lua_tostring(L, -1);
+    velvet_log("lua emit: %s", err);
+    lua_pop(L, 1);
+  }
+  lua_pop(L, 2);
+}
+void velvet_api_raise_mouse_click(struct velvet *v, __attribute__((unused)) struct velvet_api_mouse_click_event_args args) {
+  lua_State *L = v->L;
+  if (!L) return;
+  lua_getglobal(L, "vv");
+  lua_getfield(L, -1, "events");
+  lua_getfield(L, -1, "emit");
+  lua_pushlstring(L, "mouse_click", 11); /* event name */
+  
+  lua_newtable(L); /* args = new mouse_click.event_args */
+  lua_pushinteger(L, args.win_id);
+  lua_setfield(L, -2, "win_id"); /* args.win_id = win_id */
+  lua_newtable(L); /* args.pos = new coordinate */
+  lua_pushinteger(L, args.pos.row);
+  lua_setfield(L, -2, "row"); /* args.pos.row = row */
+  lua_pushinteger(L, args.pos.col);
+  lua_setfield(L, -2, "col"); /* args.pos.col = col */
+  lua_setfield(L, -2, "pos"); /* args.pos = pos */
+  lua_pushslice(L, mouse_button_to_slice(args.mouse_button));
+  lua_setfield(L, -2, "mouse_button"); /* args.mouse_button = mouse_button */
+  lua_pushslice(L, mouse_event_type_to_slice(args.event_type));
+  lua_setfield(L, -2, "event_type"); /* args.event_type = event_type */
+  lua_newtable(L); /* args.modifiers = key_modifier flags */
+  if (args.modifiers & VELVET_API_KEY_MODIFIER_SHIFT) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_SHIFT));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.modifiers & VELVET_API_KEY_MODIFIER_ALT) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_ALT));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.modifiers & VELVET_API_KEY_MODIFIER_CONTROL) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_CONTROL));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.modifiers & VELVET_API_KEY_MODIFIER_SUPER) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_SUPER));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.modifiers & VELVET_API_KEY_MODIFIER_HYPER) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_HYPER));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.modifiers & VELVET_API_KEY_MODIFIER_META) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_META));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.modifiers & VELVET_API_KEY_MODIFIER_CAPS_LOCK) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_CAPS_LOCK));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.modifiers & VELVET_API_KEY_MODIFIER_NUM_LOCK) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_NUM_LOCK));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  lua_setfield(L, -2, "modifiers"); /* args.modifiers = modifiers */
+  /* vv.events.emit(args) */
+  if (lua_pcall(L, 2, 0, 0) != LUA_OK) {
+    const char *err = lua_tostring(L, -1);
+    velvet_log("lua emit: %s", err);
+    lua_pop(L, 1);
+  }
+  lua_pop(L, 2);
+}
+void velvet_api_raise_mouse_scroll(struct velvet *v, __attribute__((unused)) struct velvet_api_mouse_scroll_event_args args) {
+  lua_State *L = v->L;
+  if (!L) return;
+  lua_getglobal(L, "vv");
+  lua_getfield(L, -1, "events");
+  lua_getfield(L, -1, "emit");
+  lua_pushlstring(L, "mouse_scroll", 12); /* event name */
+  
+  lua_newtable(L); /* args = new mouse_scroll.event_args */
+  lua_pushinteger(L, args.win_id);
+  lua_setfield(L, -2, "win_id"); /* args.win_id = win_id */
+  lua_newtable(L); /* args.pos = new coordinate */
+  lua_pushinteger(L, args.pos.row);
+  lua_setfield(L, -2, "row"); /* args.pos.row = row */
+  lua_pushinteger(L, args.pos.col);
+  lua_setfield(L, -2, "col"); /* args.pos.col = col */
+  lua_setfield(L, -2, "pos"); /* args.pos = pos */
+  lua_pushslice(L, scroll_direction_to_slice(args.direction));
+  lua_setfield(L, -2, "direction"); /* args.direction = direction */
+  lua_newtable(L); /* args.modifiers = key_modifier flags */
+  if (args.modifiers & VELVET_API_KEY_MODIFIER_SHIFT) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_SHIFT));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.modifiers & VELVET_API_KEY_MODIFIER_ALT) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_ALT));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.modifiers & VELVET_API_KEY_MODIFIER_CONTROL) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_CONTROL));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.modifiers & VELVET_API_KEY_MODIFIER_SUPER) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_SUPER));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.modifiers & VELVET_API_KEY_MODIFIER_HYPER) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_HYPER));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.modifiers & VELVET_API_KEY_MODIFIER_META) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_META));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.modifiers & VELVET_API_KEY_MODIFIER_CAPS_LOCK) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_CAPS_LOCK));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  if (args.modifiers & VELVET_API_KEY_MODIFIER_NUM_LOCK) {
+    lua_pushslice(L, key_modifier_to_slice(VELVET_API_KEY_MODIFIER_NUM_LOCK));
+    lua_pushboolean(L, true);
+    lua_settable(L, -3);
+  }
+
+  lua_setfield(L, -2, "modifiers"); /* args.modifiers = modifiers */
+  /* vv.events.emit(args) */
+  if (lua_pcall(L, 2, 0, 0) != LUA_OK) {
+    const char *err = lua_tostring(L, -1);
+    velvet_log("lua emit: %s", err);
+    lua_pop(L, 1);
+  }
+  lua_pop(L, 2);
+}
+void velvet_api_raise_system_message(struct velvet *v, __attribute__((unused)) struct velvet_api_system_message_event_args args) {
+  lua_State *L = v->L;
+  if (!L) return;
+  lua_getglobal(L, "vv");
+  lua_getfield(L, -1, "events");
+  lua_getfield(L, -1, "emit");
+  lua_pushlstring(L, "system_message", 14); /* event name */
+  
+  lua_newtable(L); /* args = new system_message.event_args */
+  lua_pushslice(L, args.message);
+  lua_setfield(L, -2, "message"); /* args.message = message */
+  lua_pushslice(L, severity_to_slice(args.level));
+  lua_setfield(L, -2, "level"); /* args.level = level */
+  /* vv.events.emit(args) */
+  if (lua_pcall(L, 2, 0, 0) != LUA_OK) {
+    const char *err = lua_tostring(L, -1);
+    velvet_log("lua emit: %s", err);
+    lua_pop(L, 1);
+  }
+  lua_pop(L, 2);
+}
+void velvet_api_raise_pre_render(struct velvet *v, __attribute__((unused)) struct velvet_api_pre_render_event_args args) {
+  lua_State *L = v->L;
+  if (!L) return;
+  lua_getglobal(L, "vv");
+  lua_getfield(L, -1, "events");
+  lua_getfield(L, -1, "emit");
+  lua_pushlstring(L, "pre_render", 10); /* event name */
+  
+  lua_newtable(L); /* args = new pre_render.event_args */
+  lua_pushinteger(L, args.time);
+  lua_setfield(L, -2, "time"); /* args.time = time */
+  lua_pushslice(L, args.cause);
+  lua_setfield(L, -2, "cause"); /* args.cause = cause */
+  /* vv.events.emit(args) */
+  if (lua_pcall(L, 2, 0, 0) != LUA_OK) {
+    const char *err = lua_tostring(L, -1);
+    velvet_log("lua emit: %s", err);
+    lua_pop(L, 1);
+  }
+  lua_pop(L, 2);
+}
+void velvet_api_raise_pre_reload(struct velvet *v, __attribute__((unused)) struct velvet_api_pre_reload_event_args args) {
+  lua_State *L = v->L;
+  if (!L) return;
+  lua_getglobal(L, "vv");
+  lua_getfield(L, -1, "events");
+  lua_getfield(L, -1, "emit");
+  lua_pushlstring(L, "pre_reload", 10); /* event name */
+  
+  lua_newtable(L); /* args = new pre_reload.event_args */
+  lua_pushinteger(L, args.time);
+  lua_setfield(L, -2, "time"); /* args.time = time */
+  /* vv.events.emit(args) */
+  if (lua_pcall(L, 2, 0, 0) != LUA_OK) {
+    const char *err = lua_tostring(L, -1);
+    velvet_log("lua emit: %s", err);
+    lua_pop(L, 1);
+  }
+  lua_pop(L, 2);
+}
@@ -0,0 +1,221 @@
+/* generated by cmd/gen_vte_table.c -- do not edit. */
+/* { action, next state } */
+
+const struct vte_transition vte_transitions[VTE_STATE_LAST][256] = {
+  [0] = {
+    {2,0}, {2,0}, {2,0}, {2,0}, {2,0}, {2,0}, {2,0}, {2,0}, {2,0}, {2,0}, {2,0}, {2,0}, {2,0}, {2,0}, {2,0}, {2,0},
+    {2,0}, {2,0}, {2,0}, {2,0}, {2,0}, {2,0}, {2,0}, {2,0}, {2,0}, {2,0}, {2,0}, {4,2}, {2,0}, {2,0}, {2,0}, {2,0},
+    {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0},
+    {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0},
+    {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0},
+    {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0},
+    {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0},
+    {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {0,0},
+    {1,0}, {1,0}, {1,0}, {1,0}, {5,0}, {5,0}, {1,0}, {1,0}, {5,0}, {1,0}, {1,0}, {1,0}, {1,0}, {5,0}, {5,0}, {5,0},
+    {10,5}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {5,0}, {5,0}, {5,0}, {1,0}, {5,0}, {7,3}, {5,0}, {10,4}, {5,0}, {10,9},
+    {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0},
+    {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0},
+    {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0},
+    {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0},
+    {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0},
+    {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0}, {1,0},
+  },
+  [1] = {
+    {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1},
+    {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1},
+    {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1},
+    {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1},
+    {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1},
+    {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1},
+    {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1},
+    {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1},
+    {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1},
+    {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1},
+    {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1},
+    {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1},
+    {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1},
+    {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1},
+    {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1},
+    {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1}, {3,1},
+  },
+  [2] = {
+    {2,2}, {2,2}, {2,2}, {2,2}, {2,2}, {2,2}, {2,2}, {2,2}, {2,2}, {2,2}, {2,2}, {2,2}, {2,2}, {2,2}, {2,2}, {2,2},
+    {2,2}, {2,2}, {2,2}, {2,2}, {2,2}, {2,2}, {2,2}, {2,2}, {0,0}, {2,2}, {0,0}, {4,2}, {2,2}, {2,2}, {2,2}, {2,2},
+    {6,7}, {5,0}, {5,0}, {6,6}, {5,0}, {6,8}, {5,0}, {5,0}, {6,10}, {6,10}, {6,10}, {6,10}, {5,0}, {6,10}, {6,10}, {6,10},
+    {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0},
+    {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0},
+    {10,5}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {7,3}, {5,0}, {10,4}, {5,0}, {10,9},
+    {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0},
+    {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {0,2},
+    {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0},
+    {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0},
+    {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0},
+    {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0},
+    {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0},
+    {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0},
+    {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0},
+    {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0}, {5,0},
+  },
+  [3] = {
+    {2,3}, {2,3}, {2,3}, {2,3}, {2,3}, {2,3}, {2,3}, {2,3}, {2,3}, {2,3}, {2,3}, {2,3}, {2,3}, {2,3}, {2,3}, {2,3},
+    {2,3}, {2,3}, {2,3}, {2,3}, {2,3}, {2,3}, {2,3}, {2,3}, {0,0}, {2,3}, {0,0}, {4,2}, {2,3}, {2,3}, {2,3}, {2,3},
+    {8,3}, {8,3}, {8,3}, {8,3}, {8,3}, {8,3}, {8,3}, {8,3}, {8,3}, {8,3}, {8,3}, {8,3}, {8,3}, {8,3}, {8,3}, {8,3},
+    {8,3}, {8,3}, {8,3}, {8,3}, {8,3}, {8,3}, {8,3}, {8,3}, {8,3}, {8,3}, {8,3}, {8,3}, {8,3}, {8,3}, {8,3}, {8,3},
+    {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0},
+    {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0},
+    {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0},
+    {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {9,0}, {0,3},
+    {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3},
+    {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3},
+    {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3},
+    {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3},
+    {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3},
+    {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3},
+    {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3},
+    {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3}, {0,3},
+  },
+  [4] = {
+    {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4},
+    {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4},
+    {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4},
+    {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4},
+    {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4},
+    {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4},
+    {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4},
+    {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4},
+    {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4},
+    {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4},
+    {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4},
+    {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4},
+    {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4},
+    {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4},
+    {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4},
+    {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4}, {11,4},
+  },
+  [5] = {
+    {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5},
+    {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5},
+    {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5},
+    {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5},
+    {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5},
+    {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5},
+    {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5},
+    {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5},
+    {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5},
+    {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5},
+    {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5},
+    {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5},
+    {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5},
+    {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5},
+    {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5},
+    {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5}, {12,5},
+  },
+  [6] = {
+    {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0},
+    {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0},
+    {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0},
+    {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0},
+    {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0},
+    {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0},
+    {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0},
+    {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0},
+    {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0},
+    {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0},
+    {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0},
+    {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0},
+    {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0},
+    {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0},
+    {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0},
+    {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0}, {14,0},
+  },
+  [7] = {
+    {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0},
+    {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0},
+    {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0},
+    {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0},
+    {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0},
+    {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0},
+    {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0},
+    {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0},
+    {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0},
+    {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0},
+    {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0},
+    {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0},
+    {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0},
+    {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0},
+    {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0},
+    {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0}, {15,0},
+  },
+  [8] = {
+    {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0},
+    {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0},
+    {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0},
+    {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0},
+    {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0},
+    {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0},
+    {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0},
+    {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0},
+    {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0},
+    {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0},
+    {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0},
+    {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0},
+    {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0},
+    {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0},
+    {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0},
+    {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0}, {16,0},
+  },
+  [9] = {
+    {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9},
+    {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9},
+    {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9},
+    {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9},
+    {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9},
+    {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9},
+    {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9},
+    {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9},
+    {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9},
+    {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9},
+    {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9},
+    {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9},
+    {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9},
+    {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9},
+    {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9},
+    {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9}, {13,9},
+  },
+  [10] = {
+    {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0},
+    {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0},
+    {17,0}, {17,0}, {17,10}, {17,0}, {17,0}, {17,10}, {17,10}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0},
+    {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0},
+    {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0},
+    {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0},
+    {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0},
+    {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0},
+    {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0},
+    {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0},
+    {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0},
+    {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0},
+    {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0},
+    {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0},
+    {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0},
+    {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0}, {17,0},
+  },
+  [11] = {
+    {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11},
+    {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11},
+    {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11},
+    {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11},
+    {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11},
+    {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11},
+    {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11},
+    {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11},
+    {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11},
+    {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11},
+    {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11},
+    {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11},
+    {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11},
+    {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11},
+    {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11},
+    {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11}, {18,11},
+  },
+};
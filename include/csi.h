@@ -2,8 +2,9 @@
 #define CSI_H
 
 #include <stdint.h>
-#include "vte.h"
-#define CSI_MAX_PARAMS 16
+#include <stdbool.h>
+#include "collections.h"
+#define CSI_MAX_PARAMS 32
 
 enum csi_vte_state {
   CSI_GROUND,
@@ -27,9 +28,18 @@ struct csi {
   uint8_t prefix;
   uint8_t intermediate;
   uint8_t final;
+  /* incremental parser state for the value currently being read */
+  bool negative;
+  uint8_t digits;
 };
 
+struct vte;
 int csi_parse(struct csi *c, struct u8_slice str);
+/* incremental parsing: reset |c|, push parameter, prefix and intermediate bytes as they
+ * arrive, and finish the sequence with the final byte. */
+void csi_reset(struct csi *c);
+void csi_push(struct csi *c, uint8_t ch);
+void csi_finish(struct csi *c, uint8_t final);
 bool csi_dispatch(struct vte *vte, struct csi *csi);
 
 #endif /*  CSI_H */
@@ -0,0 +1,93 @@
+#ifndef GRAPHEME_H
+#define GRAPHEME_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "collections.h"
+#include "text.h"
+#include "utf8proc/utf8proc.h"
+
+/* Grapheme clusters consisting of more than one codepoint are interned in a grapheme_store and
+ * referenced from screen cells by a handle which replaces the codepoint. Handles have GRAPHEME_HANDLE set,
+ * which is outside of the unicode range but fits in struct codepoint, so cells holding a single codepoint
+ * never touch the store. */
+#define GRAPHEME_HANDLE 0x40000000u
+/* codepoints beyond this length are dropped from a cluster */
+#define GRAPHEME_MAX_LENGTH 16
+/* the number of distinct clusters a store can hold. When the store is full and no clusters can be
+ * reclaimed with grapheme_store_sweep, new clusters are truncated to their first codepoint. */
+#define GRAPHEME_STORE_CAPACITY (1 << 16)
+
+#define GRAPHEME_ZWJ 0x200D
+#define GRAPHEME_VS16 0xFE0F
+
+struct grapheme {
+  uint32_t offset;
+  uint32_t len;
+  uint32_t hash;
+};
+
+struct grapheme_store {
+  uint32_t *codepoints;
+  uint32_t n_codepoints, codepoints_capacity;
+  struct grapheme *clusters;
+  uint32_t n_clusters, clusters_capacity;
+  /* open addressing hash table of cluster index + 1 */
+  uint32_t *index;
+  uint32_t index_capacity;
+  /* ids reclaimed by grapheme_store_sweep. They are reused before the store grows. */
+  uint32_t *free;
+  uint32_t n_free;
+  /* the number of clusters interned since the last sweep */
+  uint32_t interned;
+};
+
+static inline bool grapheme_is_handle(uint32_t value) {
+  return value & GRAPHEME_HANDLE;
+}
+
+/* set used[id] for the cluster referenced by the cell value |value|.
+ * |used| holds GRAPHEME_STORE_CAPACITY entries. */
+static inline void grapheme_mark(uint8_t *used, uint32_t value) {
+  if (grapheme_is_handle(value)) used[(value & ~GRAPHEME_HANDLE) % GRAPHEME_STORE_CAPACITY] = 1;
+}
+
+static inline bool grapheme_is_regional_indicator(uint32_t cp) {
+  return cp - 0x1F1E6u < 26;
+}
+
+/* Extend and SpacingMark from UAX #29, approximated by the properties in the unicode table:
+ * zero width codepoints (combining marks, ZWJ, variation selectors, tags), spacing marks and emoji modifiers. */
+static inline bool grapheme_is_extend(uint32_t cp) {
+  uint8_t props = unicode_props(cp);
+  return (props & 3) == 0 || ((props >> 2) & 0x1F) == UTF8PROC_CATEGORY_MC || cp - 0x1F3FBu < 5;
+}
+
+/* cheap test for the parser fast path. Returns false if |cp| certainly starts a new cluster
+ * after the cell value |previous|. Otherwise grapheme_extends must be consulted. */
+static inline bool grapheme_may_extend(uint32_t previous, uint32_t cp) {
+  return grapheme_is_handle(previous) || grapheme_is_regional_indicator(cp) || grapheme_is_extend(cp);
+}
+
+/* returns true if |cp| continues the cluster stored in the cell value |value| */
+bool grapheme_extends(const struct grapheme_store *s, uint32_t value, uint32_t cp);
+/* display width of a cluster. This is the width of the first codepoint, except that
+ * emoji presentation selectors and flags are always wide. */
+int grapheme_width(const uint32_t *cluster, int n);
+
+/* returns a cell value for the cluster |cluster|. Single codepoints are returned as-is. */
+uint32_t grapheme_store_intern(struct grapheme_store *s, const uint32_t *cluster, int n);
+/* copies the codepoints of the cell value |value| to |cluster| and returns the count */
+int grapheme_store_get(const struct grapheme_store *s, uint32_t value, uint32_t cluster[GRAPHEME_MAX_LENGTH]);
+/* intern the cell value |value| from |src| in |dst| */
+uint32_t grapheme_store_copy(struct grapheme_store *dst, const struct grapheme_store *src, uint32_t value);
+bool grapheme_store_full(const struct grapheme_store *s);
+/* reclaim the clusters for which |used| is not set. Handles of the remaining clusters stay valid. */
+void grapheme_store_sweep(struct grapheme_store *s, const uint8_t *used);
+/* append the utf8 encoding of the cell value |value| to |str| */
+void string_push_grapheme(struct string *str, const struct grapheme_store *s, uint32_t value);
+/* forget all clusters. Existing handles are invalidated. */
+void grapheme_store_clear(struct grapheme_store *s);
+void grapheme_store_destroy(struct grapheme_store *s);
+
+#endif /* GRAPHEME_H */
@@ -0,0 +1,63 @@
+#ifndef LINE_ARENA_H
+#define LINE_ARENA_H
+
+#include "screen.h"
+
+/* Recent scrollback lines. Lines are trimmed to their significant cells and stored back to back in chunks;
+ * the trailing cells of a line are implied by its fill cell. Lines are appended when they scroll out of the
+ * viewport and removed oldest first, so chunks are released in the order they were filled. */
+#define LINE_ARENA_CHUNK_CELLS 16384
+/* the number of lines which can be expanded to full width at the same time */
+#define LINE_ARENA_EXPANDED_LINES 4
+
+struct line_arena_chunk {
+  struct line_arena_chunk *next;
+  int capacity, used;
+  /* the number of lines stored in this chunk */
+  int live;
+  struct screen_cell cells[];
+};
+
+struct line_record {
+  struct line_arena_chunk *chunk;
+  int offset, len;
+  int eol;
+  bool has_newline;
+  /* the cell repeated after the stored cells */
+  struct screen_cell fill;
+};
+
+struct line_arena {
+  int w;
+  /* ring buffer of lines. records[first] is the oldest line. */
+  struct line_record *records;
+  int capacity, first, n_lines;
+  /* chunks from oldest to newest. New lines are stored in |newest|. */
+  struct line_arena_chunk *oldest, *newest;
+  /* a released chunk kept for reuse */
+  struct line_arena_chunk *spare;
+  /* the number of stored cells */
+  size_t n_cells;
+  struct screen_line expanded[LINE_ARENA_EXPANDED_LINES];
+  struct screen_cell *expanded_cells;
+  int next_expanded;
+};
+
+struct line_arena *line_arena_create(int w);
+void line_arena_destroy(struct line_arena *a);
+/* append |line| as the newest line */
+void line_arena_push(struct line_arena *a, const struct screen_line *line);
+/* drop the |n| oldest lines */
+void line_arena_drop_oldest(struct line_arena *a, int n);
+void line_arena_clear(struct line_arena *a);
+/* the |n|th line counting from the oldest line, expanded to full width. The expansion is only valid
+ * until LINE_ARENA_EXPANDED_LINES more lines have been expanded. */
+struct screen_line *line_arena_get(struct line_arena *a, int n);
+/* set used[id] for every style id referenced by a stored line */
+void line_arena_mark_styles(const struct line_arena *a, uint8_t *used);
+/* mark every grapheme cluster referenced by a stored line with grapheme_mark */
+void line_arena_mark_graphemes(const struct line_arena *a, uint8_t *used);
+/* set used[id] for every hyperlink id referenced by a stored line */
+void line_arena_mark_links(const struct line_arena *a, uint8_t *used);
+
+#endif /* LINE_ARENA_H */
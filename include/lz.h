@@ -0,0 +1,29 @@
+#ifndef LZ_H
+#define LZ_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* A small LZ77 byte compressor in the spirit of LZ4. It favors speed over ratio, which suits
+ * terminal history: it is highly repetitive and is compressed once but may be read many times.
+ *
+ * The stream is a sequence of tokens. The high nibble of a token is the literal count and the low
+ * nibble is the match length minus LZ_MIN_MATCH; a nibble of 15 is extended by bytes of 255 and a final byte < 255.
+ * The literals follow the token, followed by a 16 bit little endian match offset. The final token has no match.
+ */
+#define LZ_MIN_MATCH 4
+
+/* the worst case size of the compressed form of |len| bytes */
+static inline size_t lz_compress_bound(size_t len) {
+  return len + len / 255 + 16;
+}
+
+/* compress |len| bytes from |src| into |dst|, which must hold lz_compress_bound(len) bytes.
+ * Returns the compressed size. */
+size_t lz_compress(const uint8_t *src, size_t len, uint8_t *dst);
+/* decompress |len| bytes from |src| into |dst|. Returns false unless the stream is well formed
+ * and decompresses to exactly |dst_len| bytes. */
+bool lz_decompress(const uint8_t *src, size_t len, uint8_t *dst, size_t dst_len);
+
+#endif /* LZ_H */
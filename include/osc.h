@@ -44,6 +44,9 @@ struct osc_hyperlink {
   int owner;
 };
 typedef struct osc_hyperlink* hyperlink_handle;
+/* cells reference hyperlinks by their index + 1 in the links of their emulator. 0 means no link. */
+typedef uint16_t hyperlink_id;
+#define HYPERLINK_ID_MAX UINT16_MAX
 
 struct osc {
   enum osc_vte_state state;
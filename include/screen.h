@@ -5,6 +5,7 @@
 #include "collections.h"
 #include "osc.h"
 #include "velvet_api.h"
+#include <limits.h>
 
 enum __attribute((packed)) cell_attributes {
   ATTR_NONE = 0,
@@ -62,10 +63,34 @@ struct screen_cell_style {
 
 static const struct screen_cell_style style_default = {0};
 
+/* index of a style in the style table of a screen. 0 is the default style. */
+typedef uint16_t style_id;
+#define STYLE_ID_MAX UINT16_MAX
+
+/* Styles are interned so cells can reference them by a 16 bit id. Ids are not reference counted
+ * on every cell write; instead, when the table runs out of ids, styles which are no longer used by
+ * any cell of the screen are reclaimed in a single sweep. */
+struct screen_style_table {
+  /* indexed by style_id. styles[0] is unused since the default style is implicit. */
+  struct screen_cell_style *styles;
+  uint32_t n_styles, capacity;
+  /* ids reclaimed by the last sweep */
+  style_id *free;
+  uint32_t n_free;
+  /* open addressing hash table of style ids. 0 marks an empty slot. */
+  style_id *index;
+  uint32_t index_capacity;
+  /* the most recently interned style. Consecutive writes usually share a style. */
+  struct screen_cell_style last;
+  style_id last_id;
+};
+
+/* 8 bytes. Styles, hyperlinks and grapheme clusters are stored out of line and referenced by id. */
 struct screen_cell {
+  /* multi-codepoint grapheme clusters are stored as a handle into the emulator's grapheme_store */
   struct codepoint cp;
-  struct screen_cell_style style;
-  hyperlink_handle link;
+  style_id style;
+  hyperlink_id link;
 };
 
 struct screen_line {
@@ -75,8 +100,18 @@ struct screen_line {
   // reflowing when resizing screens.
   int eol;
   struct screen_cell *cells;
+  /* the value of screen_generation when the line was last modified */
+  uint64_t generation;
 };
 
+/* incremented whenever a line is modified. The counter is shared by all screens, so a line is never considered
+ * unchanged because it belongs to a different screen than a line it replaced. */
+extern uint64_t screen_generation;
+
+static inline void screen_line_touch(struct screen_line *l) {
+  l->generation = ++screen_generation;
+}
+
 // 0-indexed screen coordinates. This cursor points at a raw cell
 struct cursor {
   int column, line;
@@ -95,6 +130,33 @@ struct cursor {
 };
 
 
+/* the number of recent scrollback lines kept in a line arena. Older lines are moved to a compressed scrollback archive. */
+#define SCREEN_HOT_LINES 1024
+/* the scrollback limit when the scrollback is spilled to disk */
+#define SCREEN_SCROLLBACK_UNLIMITED (INT_MAX / 2)
+
+/* a logical line of the scrollback: consecutive lines joined by soft wraps */
+struct logical_line {
+  /* the number of significant cells */
+  uint32_t cells;
+  /* the number of lines it occupies in the line arena and archive. Unused for inherited lines. */
+  uint32_t rows;
+};
+
+struct scrollback;
+struct line_arena;
+
+/* heap memory used by a screen, in bytes */
+struct screen_memory {
+  /* the cells of the grid and of the recent scrollback lines */
+  size_t cells;
+  /* grid lines, scrollback line records and the logical line index */
+  size_t lines;
+  size_t styles;
+  /* the compressed scrollback archive. Blocks spilled to disk are not included. */
+  size_t scrollback;
+};
+
 struct screen {
   /* physical dimensions of the screen */
   int w, h;
@@ -102,38 +164,85 @@ struct screen {
   struct {
     int top, bottom;
   } margins;
+  /* scrolling a region rotates its rows instead of moving them. Row n of the region top..bottom is stored
+   * in the slot of row top + (n - top + rotation.n) % (bottom - top + 1). */
+  struct {
+    int top, bottom, n;
+  } rotation;
   struct {
     /* the maximum scrollback size (#lines) */
     int max;
-    /* the currently allocated size (#lines) */
-    int capacity;
-    /* the number of lines in the scroll buffer */
-    int height; /* 0 <= height < buffer.lines */
-    /* current line is buffer.lines[(scroll.offset + cursor.line) % buffer.lines] */
-    int offset; /* 0 <= offset < buffer.lines */
-    /* view_offset specifies the first visible line in the final render;
-     * The first visible line is buffer.lines[(buffer.lines + scroll.offset + cursor.line - view_offset) % buffer.lines]
+    /* the number of lines in the scrollback */
+    int height; /* 0 <= height <= max */
+    /* the number of lines scrolled so far. Line n of the screen is lines[(scroll.offset + n) % h], subject to |rotation| */
+    int offset;
+    /* view_offset specifies the first visible line in the final render.
+     * The first visible line is screen_get_line(g, -view_offset).
      */
     int view_offset; /* 0 <= view_offset <= height */
+    /* if set, archived scrollback lines are spilled to a memory-mapped file */
+    bool spill;
   } scroll;
+  /* ring of the h lines of the screen */
   struct screen_cell *cells;
   struct screen_line *lines;
   struct cursor cursor;
   struct cursor saved_cursor;
+  struct screen_style_table styles;
+  /* the SCREEN_HOT_LINES most recent scrollback lines, trimmed. Allocated on demand. */
+  struct line_arena *history;
+  /* older scrollback lines. Allocated on demand. */
+  struct scrollback *archive;
+  /* the logical lines of the scrollback, oldest first. The height of the scrollback at another width
+   * follows from the index, so resizing does not need to re-wrap lines which are not visible. */
+  struct {
+    struct logical_line *lines;
+    int capacity, first, n;
+    /* set if the newest logical line continues on the next line */
+    bool open;
+  } index;
+  /* scrollback inherited from a screen of another width which has not been re-wrapped yet.
+   * It precedes the lines in |history| and |archive|. It is re-wrapped newest first, a block of lines at a time,
+   * as it is read. */
+  struct {
+    /* the screen which stores the lines */
+    struct screen *src;
+    /* the number of logical lines of |src| which belong to this screen. They are the first entries of |index|. */
+    int n_lines;
+    /* their height at the width of this screen */
+    int height;
+    /* the number of cells dropped from the start of the first logical line */
+    int skip;
+    /* re-wrapped lines which do not fill an archive block yet. They precede the lines in |archive|. */
+    struct line_arena *wrapped;
+  } reflow;
 };
 
-void screen_insert_ascii_run(struct screen *g, struct screen_cell_style brush, struct u8_slice run, bool wrap, hyperlink_handle link);
+void screen_insert_ascii_run(struct screen *g, style_id style, struct u8_slice run, bool wrap, hyperlink_id link);
+void screen_insert_run(struct screen *g, style_id style, const struct codepoint *run, int n, bool wrap, hyperlink_id link);
 void screen_move_or_scroll_down(struct screen *g);
 void screen_move_or_scroll_up(struct screen *g);
 void screen_backspace(struct screen *g);
 void screen_carriage_return(struct screen *g);
 void screen_destroy(struct screen *screen);
 void screen_erase_rectangle(struct screen *g, int top, int left, int bottom, int right);
+/* set the cells of the rectangle top..bottom, left..right (inclusive) to |c| */
+void screen_fill_rectangle(struct screen *g, int top, int left, int bottom, int right, struct screen_cell c);
+/* copy the cells of the rectangle top..bottom, left..right (inclusive) to |dst_top|, |dst_left|.
+ * The rectangles may overlap. The part which does not fit at the destination is not copied. */
+void screen_copy_rectangle(struct screen *g, int top, int left, int bottom, int right, int dst_top, int dst_left);
 void screen_erase_between_cursors(struct screen *g, struct cursor from,
                                 struct cursor to);
 void screen_full_reset(struct screen *g);
 void screen_initialize(struct screen *g, int w, int h);
 void screen_insert(struct screen *g, struct screen_cell c, bool wrap);
+/* insert |c| |n| times. Equivalent to calling screen_insert |n| times. */
+void screen_insert_repeated(struct screen *g, struct screen_cell c, int n, bool wrap);
+/* the glyph preceding the cursor on the current line, or NULL at the start of the line.
+ * Its column is stored in |column|. Used to append codepoints to a grapheme cluster. */
+struct screen_cell *screen_get_previous_glyph(struct screen *g, int *column);
+/* make the narrow glyph at |column| wide. This only succeeds if the cursor is directly after the glyph. */
+void screen_widen_glyph(struct screen *g, int column);
 void screen_insert_blanks_at_cursor(struct screen *g, int n);
 void screen_move_cursor_relative(struct screen *g, int x, int y);
 void screen_set_cursor_position(struct screen *g, int x, int y);
@@ -153,15 +262,42 @@ void screen_scroll_content_down(struct screen *g, int count);
 void screen_shuffle_rows_up(struct screen *g, int count, int top, int bottom);
 void screen_shuffle_rows_down(struct screen *g, int count, int top, int bottom);
 bool cell_wide(struct screen_cell c);
+/* returns the id of |style| in the style table of |g|, adding it if needed.
+ * If the table is full and no styles can be reclaimed, the default style is returned. */
+style_id screen_intern_style(struct screen *g, struct screen_cell_style style);
+static inline struct screen_cell_style screen_get_style(const struct screen *g, style_id id) {
+  return id ? g->styles.styles[id] : style_default;
+}
+bool screen_cell_style_equals(struct screen_cell_style a, struct screen_cell_style b);
 int screen_calc_line_height(struct screen *s, int width);
 int screen_left(const struct screen *g);
 int screen_right(const struct screen *g);
 int screen_top(const struct screen *g);
 int screen_bottom(const struct screen *g);
-struct screen_line *screen_get_line(const struct screen *g, int n);
-struct screen_line *screen_get_view_line(const struct screen *g, int n);
-void screen_copy_primary(struct screen *restrict dst, const struct screen *restrict src);
-void screen_copy_alternate(struct screen *restrict dst, const struct screen *const restrict src);
+/* the |n|th line of the screen. Negative lines are scrollback lines; reading inherited scrollback re-wraps it. */
+struct screen_line *screen_get_line(struct screen *g, int n);
+struct screen_line *screen_get_view_line(struct screen *g, int n);
+/* discard all scrollback lines (ED 3) */
+void screen_clear_scrollback(struct screen *g);
+/* set the scrollback limit and whether archived lines are spilled to disk. Lines beyond |max| are dropped. */
+void screen_set_scrollback_limit(struct screen *g, int max, bool spill);
+/* move the recent scrollback lines to the compressed archive, and release decoded archive blocks */
+void screen_compress_history(struct screen *g);
+/* drop the |n| oldest scrollback lines */
+void screen_drop_scrollback(struct screen *g, int n);
+struct screen_memory screen_get_memory(const struct screen *g);
+/* re-wrap the content of |src| at the width of |dst|. Only the visible lines and a margin of scrollback are
+ * re-wrapped; the rest of the scrollback is moved to |dst| and re-wrapped as it is read. */
+void screen_copy_primary(struct screen *restrict dst, struct screen *restrict src);
+/* re-wrap all of the scrollback inherited by screen_copy_primary */
+void screen_reflow_scrollback(struct screen *g);
+/* mark every grapheme cluster referenced by the grid or the scrollback of |g| with grapheme_mark */
+void screen_mark_graphemes(const struct screen *g, uint8_t *used);
+/* set used[id] for every hyperlink id referenced by the grid or the scrollback of |g| */
+void screen_mark_links(const struct screen *g, uint8_t *used);
+/* copy the visible lines and the cursor of |src| to |dst|, which has no scrollback */
+void screen_snapshot(struct screen *restrict dst, struct screen *restrict src);
+void screen_copy_alternate(struct screen *restrict dst, struct screen *restrict src);
 
 int screen_get_scroll_height(struct screen *s);
 int screen_get_scroll_offset(struct screen *s);
@@ -0,0 +1,111 @@
+#ifndef SCROLLBACK_H
+#define SCROLLBACK_H
+
+#include "collections.h"
+#include "grapheme.h"
+#include "screen.h"
+
+/* Cold storage for the scrollback of a screen. Lines which scroll out of the hot ring of a screen
+ * are appended here. Each line is encoded as runs of (style, hyperlink) followed by its codepoints,
+ * and every SCROLLBACK_BLOCK_LINES lines the encoded block is sealed and compressed with lz_compress.
+ * Blocks are only decompressed when a line in them is read, and the decoded lines are cached.
+ *
+ * When spilling is enabled, sealed blocks are appended to an unlinked temporary file instead of being kept
+ * on the heap. The file is memory-mapped, so blocks are paged in by the kernel when they are read,
+ * and resident memory does not grow with the length of the history. */
+#define SCROLLBACK_BLOCK_LINES 256
+/* the number of decoded blocks which are cached. A viewport may straddle two blocks. */
+#define SCROLLBACK_CACHE_BLOCKS 2
+
+struct scrollback_block {
+  /* NULL if the block was spilled, in which case it is found at |offset| in the spill file */
+  uint8_t *data;
+  uint64_t offset;
+  uint32_t size, raw_size;
+  bool compressed;
+  /* the distinct style ids referenced by the block. The owning screen must not reclaim them. */
+  style_id *styles;
+  uint32_t n_styles;
+  /* the distinct grapheme cluster handles referenced by the block */
+  uint32_t *graphemes;
+  uint32_t n_graphemes;
+  /* the distinct hyperlink ids referenced by the block */
+  hyperlink_id *links;
+  uint32_t n_links;
+  /* identifies the block in the decode cache */
+  uint64_t serial;
+};
+
+struct scrollback_cache {
+  uint64_t serial;
+  /* the number of decoded lines. The open block may grow after it was decoded. */
+  int n_lines;
+  uint64_t stamp;
+  struct screen_line *lines;
+  struct screen_cell *cells;
+};
+
+struct scrollback {
+  int w;
+  /* the total number of lines */
+  int n_lines;
+  /* the number of lines which were dropped from the first block */
+  int first;
+  /* sealed blocks, oldest first. Each holds exactly SCROLLBACK_BLOCK_LINES lines. */
+  struct scrollback_block *blocks;
+  int n_blocks, blocks_capacity;
+  /* the block currently being filled. Its encoding is not compressed until it is sealed. */
+  struct scrollback_block open;
+  struct string open_data;
+  int open_lines;
+  uint8_t open_seen[(STYLE_ID_MAX + 1) / 8];
+  uint8_t open_seen_graphemes[GRAPHEME_STORE_CAPACITY / 8];
+  uint8_t open_seen_links[(HYPERLINK_ID_MAX + 1) / 8];
+  uint64_t next_serial;
+  struct scrollback_cache cache[SCROLLBACK_CACHE_BLOCKS];
+  uint64_t clock;
+  /* file holding spilled blocks, or -1. Space is only reclaimed when the scrollback is cleared. */
+  int spill_fd;
+  uint64_t spill_size;
+  uint8_t *map;
+  size_t map_size;
+};
+
+struct scrollback_stats {
+  int lines;
+  /* the size of the archived lines as screen cells */
+  size_t raw_bytes;
+  /* the size of their encoding, including spilled blocks */
+  size_t bytes;
+  /* the part of |bytes| which was spilled to disk */
+  size_t spilled_bytes;
+  /* the heap memory held by the archive, including decoded blocks */
+  size_t heap_bytes;
+};
+
+struct scrollback *scrollback_create(int w);
+void scrollback_destroy(struct scrollback *sb);
+/* append |line| as the newest line */
+void scrollback_push(struct scrollback *sb, const struct screen_line *line);
+/* drop the |n| oldest lines */
+void scrollback_drop_oldest(struct scrollback *sb, int n);
+/* move the sealed blocks of |src| in front of the oldest line of |sb|, keeping the lines dropped from |src|.
+ * |src| must not have an open block, and no lines may have been dropped from |sb|. */
+void scrollback_prepend(struct scrollback *sb, struct scrollback *src);
+void scrollback_clear(struct scrollback *sb);
+/* the |n|th line, counting from the oldest line. The line is decoded into a cache owned by |sb|
+ * and is only valid until the next call to a scrollback function. */
+struct screen_line *scrollback_get(struct scrollback *sb, int n);
+/* set used[id] for every style id referenced by an archived line */
+void scrollback_mark_styles(const struct scrollback *sb, uint8_t *used);
+/* mark every grapheme cluster referenced by an archived line with grapheme_mark */
+void scrollback_mark_graphemes(const struct scrollback *sb, uint8_t *used);
+/* set used[id] for every hyperlink id referenced by an archived line */
+void scrollback_mark_links(const struct scrollback *sb, uint8_t *used);
+struct scrollback_stats scrollback_get_stats(const struct scrollback *sb);
+/* free the decoded blocks. They are decoded again when they are read. */
+void scrollback_release_cache(struct scrollback *sb);
+/* move sealed blocks to a spill file, or back to the heap. Returns false if the spill file could not be created. */
+bool scrollback_set_spill(struct scrollback *sb, bool spill);
+
+#endif /* SCROLLBACK_H */
@@ -3,14 +3,17 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 struct utf8 {
   uint8_t utf8[4];
 };
 
+/* packed into 32 bits since a codepoint is stored in every screen cell.
+ * The unicode range only needs 21 bits; the bits above are used for grapheme cluster handles. */
 struct codepoint {
-  uint32_t value;
-  bool is_wide;
+  uint32_t value : 31;
+  uint32_t is_wide : 1;
 };
 
 static const struct codepoint codepoint_fffd = { .value = 0xFFFD };
@@ -28,5 +31,66 @@ uint8_t utf8_length(struct utf8 u);
 void utf8_push(struct utf8 *u, uint8_t byte);
 uint32_t utf8_to_codepoint(const uint8_t utf8[4], int *len);
 int codepoint_to_utf8(uint32_t cp, uint8_t utf8[4]);
+/* decode up to |max| well-formed sequences from |str| into |out|. Decoding stops at the first
+ * malformed or truncated sequence. The number of bytes decoded is stored in |consumed|.
+ * Returns the number of decoded codepoints. */
+size_t utf8_decode_run(const uint8_t *str, size_t len, uint32_t *out, size_t max, size_t *consumed);
+
+/* unicode property table generated at build time from utf8proc (see cmd/gen_unicode_table.c).
+ * Each entry packs the display width in the low 2 bits, the utf8proc category in the next 5 bits,
+ * and the Extended_Pictographic property in the top bit.
+ * The table covers every value a 4-byte utf8 sequence can encode, so lookups are branch-free. */
+#define UNICODE_TABLE_SHIFT 8
+#define UNICODE_TABLE_MASK 0x1FFFFF
+extern const uint16_t unicode_table_index[];
+extern const uint8_t unicode_table_blocks[];
+
+static inline uint8_t unicode_props(uint32_t cp) {
+  cp &= UNICODE_TABLE_MASK;
+  uint32_t block = unicode_table_index[cp >> UNICODE_TABLE_SHIFT];
+  return unicode_table_blocks[(block << UNICODE_TABLE_SHIFT) | (cp & ((1 << UNICODE_TABLE_SHIFT) - 1))];
+}
+
+/* display width of |cp| (0, 1 or 2). Equivalent to utf8proc_charwidth */
+static inline int unicode_width(uint32_t cp) {
+  return unicode_props(cp) & 3;
+}
+
+/* utf8proc_category_t of |cp| */
+static inline int unicode_category(uint32_t cp) {
+  return (unicode_props(cp) >> 2) & 0x1F;
+}
+
+/* true if |cp| has the Extended_Pictographic property used by emoji ZWJ sequences (UAX #29 GB11) */
+static inline bool unicode_is_extended_pictographic(uint32_t cp) {
+  return unicode_props(cp) >> 7;
+}
+
+enum text_scanner_kind {
+  TEXT_SCANNER_AUTO,
+  TEXT_SCANNER_SCALAR,
+  TEXT_SCANNER_SSE2,
+  TEXT_SCANNER_AVX2,
+};
+
+/* vectorized scanners used by the parser fast paths. The implementation is
+ * selected at runtime based on cpu support. */
+struct text_scanner {
+  enum text_scanner_kind kind;
+  /* length of the leading run of printable ascii (0x20 - 0x7e) in |str| */
+  size_t (*ascii)(const uint8_t *str, size_t len);
+  /* length of the leading run of non-ascii bytes (>= 0x80) in |str| */
+  size_t (*utf8)(const uint8_t *str, size_t len);
+  /* length of the leading run of |str| which does not contain C0 controls (< 0x20).
+   * Used to consume OSC, DCS and APC payloads up to a possible terminator (BEL, ESC, CAN, SUB). */
+  size_t (*string)(const uint8_t *str, size_t len);
+};
+
+extern struct text_scanner text_scanner;
+/* select a scanner implementation. If the requested implementation is not supported
+ * by the host cpu, the best supported implementation is selected instead.
+ * Returns the kind of the selected scanner. */
+enum text_scanner_kind text_scanner_select(enum text_scanner_kind kind);
+const char *text_scanner_name(enum text_scanner_kind kind);
 
 #endif /*  TEXT_H */
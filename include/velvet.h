@@ -117,6 +117,10 @@ struct velvet {
   bool reloading; /* flag set if the system is currently reloading */
   io_schedule_id active_render_token;
   io_schedule_id idle_render_token;
+  /* check of the memory budget scheduled after windows produced output */
+  io_schedule_id memory_budget_token;
+  /* id of the window whose OSC 52 sequence is being streamed to clients, or 0 */
+  int clipboard_window;
   /* velvet will try to render when io is idle, but if io is constantly busy
    * it will try to render at least in this interval */
   int fps_target;
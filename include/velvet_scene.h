@@ -29,20 +29,68 @@ struct velvet_window {
   struct pseudotransparency_options transparency;
   float dim_factor;
   bool had_output;
+  /* render scheduled for when the pending synchronized update of the window times out */
+  uint64_t /* io_schedule_id */ synchronized_update_token;
+  /* abort scheduled for when the open OSC 52 sequence of the window times out */
+  uint64_t /* io_schedule_id */ clipboard_token;
+  /* release scheduled for when the alternate screen of the window has been left for VTE_ALTERNATE_SCREEN_GRACE ms */
+  uint64_t /* io_schedule_id */ alternate_screen_token;
+  /* when the window was last written to or shown, in ms since startup. The scrollback of windows which were
+   * not used recently is trimmed first when the memory budget is exceeded. */
+  uint64_t last_used;
+  /* the visible lines of the window when it was last composited. Lines which have not been modified since then,
+   * and which are still shown in the same place, are not restaged. */
+  struct {
+    /* the position of the window among the visible windows, bottom to top */
+    int layer;
+    struct screen *screen;
+    int view_offset;
+    uint64_t generation;
+    /* the cells of each visible line */
+    struct screen_cell **lines;
+    int n_lines;
+    /* the position of the emulated cursor, or -1 if it was not drawn */
+    int cursor_line, cursor_column;
+    enum cursor_style cursor_style;
+    /* the number of rows the content of the window moved up since it was composited, negative if it moved down.
+     * This is a guess made before the window is recomposited, and 0 if no movement was found. */
+    int scrolled;
+  } composited;
 };
 
 bool velvet_window_resize(struct velvet_window *velvet_window, struct rect window, struct velvet *v);
 void velvet_window_process_output(struct velvet_window *velvet_window, struct u8_slice str);
+/* abort the OSC 52 sequence of the window if it timed out. CAN is written to the output buffer of the window. */
+bool velvet_window_expire_clipboard(struct velvet_window *velvet_window);
 
 struct velvet_render_option {
   /* debugging option for highlighting changed regions */
   bool display_damage;
   /* debugging option for highlighting line ends */
   bool display_eol;
+  /* the terminal supports left and right margins (DECSLRM), so windows which do not span the full width
+   * can be scrolled by the terminal */
+  bool left_right_margins;
+  /* the terminal supports repeating the preceding character (REP) */
+  bool repeat_characters;
+};
+
+/* a cell in the render buffers. Unlike screen cells, which reference the style and hyperlink
+ * tables of their emulator, render cells are resolved since they combine cells from several windows.
+ * Composited cells have RGB colors and blank cells have no foreground, so two cells look the same
+ * exactly when their bytes are equal. */
+struct velvet_render_cell {
+  struct codepoint cp;
+  struct screen_cell_style style;
+  hyperlink_handle link;
 };
 
+_Static_assert(sizeof(struct velvet_render_cell) ==
+                   sizeof(struct codepoint) + sizeof(struct screen_cell_style) + sizeof(hyperlink_handle),
+               "render cells are compared bytewise and must not contain padding");
+
 struct velvet_render_buffer_line {
-  struct screen_cell *cells;
+  struct velvet_render_cell *cells;
   struct {
     int start, end;
   } damage[DAMAGE_MAX];
@@ -50,7 +98,7 @@ struct velvet_render_buffer_line {
 };
 
 struct velvet_render_buffer {
-  struct screen_cell *cells;
+  struct velvet_render_cell *cells;
   struct velvet_render_buffer_line *lines;
 };
 
@@ -65,6 +113,17 @@ struct velvet_theme {
   bool bold_bright_colors;
 };
 
+/* the parameters a window was composited with. Rows of the render buffer are only recomposited if a window
+ * showing them changed, unless any window was added, removed, moved or composited differently. */
+struct velvet_render_layer {
+  int id;
+  struct rect geometry;
+  struct pseudotransparency_options transparency;
+  float dim_factor;
+  bool reverse_video;
+  bool focused;
+};
+
 struct velvet_render_state_cache {
   /* remember previous state changes to avoid re-transmitting them */
   struct {
@@ -95,6 +154,19 @@ struct velvet_render {
   struct string draw_buffer;
   struct velvet_render_option options;
   struct velvet_render_state_cache state;
+  /* grapheme clusters referenced by the render buffers. Clusters are copied from the window
+   * stores when cells are staged, since handles are only meaningful within a single store. */
+  struct grapheme_store graphemes;
+  /* rows which are recomposited in the current frame. Other rows are copied from the previous frame. */
+  bool *dirty;
+  /* for each cell, 1 + the layer of the topmost opaque window covering it, or 0. Windows below that layer are not
+   * composited in the cell. */
+  int *occlusion;
+  /* set if the previous buffer holds the previous frame, and rows can be copied from it */
+  bool composited;
+  /* the windows of the previous frame, bottom to top, and the theme they were composited with */
+  struct vec /*velvet_render_layer*/ layers;
+  struct velvet_theme theme;
 };
 
 struct velvet_scene {
@@ -105,6 +177,8 @@ struct velvet_scene {
   struct rect size;
   struct velvet_render renderer;
   struct velvet_theme theme;
+  /* the heap memory in bytes the emulators of all windows may use, or 0 */
+  size_t memory_budget;
   /* needed to raise window creation events. It is a bit spaghetty, but the alternative is just a lot of fuzz for */
   struct velvet *v;
 };
@@ -126,6 +200,9 @@ struct velvet_window * velvet_scene_manage(struct velvet_scene *m, struct velvet
 /* returns the window id on success, or -errno on failure. */
 int velvet_scene_spawn_process_from_template(struct velvet_scene *m, struct velvet_window template, char * const *arglist, char * const *envp);
 
+/* compress, and then trim, the scrollback of the least recently used windows until the memory used by all windows
+ * is within the memory budget */
+void velvet_scene_enforce_memory_budget(struct velvet_scene *m);
 void velvet_scene_resize(struct velvet_scene *m, struct rect w);
 void velvet_scene_arrange(struct velvet_scene *m);
 void velvet_scene_destroy(struct velvet_scene *m);
@@ -161,10 +238,15 @@ static const struct velvet_render_state_cache render_state_cache_invalidated = {
     .cursor.options = {.style = -1, .visible = false},
 };
 
+#define VELVET_SCENE_MEMORY_BUDGET (256 << 20)
+/* the budget is enforced at most this often (ms) while windows produce output */
+#define VELVET_MEMORY_BUDGET_INTERVAL 1000
+
 static const struct velvet_scene velvet_scene_default = {
     .windows = vec(struct velvet_window),
     .theme = velvet_theme_default,
-    .renderer = {.state = render_state_cache_invalidated},
+    .memory_budget = VELVET_SCENE_MEMORY_BUDGET,
+    .renderer = {.state = render_state_cache_invalidated, .layers = vec(struct velvet_render_layer)},
 };
 
 #endif // VELVET_SCENE_H
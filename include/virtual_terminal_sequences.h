@@ -25,6 +25,7 @@ VT(focus_in, CSI "I")
 VT(clear, CSI "2J")
 VT(kitty_keyboard_on, CSI ">31u")
 VT(kitty_keyboard_off, CSI "<u")
+VT(reset_top_bottom_margins, CSI "r")
 
 VT_ANSI_MODE(application_mode, 1)
 VT_PRIVATE_MODE(synchronized_rendering, 2026)
@@ -35,6 +36,7 @@ VT_PRIVATE_MODE(line_wrapping, 7)
 VT_PRIVATE_MODE(cursor_visible, 25)
 VT_PRIVATE_MODE(focus_reporting, 1004)
 VT_PRIVATE_MODE(bracketed_paste, 2004)
+VT_PRIVATE_MODE(left_right_margins, 69)
 
 #undef VT
 #undef ESC
@@ -6,20 +6,9 @@
 #include "collections.h"
 #include <stdint.h>
 #include "osc.h"
-
-enum vte_state {
-  vte_ground,
-  vte_utf8,
-  vte_escape,
-  vte_csi,
-  vte_osc,
-  vte_dcs,
-  vte_pnd,
-  vte_spc,
-  vte_pct,
-  vte_apc,
-  vte_charset,
-};
+#include "csi.h"
+#include "vte_table.h"
+#include "grapheme.h"
 
 struct modifier_options {
   union {
@@ -163,6 +152,8 @@ struct emulator_options {
 
   /* invert fg/bg */
   bool reverse_video;
+  /* synchronized output (DECSET 2026). See vte.synchronized_update */
+  bool synchronized_update;
   struct modifier_options modifiers;
   struct charset_options charset;
   struct cursor_options cursor;
@@ -206,12 +197,16 @@ struct vte {
   enum vte_state state;
   struct emulator_options options;
   struct screen primary;
+  /* allocated when the alternate screen is entered, and released VTE_ALTERNATE_SCREEN_GRACE ms after it was left */
   struct screen alternate;
+  uint64_t alternate_left;
   /* pending input contains responses to requests sent processed during vte_process()
    * The data in this buffer should be flushed (and ideally sent to the emulated PTY)
    * after each call to vte_process. If the buffer is not flushed it will accumulate over time. */
   struct string pending_input;
   struct string command_buffer;
+  /* parameters of the current control sequence, accumulated as bytes are processed */
+  struct csi csi;
   struct {
     struct {
       size_t len;
@@ -224,20 +219,57 @@ struct vte {
   } osc;
   struct utf8 pending_symbol;
   struct codepoint previous_symbol;
+  /* slots of links which were reclaimed by vte_collect_links are NULL, and their ids are kept in |free_links| */
   struct vec /* *hyperlink */ links;
-  hyperlink_handle current_link;
+  struct vec /* hyperlink_id */ free_links;
+  /* set when links were reclaimed. Their ids may be reused, so handles obtained earlier must be discarded. */
+  bool links_collected;
+  hyperlink_id current_link;
+  /* grapheme clusters referenced by cells on the primary and alternate screens.
+   * The screens share a store so handles stay valid when the screens are reflowed or swapped. */
+  struct grapheme_store graphemes;
   /* bitmap of tabstops. 64*16*x is a generous limit. It's okay if tabs break after that. */
   struct tabstop_bitmap tabstop;
-  /* caller controlled callback invoked when OSC 52 tries to set the clipboard.
-   * The `set` callback should validate that `base64` is a valid base64 string.
+  /* caller controlled callbacks invoked when OSC 52 tries to set the clipboard.
+   * The payload is streamed as it arrives, so there is no limit on its size: `begin` is invoked once,
+   * followed by `write` for each chunk of the payload, and `end` when the sequence is terminated.
+   * `abort` is invoked instead of `end` if the sequence is cancelled (CAN, SUB, an ESC not starting ST,
+   * RIS or vte_destroy). Only bytes of the base64 alphabet are passed to `write`; anything else is dropped.
+   * The receiver should still validate that the concatenated chunks are a valid base64 string.
    */
   struct {
     void *userdata;
-    void (*set)(struct u8_slice base64, enum osc_clipboard clipboard, void *userdata);
+    void (*begin)(enum osc_clipboard clipboard, void *userdata);
+    void (*write)(struct u8_slice base64, void *userdata);
+    void (*end)(void *userdata);
+    void (*abort)(void *userdata);
   } clipboard;
+  /* the OSC 52 payload being streamed. It is aborted if it is not closed within VTE_CLIPBOARD_TIMEOUT
+   * or grows beyond VTE_CLIPBOARD_MAX_SIZE, so an application cannot hold the host sequence open. */
+  struct {
+    uint64_t since;
+    size_t size;
+  } clipboard_stream;
   bool bell;
+  /* While a synchronized update is open, renderers should draw `frame`, a copy of the screen taken
+   * when the update began, instead of the live screen. Updates which are not closed within
+   * VTE_SYNCHRONIZED_UPDATE_TIMEOUT are abandoned so an application cannot freeze its window. */
+  struct {
+    struct screen frame;
+    uint64_t since;
+    /* set when an update is closed or abandoned. The caller should clear it once the new frame is scheduled. */
+    bool completed;
+  } synchronized_update;
 };
 
+#define VTE_SYNCHRONIZED_UPDATE_TIMEOUT 150
+#define VTE_CLIPBOARD_TIMEOUT 3000
+#define VTE_CLIPBOARD_MAX_SIZE (64 << 20)
+/* applications often leave the alternate screen briefly, e.g. to run a shell command */
+#define VTE_ALTERNATE_SCREEN_GRACE 5000
+/* the number of scrollback lines kept unless the scrollback is spilled to disk */
+#define VTE_SCROLLBACK_LINES 10000
+
 static const struct emulator_options emulator_options_default = {
     .auto_wrap_mode = true,
     .cursor.visible = true,
@@ -245,8 +277,9 @@ static const struct emulator_options emulator_options_default = {
 
 static const struct vte vte_default = {
     .options = emulator_options_default,
-    .primary = { .scroll.max = 10000, },
+    .primary = { .scroll.max = VTE_SCROLLBACK_LINES, },
     .links = vec(struct osc_hyperlink*),
+    .free_links = vec(hyperlink_id),
     .tabstop = tabstop_bitmap_default,
 };
 
@@ -256,13 +289,51 @@ enum vte_dsr {
 };
 
 
+/* heap memory used by an emulator, in bytes */
+struct vte_memory {
+  /* the primary and alternate screens, and the frame of a synchronized update */
+  struct screen_memory screens;
+  size_t hyperlinks;
+};
+
+static inline size_t vte_memory_total(struct vte_memory m) {
+  return m.screens.cells + m.screens.lines + m.screens.styles + m.screens.scrollback + m.hyperlinks;
+}
+
 void vte_process(struct vte *vte, struct u8_slice str);
 void vte_destroy(struct vte *vte);
+struct vte_memory vte_get_memory(const struct vte *vte);
 void vte_send_device_attributes(struct vte *vte);
 struct screen *vte_get_current_screen(struct vte *vte);
+/* the hyperlink referenced by a cell of this emulator, or NULL */
+hyperlink_handle vte_get_hyperlink(struct vte *vte, hyperlink_id id);
 void vte_enter_primary_screen(struct vte *vte);
 void vte_enter_alternate_screen(struct vte *vte);
 void vte_set_size(struct vte *vte, struct rect sz);
 void vte_send_status_report(struct vte *vte, enum vte_dsr n);
+void vte_set_synchronized_update(struct vte *vte, bool on);
+/* reclaim the grapheme clusters which are no longer referenced by a screen or its scrollback */
+void vte_collect_graphemes(struct vte *vte);
+/* reclaim the hyperlinks which are no longer referenced by a screen or its scrollback */
+void vte_collect_links(struct vte *vte);
+/* true if a synchronized update is open and has not timed out */
+bool vte_synchronized_update_pending(const struct vte *vte);
+/* close the synchronized update if it has timed out. Returns true if it was closed. */
+bool vte_synchronized_update_expire(struct vte *vte);
+/* true if the alternate screen was left, but is kept for VTE_ALTERNATE_SCREEN_GRACE ms in case it is entered again */
+bool vte_alternate_screen_kept(const struct vte *vte);
+/* release the alternate screen if it was left VTE_ALTERNATE_SCREEN_GRACE ms ago. Returns true if it was released. */
+bool vte_alternate_screen_expire(struct vte *vte);
+/* the screen which should be rendered. This is the live screen unless a synchronized update is pending. */
+struct screen *vte_get_visible_screen(struct vte *vte);
+void vte_clipboard_begin(struct vte *vte, enum osc_clipboard clipboard);
+void vte_clipboard_write(struct vte *vte, struct u8_slice base64);
+void vte_clipboard_end(struct vte *vte);
+/* true while an OSC 52 payload is being streamed to the clipboard callbacks */
+bool vte_clipboard_open(const struct vte *vte);
+/* cancel an open OSC 52 payload. Does nothing if no payload is open. */
+void vte_clipboard_abort(struct vte *vte);
+/* abort the open OSC 52 payload if it has timed out. Returns true if it was aborted. */
+bool vte_clipboard_expire(struct vte *vte);
 
 #endif /*  VTE_H */
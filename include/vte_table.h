@@ -0,0 +1,64 @@
+#ifndef VTE_TABLE_H
+#define VTE_TABLE_H
+
+#include <stdint.h>
+
+enum vte_state {
+  vte_ground,
+  vte_utf8,
+  vte_escape,
+  vte_csi,
+  vte_osc,
+  vte_dcs,
+  vte_pnd,
+  vte_spc,
+  vte_pct,
+  vte_apc,
+  vte_charset,
+  /* payload of an OSC 52 sequence, which is streamed instead of buffered */
+  vte_clipboard,
+  VTE_STATE_LAST,
+};
+
+/* the action performed when a byte is consumed in a given state.
+ * Actions run after the state is updated, and may override the next state. */
+enum vte_action {
+  VTE_ACTION_IGNORE,
+  /* ground: printable character or utf8 lead byte */
+  VTE_ACTION_PRINT,
+  /* C0 control characters. These are also executed inside escape and CSI sequences. */
+  VTE_ACTION_EXECUTE,
+  /* utf8 continuation */
+  VTE_ACTION_UTF8,
+  /* start of an escape sequence; also used to restart an interrupted sequence */
+  VTE_ACTION_ESC_ENTER,
+  VTE_ACTION_ESC_DISPATCH,
+  /* append the byte to the command buffer */
+  VTE_ACTION_COLLECT,
+  VTE_ACTION_CSI_ENTER,
+  /* parameter, prefix or intermediate byte which is accumulated in vte->csi */
+  VTE_ACTION_CSI_COLLECT,
+  VTE_ACTION_CSI_DISPATCH,
+  /* start of an OSC, DCS or APC string */
+  VTE_ACTION_STRING_ENTER,
+  VTE_ACTION_OSC_PUT,
+  VTE_ACTION_DCS_PUT,
+  VTE_ACTION_APC_PUT,
+  VTE_ACTION_PND_DISPATCH,
+  VTE_ACTION_SPC_DISPATCH,
+  VTE_ACTION_PCT_DISPATCH,
+  VTE_ACTION_CHARSET_DISPATCH,
+  VTE_ACTION_CLIPBOARD_PUT,
+  VTE_ACTION_LAST,
+};
+
+struct vte_transition {
+  uint8_t action;
+  uint8_t next;
+};
+
+/* state transition table generated at build time (see cmd/gen_vte_table.c).
+ * C1 controls (0x80 - 0x9f) map to the same transition as ESC followed by their 7-bit equivalent. */
+extern const struct vte_transition vte_transitions[VTE_STATE_LAST][256];
+
+#endif /* VTE_TABLE_H */
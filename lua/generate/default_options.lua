@@ -14,7 +14,7 @@ function M.generate(spec)
 ]])
 
   for _, fn in ipairs(spec.options) do
-    local template = { name = fn.name, default_value = type(fn.default) == 'table' and inspect(fn.default) or fn.default }
+    local template = { name = fn.name, default_value = type(fn.default) == 'table' and inspect(fn.default) or tostring(fn.default) }
     builder:push('vv.options.<name> = <default_value>', template)
   end
 
@@ -18,7 +18,7 @@ local options = {}]])
       doc = utils.string_concatenate(fn.doc, "\n--- "),
       type = utils.lua_type(fn.type),
       name = fn.name,
-      default_value = type(fn.default) == 'table' and inspect(fn.default) or fn.default
+      default_value = type(fn.default) == 'table' and inspect(fn.default) or tostring(fn.default)
     }
     builder:push([[
 --- <doc>
@@ -86,6 +86,24 @@ return {
       default = 3,
       doc = "The number of lines scrolled per scroll wheel tick.",
     },
+    {
+      name = "scrollback_memory_budget",
+      type = "int",
+      default = 268435456,
+      doc = "The memory in bytes all windows may use together. When it is exceeded, the scrollback of the least recently used windows is compressed, and then trimmed. The scrollback of windows in |disk| mode is compressed, but not trimmed. 0 disables the budget.",
+    },
+    {
+      name = "left_right_margins",
+      type = "bool",
+      default = false,
+      doc = "Set if the terminal velvet is drawn in supports left and right margins (DECSLRM). Windows which do not span the full width are then scrolled by the terminal instead of redrawn when their content scrolls.",
+    },
+    {
+      name = "repeat_characters",
+      type = "bool",
+      default = false,
+      doc = "Set if the terminal velvet is drawn in supports repeating the preceding character (REP). Runs of identical characters are then drawn once and repeated.",
+    },
     {
       name = 'theme',
       type = 'theme',
@@ -182,6 +200,15 @@ return {
         { name = "all",   value = 2, doc = 'alpha blending applies to all cells' },
       }
     },
+    {
+      name = "scrollback_mode",
+      flags = false,
+      doc = "Storage of the scrollback of a window.",
+      values = {
+        { name = "memory", value = 0, doc = 'Keep a bounded scrollback in memory. Old lines are compressed.' },
+        { name = "disk",   value = 1, doc = 'Keep an unlimited scrollback. Old lines are compressed and spilled to a memory-mapped temporary file.' },
+      }
+    },
     {
       name = "key_event_type",
       flags = false,
@@ -467,6 +494,29 @@ return {
         { name = "wraps", type = "bool",   doc = "True if the line continues on the next row" },
       },
     },
+    {
+      name = "scrollback_compression",
+      doc = "Memory usage of the compressed part of a scrollback. Recent lines are stored uncompressed and are not included.",
+      fields = {
+        { name = "lines",            type = "int",   doc = "The number of compressed lines." },
+        { name = "raw_bytes",        type = "int",   doc = "The size of the compressed lines if they were stored uncompressed." },
+        { name = "compressed_bytes", type = "int",   doc = "The size of the compressed lines." },
+        { name = "spilled_bytes",    type = "int",   doc = "The part of compressed_bytes which was spilled to disk." },
+        { name = "ratio",            type = "float", doc = "raw_bytes / compressed_bytes, or 1 if nothing is compressed." },
+      },
+    },
+    {
+      name = "memory_usage",
+      doc = "Heap memory used by the emulator of a window, in bytes. Scrollback spilled to disk is not included.",
+      fields = {
+        { name = "cells",      type = "int", doc = "The cells of the screens and of the recent scrollback lines." },
+        { name = "lines",      type = "int", doc = "Line bookkeeping of the screens and the scrollback." },
+        { name = "styles",     type = "int", doc = "The style tables of the screens." },
+        { name = "hyperlinks", type = "int", doc = "The hyperlinks referenced by cells." },
+        { name = "scrollback", type = "int", doc = "The compressed part of the scrollback." },
+        { name = "total",      type = "int", doc = "The sum of the other fields." },
+      },
+    },
     {
       name = "coordinate",
       doc = "1-indexed screen coordinate",
@@ -656,6 +706,11 @@ return {
       doc = "Get the last recorded mouse position",
       returns = { type = "coordinate", doc = "The last recorded mouse position", name = 'position' },
     },
+    {
+      name = "get_memory_usage",
+      doc = "Get the heap memory used by all windows. This is the memory limited by |scrollback_memory_budget|.",
+      returns = { type = "memory_usage", doc = "memory used by all windows.", name = 'usage' },
+    },
     --- Windows {{{2
     {
       name = "get_windows",
@@ -918,6 +973,32 @@ return {
       params = { { name = "win_id", type = "int", doc = "Window id" } },
       returns = { type = "int", doc = "number of lines in scrollback, not counting the current screen buffer.", name = 'scrollback_line_count' }
     },
+    {
+      name = "window_get_scrollback_compression",
+      doc = "Get the compression statistics of the scrollback of the window with id |win_id|.",
+      params = { { name = "win_id", type = "int", doc = "Window id" } },
+      returns = { type = "scrollback_compression", doc = "compression statistics of the scrollback.", name = 'compression' }
+    },
+    {
+      name = "window_get_memory_usage",
+      doc = "Get the heap memory used by the window with id |win_id|.",
+      params = { { name = "win_id", type = "int", doc = "Window id" } },
+      returns = { type = "memory_usage", doc = "memory used by the window.", name = 'usage' }
+    },
+    {
+      name = "window_get_scrollback_mode",
+      doc = "Get the scrollback mode of the window with id |win_id|.",
+      params = { { name = "win_id", type = "int", doc = "Window id" } },
+      returns = { type = "scrollback_mode", doc = "scrollback mode of |win_id|", name = 'mode' }
+    },
+    {
+      name = "window_set_scrollback_mode",
+      doc = "Set the scrollback mode of the window with id |win_id|. Switching to |memory| discards the oldest lines beyond the in-memory limit.",
+      params = {
+        { name = "win_id", type = "int",             doc = "Window id" },
+        { name = "mode",   type = "scrollback_mode", doc = "The new scrollback mode." },
+      },
+    },
     {
       name = "window_get_scroll_offset",
       doc = "Get the scroll offset of the window with id |win_id|",
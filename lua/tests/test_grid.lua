@@ -294,6 +294,58 @@ local function test_input_output() -- {{{1
       "DDDDDDDD",
       "EEEEEEEE",
     })
+
+  -- a run of wide characters wraps when the next glyph does not fit on the line
+  check8("wide run wrapping",
+    "a中文字漢字中文",
+    {
+      "a中文字",
+      "漢字中文",
+    })
+
+  -- a truncated sequence at the end of a run is replaced, and parsing resumes at the next byte
+  check8("unicode run invalid sequence",
+    "αβ\xe4\xb8xγ",
+    { "αβ\u{fffd}xγ" })
+
+  -- control sequences split across writes are accumulated byte by byte
+  local split_input = "ab" .. SGR("38;2;1;2;3") .. CUP(2, 4) .. "x"
+  for i = 1, #split_input - 1 do
+    local win_id = make_window(8, 2)
+    vv.api.window_write(win_id, split_input:sub(1, i))
+    vv.api.window_write(win_id, split_input:sub(i + 1))
+    assert_screen("csi split at " .. i, win_id, { "ab", "   x" })
+    vv.api.window_close(win_id)
+  end
+
+  -- OSC payloads split across writes, terminated by ST or BEL
+  for _, st in ipairs({ "\x1b\\", "\a" }) do
+    local osc_input = "a\x1b]2;some\x1bti\x7ftle" .. st .. "b"
+    for i = 1, #osc_input - 1 do
+      local win_id = make_window(8, 1)
+      vv.api.window_write(win_id, osc_input:sub(1, i))
+      vv.api.window_write(win_id, osc_input:sub(i + 1))
+      assert_screen("osc split at " .. i, win_id, { "ab" })
+      vv.api.window_close(win_id)
+    end
+  end
+
+  -- combining marks, ZWJ sequences and flags are stored as a single cell
+  do
+    local win_id = make_window(8, 1)
+    vv.api.window_write(win_id, "e\u{301}\u{1f469}\u{200d}\u{1f4bb}\u{1f1f3}\u{1f1f4}x")
+    local cells = row_cells(win_id)
+    vv.api.window_close(win_id)
+    expect_eq("e\u{301}", cells[1])
+    expect_eq("\u{1f469}\u{200d}\u{1f4bb}", cells[2])
+    expect_eq(nil, cells[3])
+    expect_eq("\u{1f1f3}\u{1f1f4}", cells[4])
+    expect_eq("x", cells[6])
+  end
+  check8("grapheme cluster text", "a\u{308}bc\u{301}", { "a\u{308}bc\u{301}" })
+
+  -- C0 controls inside a control sequence are executed without aborting it
+  check8("csi embedded control", "abc" .. CSI .. "2\r;2H" .. "x", { "abc", " x" })
 end
 
 local function test_erase() -- {{{1
@@ -357,6 +409,54 @@ local function test_erase() -- {{{1
   check8("ECH",
     "wwwww" .. CUP(1, 2) .. ECH(2),
     { "w  ww   " })
+
+  check8("DCH past end of line",
+    "abcdefgh" .. CUP(1, 3) .. DCH(20),
+    { "ab      " })
+
+  check8("DECFRA",
+    "abcdefgh\r\nabcdefgh" .. CSI .. "120;1;2;2;4$x",
+    {
+      "axxxefgh",
+      "axxxefgh",
+    })
+
+  check8("DECERA",
+    "abcdefgh\r\nabcdefgh" .. CSI .. "2;3;2;4$z",
+    {
+      "abcdefgh",
+      "ab  efgh",
+    })
+
+  check8("DECCRA",
+    "abcdefgh\r\n12345678" .. CSI .. "1;1;2;3;1;3;6;1$v",
+    {
+      "abcdefgh",
+      "12345678",
+      "     abc",
+      "     123",
+    })
+
+  check8("DECCRA overlapping",
+    "abcdefgh" .. CSI .. "1;1;1;6;1;1;3;1$v",
+    { "ababcdef" })
+
+  check8("DECFRA splits wide glyphs",
+    "a\xe4\xb8\x80b" .. CSI .. "120;1;3;1;3$x",
+    { "a xb" })
+
+  check8("REP", "ab" .. CSI .. "3b", { "abbbb   " })
+
+  check8("REP wraps",
+    "ab" .. CSI .. "10b",
+    {
+      "abbbbbbb",
+      "bbbb    ",
+    })
+
+  check8("REP without wrapping",
+    disable_wrapping .. "ab" .. CSI .. "10b" .. "x",
+    { "abbbbbbx" })
 end
 
 local function test_scrolling() -- {{{1
@@ -431,6 +531,77 @@ local function test_scrolling() -- {{{1
     "        ",
     "EEEEEEEE",
   })
+
+  -- index below the scroll region stops at the last line without scrolling
+  check8("Index below Scroll Region", DECSTBM(1, 2) .. CUP(4, 1) .. "a" .. IND .. "b" .. IND .. "c", {
+    "",
+    "",
+    "",
+    "a",
+    " bc",
+  })
+
+  -- old scrollback lines are compressed, but can still be read
+  local win_id = make_window(8, 5)
+  local lines = {}
+  for i = 1, 3000 do lines[i] = string.format("%d", i) end
+  vv.api.window_write(win_id, table.concat(lines, "\r\n"))
+  local compression = vv.api.window_get_scrollback_compression(win_id)
+  local height = vv.api.window_get_scrollback_size(win_id)
+  if compression.lines == 0 or compression.ratio <= 1 or compression.compressed_bytes >= compression.raw_bytes then
+    error(string.format("[scrollback compression] lines %d, ratio %f", compression.lines, compression.ratio))
+  end
+  local oldest = vv.api.window_get_text(win_id, { left = 1, top = 1 - height, width = 8, height = 1 })[1].text
+  if oldest ~= "1" then
+    error(string.format("[scrollback compression] oldest line: %q", oldest))
+  end
+
+  -- in disk mode the compressed lines are spilled to a file
+  vv.api.window_set_scrollback_mode(win_id, "disk")
+  if vv.api.window_get_scrollback_mode(win_id) ~= "disk"
+      or vv.api.window_get_scrollback_compression(win_id).spilled_bytes == 0 then
+    error("[scrollback compression] disk mode")
+  end
+  vv.api.window_close(win_id)
+
+  -- exceeding the memory budget compresses recent lines first, and then drops lines
+  win_id = make_window(8, 5)
+  vv.api.window_write(win_id, table.concat(lines, "\r\n"))
+  local budget = vv.api.get_scrollback_memory_budget()
+  local usage = vv.api.get_memory_usage()
+  local window_usage = vv.api.window_get_memory_usage(win_id)
+  if window_usage.total ~= window_usage.cells + window_usage.lines + window_usage.styles
+      + window_usage.hyperlinks + window_usage.scrollback or window_usage.total > usage.total then
+    error("[memory budget] usage")
+  end
+  height = vv.api.window_get_scrollback_size(win_id)
+  vv.api.set_scrollback_memory_budget(usage.total - 1)
+  if vv.api.get_memory_usage().total >= usage.total or vv.api.window_get_scrollback_size(win_id) ~= height then
+    error("[memory budget] compress")
+  end
+  vv.api.set_scrollback_memory_budget(1)
+  if vv.api.window_get_scrollback_size(win_id) ~= 0 then
+    error(string.format("[memory budget] trim: %d lines", vv.api.window_get_scrollback_size(win_id)))
+  end
+  vv.api.set_scrollback_memory_budget(budget)
+  vv.api.window_close(win_id)
+
+  -- the history of a window in disk mode is spilled instead of trimmed
+  win_id = make_window(8, 5)
+  vv.api.window_set_scrollback_mode(win_id, "disk")
+  vv.api.window_write(win_id, table.concat(lines, "\r\n"))
+  height = vv.api.window_get_scrollback_size(win_id)
+  vv.api.set_scrollback_memory_budget(1)
+  if vv.api.window_get_scrollback_size(win_id) ~= height
+      or vv.api.window_get_scrollback_compression(win_id).spilled_bytes == 0 then
+    error(string.format("[memory budget] disk mode: %d of %d lines", vv.api.window_get_scrollback_size(win_id), height))
+  end
+  oldest = vv.api.window_get_text(win_id, { left = 1, top = 1 - height, width = 8, height = 1 })[1].text
+  if oldest ~= "1" then
+    error(string.format("[memory budget] disk mode oldest line: %q", oldest))
+  end
+  vv.api.set_scrollback_memory_budget(budget)
+  vv.api.window_close(win_id)
 end
 
 local function test_nowrap() -- {{{1
@@ -509,6 +680,15 @@ local function test_nowrap() -- {{{1
 end
 
 local function test_reflow() -- {{{1
+  do
+    -- clusters survive reflow
+    local win_id = make_window(4, 3)
+    vv.api.window_write(win_id, "abce\u{301}fghi")
+    vv.api.window_set_geometry(win_id, { left = 1, top = 1, width = 8, height = 3 })
+    assert_screen("reflow grapheme cluster", win_id, { "abce\u{301}fghi" })
+    vv.api.window_close(win_id)
+  end
+
   do
     -- grow: write to 5-wide, then expand to 8-wide, then shrink back to 5-wide
     local win_id = make_window(5, 5)
@@ -679,9 +859,6 @@ end
 --   CPL (CSI Ps F) — cursor preceding line: moves up and to column 1
 --   HVP (CSI Pr ; Pc f) — same as CUP but from ANSI X3.64
 --
--- REP (CSI Ps b):
---   Repeat the last printed character Ps times; wraps if auto-wrap is on
---
 -- ED(3) — erase scrollback buffer (xterm extension, implemented)
 
 return function() -- {{{1
@@ -37,6 +37,10 @@ local api = {}
 ---| 'clear' alpha blending applies to cells with no background color
 ---| 'all' alpha blending applies to all cells
 
+---@alias velvet.api.scrollback_mode string Storage of the scrollback of a window.
+---| 'memory' Keep a bounded scrollback in memory. Old lines are compressed.
+---| 'disk' Keep an unlimited scrollback. Old lines are compressed and spilled to a memory-mapped temporary file.
+
 ---@alias velvet.api.key_event_type string 
 ---| 'press' 
 ---| 'repeat' 
@@ -211,6 +215,21 @@ local api = {}
 --- @field cells velvet.api.cell[] A list of cells such that cells[n] corresponds to the nth terminal column.
 --- @field wraps boolean True if the line continues on the next row
 
+--- @class velvet.api.scrollback_compression
+--- @field lines integer The number of compressed lines.
+--- @field raw_bytes integer The size of the compressed lines if they were stored uncompressed.
+--- @field compressed_bytes integer The size of the compressed lines.
+--- @field spilled_bytes integer The part of compressed_bytes which was spilled to disk.
+--- @field ratio number raw_bytes / compressed_bytes, or 1 if nothing is compressed.
+
+--- @class velvet.api.memory_usage
+--- @field cells integer The cells of the screens and of the recent scrollback lines.
+--- @field lines integer Line bookkeeping of the screens and the scrollback.
+--- @field styles integer The style tables of the screens.
+--- @field hyperlinks integer The hyperlinks referenced by cells.
+--- @field scrollback integer The compressed part of the scrollback.
+--- @field total integer The sum of the other fields.
+
 --- @class velvet.api.coordinate
 --- @field row integer row
 --- @field col integer column
@@ -319,6 +338,10 @@ function api.get_startup_directory() end
 --- @return velvet.api.coordinate position The last recorded mouse position
 function api.get_mouse_position() end
 
+--- Get the heap memory used by all windows. This is the memory limited by |scrollback_memory_budget|.
+--- @return velvet.api.memory_usage usage memory used by all windows.
+function api.get_memory_usage() end
+
 --- Get the IDs of all windows.
 --- @return integer[] windows list of window IDs
 function api.get_windows() end
@@ -511,6 +534,27 @@ function api.window_is_valid(win_id) end
 --- @return integer scrollback_line_count number of lines in scrollback, not counting the current screen buffer.
 function api.window_get_scrollback_size(win_id) end
 
+--- Get the compression statistics of the scrollback of the window with id |win_id|.
+--- @param win_id integer Window id
+--- @return velvet.api.scrollback_compression compression compression statistics of the scrollback.
+function api.window_get_scrollback_compression(win_id) end
+
+--- Get the heap memory used by the window with id |win_id|.
+--- @param win_id integer Window id
+--- @return velvet.api.memory_usage usage memory used by the window.
+function api.window_get_memory_usage(win_id) end
+
+--- Get the scrollback mode of the window with id |win_id|.
+--- @param win_id integer Window id
+--- @return velvet.api.scrollback_mode mode scrollback mode of |win_id|
+function api.window_get_scrollback_mode(win_id) end
+
+--- Set the scrollback mode of the window with id |win_id|. Switching to |memory| discards the oldest lines beyond the in-memory limit.
+--- @param win_id integer Window id
+--- @param mode velvet.api.scrollback_mode The new scrollback mode.
+--- @return nil  
+function api.window_set_scrollback_mode(win_id, mode) end
+
 --- Get the scroll offset of the window with id |win_id|
 --- @param win_id integer Window id
 --- @return integer scroll_offset number of lines below the bottom line of the window.
@@ -630,6 +674,33 @@ function api.get_scrollback_scroll_multiplier() end
 --- @return nil  
 function api.set_scrollback_scroll_multiplier(value) end
 
+--- Get scrollback_memory_budget
+--- @return integer scrollback_memory_budget current scrollback memory budget
+function api.get_scrollback_memory_budget() end
+
+--- Set scrollback_memory_budget to |value|.
+--- @param value integer The memory in bytes all windows may use together. When it is exceeded, the scrollback of the least recently used windows is compressed, and then trimmed. The scrollback of windows in |disk| mode is compressed, but not trimmed. 0 disables the budget.
+--- @return nil  
+function api.set_scrollback_memory_budget(value) end
+
+--- Get left_right_margins
+--- @return boolean left_right_margins current left right margins
+function api.get_left_right_margins() end
+
+--- Set left_right_margins to |value|.
+--- @param value boolean Set if the terminal velvet is drawn in supports left and right margins (DECSLRM). Windows which do not span the full width are then scrolled by the terminal instead of redrawn when their content scrolls.
+--- @return nil  
+function api.set_left_right_margins(value) end
+
+--- Get repeat_characters
+--- @return boolean repeat_characters current repeat characters
+function api.get_repeat_characters() end
+
+--- Set repeat_characters to |value|.
+--- @param value boolean Set if the terminal velvet is drawn in supports repeating the preceding character (REP). Runs of identical characters are then drawn once and repeated.
+--- @return nil  
+function api.set_repeat_characters(value) end
+
 --- Get theme
 --- @return velvet.api.theme theme current theme
 function api.get_theme() end
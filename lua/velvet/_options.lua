@@ -6,6 +6,18 @@ local options = {}
 --- @type integer
 options.scrollback_scroll_multiplier = 3
 
+--- The memory in bytes all windows may use together. When it is exceeded, the scrollback of the least recently used windows is compressed, and then trimmed. The scrollback of windows in |disk| mode is compressed, but not trimmed. 0 disables the budget.
+--- @type integer
+options.scrollback_memory_budget = 268435456
+
+--- Set if the terminal velvet is drawn in supports left and right margins (DECSLRM). Windows which do not span the full width are then scrolled by the terminal instead of redrawn when their content scrolls.
+--- @type boolean
+options.left_right_margins = false
+
+--- Set if the terminal velvet is drawn in supports repeating the preceding character (REP). Runs of identical characters are then drawn once and repeated.
+--- @type boolean
+options.repeat_characters = false
+
 --- The 16 numbered terminal colors.
 --- @type velvet.api.theme
 options.theme = {
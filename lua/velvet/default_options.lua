@@ -3,6 +3,9 @@
 --- It sets all options to their default values.
 
 vv.options.scrollback_scroll_multiplier = 3
+vv.options.scrollback_memory_budget = 268435456
+vv.options.left_right_margins = false
+vv.options.repeat_characters = false
 vv.options.theme = {
   background = "#1e1e2e",
   black = "#45475a",
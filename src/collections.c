@@ -1,6 +1,5 @@
 #include "collections.h"
 #include "text.h"
-#include "utf8proc/utf8proc.h"
 #include "utils.h"
 #include <stdarg.h>
 #include <stdlib.h>
@@ -524,7 +523,7 @@ bool u8_slice_codepoint_iterator_next(struct u8_slice_codepoint_iterator *s) {
 
   int len;
   uint32_t symbol = utf8_to_codepoint(t.content + s->cursor, &len);
-  s->current = (struct codepoint) { .value = symbol, .is_wide = utf8proc_charwidth(symbol) > 1 };
+  s->current = (struct codepoint) { .value = symbol, .is_wide = unicode_width(symbol) > 1 };
   s->cursor += len;
 
   /* do the implemnetations agree? */
@@ -1,9 +1,9 @@
 #include "csi.h"
 #include "utils.h"
 #include <ctype.h>
+#include <string.h>
 
-#define PARAMETER(X) (isdigit((X)) || (X) == ';')
-#define INTERMEDIATE(X) (((X) >= 0x20 && (X) <= 0x2F) || ((X) >= 0x3C && (X) <= 0x3F) || ((X) >= 0x5E && (X) <= 0x60))
+#define INTERMEDIATE(X) (((X) >= 0x20 && (X) <= 0x2F) || ((X) >= 0x3C && (X) <= 0x3F))
 #define ACCEPT(X) ((X) >= 0x40 && (X) <= 0x7E)
 
 /** State machine:
@@ -19,165 +19,125 @@
  * Intermediate --> Accept
  */
 
-static int csi_read_digit(const uint8_t *buffer, int *value) {
-  int i, v, sign;
-  i = v = 0;
-  sign = 1;
-  if (buffer[i] == '-') sign = -1, i++;
-  while (isdigit(buffer[i])) {
-    v *= 10;
-    v += buffer[i] - '0';
-    i++;
-  }
-  *value = v * sign;
-  return i;
+#define CSI_VALUE_MAX 100000
+
+static void csi_reject(struct csi *c, const char *reason) {
+  velvet_log("Reject CSI: %s", reason);
+  c->state = CSI_REJECT;
 }
 
-static bool csi_read_subparameter(const uint8_t *buffer, uint8_t separator, int *value, int *read) {
-  if (buffer[0] == separator) {
-    *read = csi_read_digit(buffer + 1, value) + 1;
-    return true;
+static void csi_begin_param(struct csi *c) {
+  if (c->n_params >= CSI_MAX_PARAMS) {
+    csi_reject(c, "Too many numeric parameters");
+    return;
   }
-  return false;
+  c->params[c->n_params++] = (struct csi_param){0};
+  c->negative = false;
+  c->digits = 0;
+  c->state = CSI_PARAMETER;
 }
 
-static bool csi_read_parameter(struct csi_param *param, const uint8_t *buffer, int *read, bool is_sgr) {
-  int i = 0;
-  if (buffer[i] == ';') i++;
-  i += csi_read_digit(buffer + i, &param->primary);
+static int *csi_current_value(struct csi *c) {
+  struct csi_param *p = &c->params[c->n_params - 1];
+  return p->n_sub ? &p->sub[p->n_sub - 1] : &p->primary;
+}
+
+void csi_reset(struct csi *c) {
+  c->state = CSI_GROUND;
+  /* dispatchers read omitted parameters as 0, so parameters past n_params are kept cleared */
+  memset(c->params, 0, c->n_params * sizeof(*c->params));
+  c->n_params = 0;
+  c->prefix = c->intermediate = c->final = 0;
+  c->negative = false;
+  c->digits = 0;
+}
 
-  if (is_sgr) {
-    // If this is an sgr sequence, we do special validation, and additionally allow subparameters to be delimited by ';'
-    int n_subparameters = 0;
-    int value, length, color_type;
-    value = length = color_type = 0;
-    bool is_custom_color = is_sgr && (param->primary == 38 || param->primary == 48);
-    uint8_t separator = ':';
-    int subparameter_max = LENGTH(param->sub);
-    if (is_custom_color && buffer[i] == ';') {
-      separator = ';';
-      bool did_read = csi_read_subparameter(buffer + i, separator, &color_type, &length);
-      i += length;
-      if (!did_read) { 
-        velvet_log("Reject SGR %d: Missing color parameter", param->primary);
-        *read = i;
-        return false;
+void csi_push(struct csi *c, uint8_t ch) {
+  switch (c->state) {
+  case CSI_GROUND:
+  case CSI_PREFIX:
+  case CSI_PARAMETER: {
+    bool is_param = isdigit(ch) || ch == ';' || ch == ':';
+    /* a negative value can only follow a parameter separator */
+    bool is_sign = ch == '-' && c->state == CSI_PARAMETER && c->digits == 0 && !c->negative &&
+                   c->params[c->n_params - 1].n_sub == 0;
+    if (is_param || is_sign) {
+      if (c->state != CSI_PARAMETER) csi_begin_param(c);
+      if (c->state == CSI_REJECT) return;
+      struct csi_param *p = &c->params[c->n_params - 1];
+      if (is_sign) {
+        c->negative = true;
+      } else if (ch == ';') {
+        csi_begin_param(c);
+      } else if (ch == ':') {
+        if (p->n_sub >= LENGTH(p->sub)) {
+          csi_reject(c, "Too many subparameters");
+          return;
+        }
+        p->sub[p->n_sub++] = 0;
+        c->negative = false;
+        c->digits = 0;
+      } else {
+        int *value = csi_current_value(c);
+        int digit = c->negative ? -(ch - '0') : ch - '0';
+        if (*value < CSI_VALUE_MAX && *value > -CSI_VALUE_MAX) *value = *value * 10 + digit;
+        c->digits++;
       }
-      param->sub[0] = color_type;
-      n_subparameters++;
-      subparameter_max = color_type == 2 ? 4 : 2;
+    } else if (INTERMEDIATE(ch)) {
+      if (c->state == CSI_GROUND) {
+        c->prefix = ch;
+        c->state = CSI_PREFIX;
+      } else {
+        c->intermediate = ch;
+        c->state = CSI_INTERMEDIATE;
+      }
+    } else {
+      csi_reject(c, "Unexpected character");
     }
+  } break;
+  case CSI_INTERMEDIATE: csi_reject(c, "Expected final character"); break;
+  default: break;
+  }
+}
 
-    while (n_subparameters < subparameter_max && csi_read_subparameter(buffer + i, separator, &value, &length)) {
-      i += length;
-      param->sub[n_subparameters] = value;
-      n_subparameters++;
-    }
-    if (csi_read_subparameter(buffer + i, ':', &value, &length)) {
-      velvet_log("Reject CSI: Too many subparameters");
-      *read = i;
-      return false;
-    }
-    param->n_sub = n_subparameters;
-  } else if (buffer[i] == ':') {
-    // otherwise parse subparameter sequences only if they are delimited by ':'
-    int value, length;
-    value = length = 0;
-    int n_subparameters = 0;
-    uint8_t separator = ':';
-    int subparameter_max = LENGTH(param->sub);
-    while (n_subparameters < subparameter_max && csi_read_subparameter(buffer + i, separator, &value, &length)) {
-      i += length;
-      param->sub[n_subparameters] = value;
-      n_subparameters++;
+/* SGR 38 / 48 allow the color components to be delimited by ';' instead of ':'.
+ * Fold the components into subparameters so SGR handling does not need to care. */
+static void csi_fold_sgr_colors(struct csi *c) {
+  int n = 0;
+  for (int i = 0; i < c->n_params; i++, n++) {
+    struct csi_param p = c->params[i];
+    bool is_custom_color = (p.primary == 38 || p.primary == 48) && p.n_sub == 0;
+    if (is_custom_color && i + 1 < c->n_params) {
+      int color_type = c->params[++i].primary;
+      int subparameter_max = color_type == 2 ? 4 : 2;
+      p.sub[p.n_sub++] = color_type;
+      while (p.n_sub < subparameter_max && i + 1 < c->n_params)
+        p.sub[p.n_sub++] = c->params[++i].primary;
     }
-    if (csi_read_subparameter(buffer + i, ':', &value, &length)) {
-      velvet_log("Reject CSI: Too many subparameters");
-      *read = i;
-      return false;
-    }
-    param->n_sub = n_subparameters;
+    c->params[n] = p;
   }
-
-  *read = i;
-  return true;
+  memset(&c->params[n], 0, (c->n_params - n) * sizeof(*c->params));
+  c->n_params = n;
 }
 
-// TODO: eww
-static bool looks_like_sgr(struct u8_slice str) {
-  if (str.len < 1) return false;
-  bool could_be = str.content[str.len - 1] == 'm';
-  if (could_be && str.len > 1) {
-    uint8_t prefix = str.content[0];
-    uint8_t intermediate = str.content[str.len - 2];
-    could_be = (prefix >= '0' && prefix <= '9') || prefix == ';';
-    could_be = could_be && ((intermediate >= '0' && intermediate <= '9') || intermediate == ';' || intermediate == ':');
-  }
-  return could_be;
+void csi_finish(struct csi *c, uint8_t final) {
+  if (c->state == CSI_REJECT) return;
+  c->final = final;
+  c->state = CSI_ACCEPT;
+  if (final == 'm' && !c->prefix && !c->intermediate) csi_fold_sgr_colors(c);
 }
 
 int csi_parse(struct csi *c, struct u8_slice str) {
-  if (str.len < 1) {
-    c->state = CSI_REJECT;
-    return 0;
-  }
-  bool is_sgr = looks_like_sgr(str);
-  size_t i = 0;
-  for (; i < str.len;) {
-    char ch = str.content[i];
-    switch (c->state) {
-    case CSI_GROUND: {
-      c->state = PARAMETER(ch) ? CSI_PARAMETER : INTERMEDIATE(ch) ? CSI_PREFIX : ACCEPT(ch) ? CSI_ACCEPT : CSI_REJECT;
-    } break;
-    case CSI_PARAMETER: {
-      if (c->n_params >= CSI_MAX_PARAMS) {
-        c->state = CSI_REJECT;
-        velvet_log("Reject CSI: Too many numeric parameters");
-        return i;
-      }
-
-      struct csi_param *param = &c->params[c->n_params];
-      c->n_params++;
-      int read;
-      if (!csi_read_parameter(param, str.content + i, &read, is_sgr)) {
-        velvet_log("Reject CSI: Error parsing parameter");
-        c->state = CSI_REJECT;
-        return i + read;
-      }
-      i += read;
-
-      ch = str.content[i];
-      c->state = PARAMETER(ch)      ? CSI_PARAMETER
-                 : INTERMEDIATE(ch) ? CSI_INTERMEDIATE
-                 : ACCEPT(ch)       ? CSI_ACCEPT
-                                    : CSI_REJECT;
-    } break;
-    case CSI_PREFIX: {
-      c->prefix = ch;
-      ch = str.content[++i];
-      c->state = PARAMETER(ch)      ? CSI_PARAMETER
-                 : INTERMEDIATE(ch) ? CSI_INTERMEDIATE
-                 : ACCEPT(ch)       ? CSI_ACCEPT
-                                    : CSI_REJECT;
-    } break;
-    case CSI_INTERMEDIATE: {
-      c->intermediate = ch;
-      ch = str.content[++i];
-      c->state = ACCEPT(ch) ? CSI_ACCEPT : CSI_REJECT;
-    } break;
-    case CSI_ACCEPT: {
-      c->final = ch;
-      return i + 1;
-    } break;
-    case CSI_REJECT: {
-      velvet_log("Reject CSI");
+  csi_reset(c);
+  for (size_t i = 0; i < str.len; i++) {
+    uint8_t ch = str.content[i];
+    if (ACCEPT(ch)) {
+      csi_finish(c, ch);
       return i + 1;
-    } break;
-    default: assert(!"Unreachable");
     }
+    csi_push(c, ch);
+    if (c->state == CSI_REJECT) return i + 1;
   }
-  velvet_log("Reject CSI: No accept character");
-  c->state = CSI_REJECT;
-  return i;
+  csi_reject(c, "No accept character");
+  return str.len;
 }
-
@@ -1,6 +1,7 @@
 #include "csi.h"
 #include "vte.h"
 #include "utils.h"
+#include <stdio.h>
 #include <string.h>
 
 enum DECRQM_QUERY_RESPONSE {
@@ -306,13 +307,29 @@ static char *csi_apply_sgr_from_params(struct screen_cell_style *style, int n, s
   return NULL;
 }
 
+/* Reconstruct the parameter bytes of |csi| for log messages, e.g. "?1;38:2:10:20:30 m". */
+static char *csi_format(struct csi *csi, char *buf, size_t size) {
+  size_t n = 0;
+#define FMT(...) n += snprintf(buf + MIN(n, size), n < size ? size - n : 0, __VA_ARGS__)
+  if (csi->prefix) FMT("%c", csi->prefix);
+  for (int i = 0; i < csi->n_params; i++) {
+    FMT(i ? ";%d" : "%d", csi->params[i].primary);
+    for (int j = 0; j < csi->params[i].n_sub; j++) FMT(":%d", csi->params[i].sub[j]);
+  }
+  if (csi->intermediate) FMT("%c", csi->intermediate);
+  FMT("%c", csi->final);
+#undef FMT
+  return buf;
+}
+
 bool csi_dispatch(struct vte *vte, struct csi *csi) {
   assert(csi->state == CSI_ACCEPT);
   for (int i = 0; i < csi->n_params; i++) {
     if (csi->params[i].primary < 0) {
       // The parser accepts negative parameter values because some very specific input CSIs
       // can be negative. No CSI commands I am aware of support it, so we should reject such requests immediately.
-      velvet_log("Negative csi encountered: %.*s", (int)vte->command_buffer.len, vte->command_buffer.content);
+      char buf[256];
+      velvet_log("Negative csi encountered: %s", csi_format(csi, buf, sizeof(buf)));
       return false;
     }
   }
@@ -434,8 +451,8 @@ static bool ED(struct vte *vte, struct csi *csi) {
     end.line = g->h - 1;
     break;
   case 3: // erase scrollback
-    g->scroll.height = 0;
-    g->scroll.view_offset = 0;
+    screen_clear_scrollback(g);
+    vte_collect_graphemes(vte);
     break;
   case 0:
   default: // erase from cursor to end of screen
@@ -549,11 +566,9 @@ bool HPR(struct vte *vte, struct csi *csi) { (void)vte, (void)csi; TODO("HPR");
 static bool REP(struct vte *vte, struct csi *csi) {
   struct screen *g = vte_get_current_screen(vte);
   int count = csi->params[0].primary ? csi->params[0].primary : 1;
-  struct screen_cell repeat = { .cp = vte->previous_symbol, .style = g->cursor.brush, .link = vte->current_link };
+  struct screen_cell repeat = { .cp = vte->previous_symbol, .style = screen_intern_style(g, g->cursor.brush), .link = vte->current_link };
   if (repeat.cp.value == 0) repeat.cp = codepoint_space;
-  for (int i = 0; i < count; i++) {
-    screen_insert(g, repeat, vte->options.auto_wrap_mode);
-  }
+  screen_insert_repeated(g, repeat, count, vte->options.auto_wrap_mode);
   return true;
 }
 
@@ -672,6 +687,7 @@ static enum DECRQM_QUERY_RESPONSE query_private_mode(struct vte *vte, int mode)
   case 1047: return resp(o.alternate_screen);
   case 1049: return resp(o.alternate_screen);
   case 2004: return resp(o.bracketed_paste);
+  case 2026: return resp(o.synchronized_update);
   case 9:
   case 1000:
   case 1002:
@@ -749,10 +765,8 @@ static void decset_set(struct vte *vte, int mode, bool on) {
       }
     }
   } break;
-  case 2026:
-    TODO("Synchronized rendering: "
-         "https://github.com/contour-terminal/vt-extensions/blob/master/synchronized-output.md");
-    break;
+  /* https://github.com/contour-terminal/vt-extensions/blob/master/synchronized-output.md */
+  case 2026: vte_set_synchronized_update(vte, on); break;
   default: TODO("DECSET mode %d", mode); break;
   }
 }
@@ -780,7 +794,8 @@ static bool DECRST(struct vte *vte, struct csi *csi) { return DECSET(vte, csi);
 static bool SGR(struct vte *vte, struct csi *csi) {
   char *error = csi_apply_sgr_from_params(&vte_get_current_screen(vte)->cursor.brush, csi->n_params, csi->params);
   if (error) {
-    velvet_log("Error parsing SGR: %.*s: %s", (int)vte->command_buffer.len - 1, vte->command_buffer.content + 1, error);
+    char buf[256];
+    velvet_log("Error parsing SGR: %s: %s", csi_format(csi, buf, sizeof(buf)), error);
     return false;
   }
 
@@ -953,7 +968,28 @@ bool DECSMBV(struct vte *vte, struct csi *csi) { (void)vte, (void)csi; TODO("DEC
 
 bool DECRQDE(struct vte *vte, struct csi *csi) { (void)vte, (void)csi; TODO("DECRQDE"); return false; }
 
-bool DECCRA(struct vte *vte, struct csi *csi) { (void)vte, (void)csi; TODO("DECCRA"); return false; }
+/* the rectangle Pt ; Pl ; Pb ; Pr at params[i] as inclusive screen coordinates. Rows are relative to the
+ * scroll region in origin mode. Omitted parameters default to the edges of the screen. */
+static void csi_rectangle(struct screen *g, struct csi *csi, int i, int *top, int *left, int *bottom, int *right) {
+  int offset = g->cursor.origin ? g->margins.top : 0;
+  int last = g->cursor.origin ? g->margins.bottom : screen_bottom(g);
+  *top = (csi->params[i].primary ? csi->params[i].primary : 1) - 1 + offset;
+  *left = (csi->params[i + 1].primary ? csi->params[i + 1].primary : 1) - 1;
+  *bottom = csi->params[i + 2].primary ? MIN(csi->params[i + 2].primary - 1 + offset, last) : last;
+  *right = csi->params[i + 3].primary ? csi->params[i + 3].primary - 1 : screen_right(g);
+}
+
+bool DECCRA(struct vte *vte, struct csi *csi) {
+  struct screen *g = vte_get_current_screen(vte);
+  int top, left, bottom, right;
+  csi_rectangle(g, csi, 0, &top, &left, &bottom, &right);
+  /* the fifth and eighth parameters are the source and destination pages. There is only one page. */
+  int offset = g->cursor.origin ? g->margins.top : 0;
+  int dst_top = (csi->params[5].primary ? csi->params[5].primary : 1) - 1 + offset;
+  int dst_left = (csi->params[6].primary ? csi->params[6].primary : 1) - 1;
+  screen_copy_rectangle(g, top, left, bottom, right, dst_top, dst_left);
+  return true;
+}
 
 bool DECRQPSR(struct vte *vte, struct csi *csi) { (void)vte, (void)csi; TODO("DECRQPSR"); return false; }
 
@@ -963,18 +999,26 @@ bool DECREQTPARM(struct vte *vte, struct csi *csi) { (void)vte, (void)csi; TODO(
 
 bool DECSACE(struct vte *vte, struct csi *csi) { (void)vte, (void)csi; TODO("DECSACE"); return false; }
 
-bool DECFRA(struct vte *vte, struct csi *csi) { (void)vte, (void)csi; TODO("DECFRA"); return false; }
+bool DECFRA(struct vte *vte, struct csi *csi) {
+  struct screen *g = vte_get_current_screen(vte);
+  int ch = csi->params[0].primary;
+  /* only printable characters of the ISO Latin-1 set can be used */
+  if (!((ch >= 32 && ch <= 126) || (ch >= 160 && ch <= 255))) return true;
+  int top, left, bottom, right;
+  csi_rectangle(g, csi, 1, &top, &left, &bottom, &right);
+  struct screen_cell c = {.cp = {.value = ch}, .style = screen_intern_style(g, g->cursor.brush)};
+  screen_fill_rectangle(g, top, left, bottom, right, c);
+  return true;
+}
 
 bool DECRQCRA(struct vte *vte, struct csi *csi) { (void)vte, (void)csi; TODO("DECRQCRA"); return false; }
 
 bool DECELR(struct vte *vte, struct csi *csi) { (void)vte, (void)csi; TODO("DECELR"); return false; }
 
 bool DECERA(struct vte *vte, struct csi *csi) {
-  int top = csi->params[0].primary;
-  int left = csi->params[1].primary;
-  int bottom = csi->params[2].primary;
-  int right = csi->params[3].primary;
   struct screen *g = vte_get_current_screen(vte);
+  int top, left, bottom, right;
+  csi_rectangle(g, csi, 0, &top, &left, &bottom, &right);
   screen_erase_rectangle(g, top, left, bottom, right);
   return true;
 }
@@ -0,0 +1,160 @@
+#include "grapheme.h"
+#include "murmur3.h"
+#include "utils.h"
+#include <assert.h>
+#include <string.h>
+
+#define GRAPHEME_HASH_SEED 0x9747b28c
+
+static uint32_t grapheme_hash(const uint32_t *cluster, int n) {
+  return murmur3_32((const uint8_t *)cluster, n * sizeof(*cluster), GRAPHEME_HASH_SEED);
+}
+
+bool grapheme_extends(const struct grapheme_store *s, uint32_t value, uint32_t cp) {
+  uint32_t cluster[GRAPHEME_MAX_LENGTH];
+  int n = grapheme_store_get(s, value, cluster);
+  /* there is nothing to attach to in an empty cell */
+  if (n == 0 || cluster[0] == 0) return false;
+  uint32_t last = cluster[n - 1];
+  /* GB11: emoji ZWJ sequences. A pictographic codepoint is joined to a ZWJ which follows a pictographic codepoint
+   * and its extenders. */
+  if (last == GRAPHEME_ZWJ && unicode_is_extended_pictographic(cp)) {
+    int i = n - 2;
+    for (; i > 0 && grapheme_is_extend(cluster[i]); i--);
+    if (i >= 0 && unicode_is_extended_pictographic(cluster[i])) return true;
+  }
+  /* GB12, GB13: regional indicators are joined in pairs */
+  if (grapheme_is_regional_indicator(cp)) return n == 1 && grapheme_is_regional_indicator(last);
+  /* GB9, GB9a */
+  return grapheme_is_extend(cp);
+}
+
+int grapheme_width(const uint32_t *cluster, int n) {
+  if (n > 1 && grapheme_is_regional_indicator(cluster[0]) && grapheme_is_regional_indicator(cluster[1])) return 2;
+  for (int i = 1; i < n; i++)
+    if (cluster[i] == GRAPHEME_VS16) return 2;
+  return unicode_width(cluster[0]);
+}
+
+static void grapheme_store_insert_index(struct grapheme_store *s, uint32_t hash, uint32_t id) {
+  uint32_t mask = s->index_capacity - 1;
+  uint32_t i = hash & mask;
+  for (; s->index[i]; i = (i + 1) & mask);
+  s->index[i] = id + 1;
+}
+
+/* rebuild the index with a capacity of |capacity|. Reclaimed clusters have a length of 0 and are skipped. */
+static void grapheme_store_rebuild_index(struct grapheme_store *s, uint32_t capacity) {
+  free(s->index);
+  s->index_capacity = capacity;
+  s->index = velvet_calloc(s->index_capacity, sizeof(*s->index));
+  for (uint32_t id = 0; id < s->n_clusters; id++)
+    if (s->clusters[id].len) grapheme_store_insert_index(s, s->clusters[id].hash, id);
+}
+
+uint32_t grapheme_store_intern(struct grapheme_store *s, const uint32_t *cluster, int n) {
+  assert(n > 0 && n <= GRAPHEME_MAX_LENGTH);
+  if (n == 1) return cluster[0];
+
+  uint32_t hash = grapheme_hash(cluster, n);
+  if (s->index_capacity) {
+    uint32_t mask = s->index_capacity - 1;
+    for (uint32_t i = hash & mask; s->index[i]; i = (i + 1) & mask) {
+      uint32_t id = s->index[i] - 1;
+      struct grapheme *g = &s->clusters[id];
+      if (g->hash == hash && g->len == (uint32_t)n &&
+          memcmp(&s->codepoints[g->offset], cluster, n * sizeof(*cluster)) == 0)
+        return GRAPHEME_HANDLE | id;
+    }
+  }
+
+  if (grapheme_store_full(s)) return cluster[0];
+
+  /* keep the load factor of the index below 1/2 */
+  if ((s->n_clusters + 1) * 2 > s->index_capacity) grapheme_store_rebuild_index(s, MAX(s->index_capacity * 2, 64));
+  if (s->n_clusters == s->clusters_capacity) {
+    s->clusters_capacity = s->clusters_capacity ? s->clusters_capacity * 2 : 32;
+    s->clusters = velvet_erealloc(s->clusters, s->clusters_capacity, sizeof(*s->clusters));
+  }
+  if (s->n_codepoints + n > s->codepoints_capacity) {
+    s->codepoints_capacity = MAX(s->codepoints_capacity * 2, 128);
+    s->codepoints = velvet_erealloc(s->codepoints, s->codepoints_capacity, sizeof(*s->codepoints));
+  }
+
+  uint32_t id = s->n_free ? s->free[--s->n_free] : s->n_clusters++;
+  s->clusters[id] = (struct grapheme){.offset = s->n_codepoints, .len = n, .hash = hash};
+  s->interned++;
+  memcpy(&s->codepoints[s->n_codepoints], cluster, n * sizeof(*cluster));
+  s->n_codepoints += n;
+  grapheme_store_insert_index(s, hash, id);
+  return GRAPHEME_HANDLE | id;
+}
+
+int grapheme_store_get(const struct grapheme_store *s, uint32_t value, uint32_t cluster[GRAPHEME_MAX_LENGTH]) {
+  if (!grapheme_is_handle(value)) {
+    cluster[0] = value;
+    return 1;
+  }
+  uint32_t id = value & ~GRAPHEME_HANDLE;
+  if (id >= s->n_clusters) return 0;
+  struct grapheme *g = &s->clusters[id];
+  memcpy(cluster, &s->codepoints[g->offset], g->len * sizeof(*cluster));
+  return g->len;
+}
+
+uint32_t grapheme_store_copy(struct grapheme_store *dst, const struct grapheme_store *src, uint32_t value) {
+  if (!grapheme_is_handle(value)) return value;
+  uint32_t cluster[GRAPHEME_MAX_LENGTH];
+  int n = grapheme_store_get(src, value, cluster);
+  return n ? grapheme_store_intern(dst, cluster, n) : ' ';
+}
+
+bool grapheme_store_full(const struct grapheme_store *s) {
+  return s->n_clusters >= GRAPHEME_STORE_CAPACITY && s->n_free == 0;
+}
+
+void grapheme_store_sweep(struct grapheme_store *s, const uint8_t *used) {
+  if (!s->free) s->free = velvet_calloc(GRAPHEME_STORE_CAPACITY, sizeof(*s->free));
+  s->n_free = 0;
+  /* the codepoints of the remaining clusters are compacted in place. Offsets only move down. */
+  uint32_t n_codepoints = 0;
+  for (uint32_t id = 0; id < s->n_clusters; id++) {
+    struct grapheme *g = &s->clusters[id];
+    if (g->len && used[id]) {
+      memmove(&s->codepoints[n_codepoints], &s->codepoints[g->offset], g->len * sizeof(*s->codepoints));
+      g->offset = n_codepoints;
+      n_codepoints += g->len;
+    } else {
+      g->len = 0;
+    }
+  }
+  /* trailing ids are released, the others are reused lowest first */
+  while (s->n_clusters && s->clusters[s->n_clusters - 1].len == 0) s->n_clusters--;
+  for (uint32_t id = s->n_clusters; id-- > 0;)
+    if (s->clusters[id].len == 0) s->free[s->n_free++] = id;
+  s->n_codepoints = n_codepoints;
+  s->interned = 0;
+  if (s->index_capacity) grapheme_store_rebuild_index(s, s->index_capacity);
+}
+
+void string_push_grapheme(struct string *str, const struct grapheme_store *s, uint32_t value) {
+  uint32_t cluster[GRAPHEME_MAX_LENGTH];
+  int n = grapheme_store_get(s, value, cluster);
+  for (int i = 0; i < n; i++) string_push_codepoint(str, cluster[i]);
+}
+
+void grapheme_store_clear(struct grapheme_store *s) {
+  s->n_clusters = 0;
+  s->n_codepoints = 0;
+  s->n_free = 0;
+  s->interned = 0;
+  if (s->index) memset(s->index, 0, s->index_capacity * sizeof(*s->index));
+}
+
+void grapheme_store_destroy(struct grapheme_store *s) {
+  free(s->codepoints);
+  free(s->clusters);
+  free(s->index);
+  free(s->free);
+  *s = (struct grapheme_store){0};
+}
@@ -0,0 +1,151 @@
+#include "line_arena.h"
+#include "grapheme.h"
+#include "utils.h"
+#include <stdlib.h>
+#include <string.h>
+
+static inline bool cell_equals(struct screen_cell a, struct screen_cell b) {
+  return memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+struct line_arena *line_arena_create(int w) {
+  struct line_arena *a = velvet_calloc(1, sizeof(*a));
+  a->w = w;
+  a->expanded_cells = velvet_calloc(LINE_ARENA_EXPANDED_LINES * w, sizeof(*a->expanded_cells));
+  for (int i = 0; i < LINE_ARENA_EXPANDED_LINES; i++) a->expanded[i].cells = &a->expanded_cells[i * w];
+  return a;
+}
+
+static void free_chunks(struct line_arena_chunk *c) {
+  while (c) {
+    struct line_arena_chunk *next = c->next;
+    free(c);
+    c = next;
+  }
+}
+
+void line_arena_clear(struct line_arena *a) {
+  free_chunks(a->oldest);
+  a->oldest = a->newest = NULL;
+  a->first = a->n_lines = 0;
+  a->n_cells = 0;
+}
+
+void line_arena_destroy(struct line_arena *a) {
+  if (!a) return;
+  line_arena_clear(a);
+  free(a->spare);
+  free(a->records);
+  free(a->expanded_cells);
+  free(a);
+}
+
+static struct line_arena_chunk *line_arena_reserve(struct line_arena *a, int len) {
+  if (a->newest && a->newest->used + len <= a->newest->capacity) return a->newest;
+  if (a->newest && a->newest->live == 0) {
+    a->newest->used = 0;
+    return a->newest;
+  }
+  struct line_arena_chunk *c = a->spare;
+  a->spare = NULL;
+  int capacity = MAX(LINE_ARENA_CHUNK_CELLS, a->w);
+  if (!c || c->capacity < capacity) {
+    free(c);
+    c = velvet_calloc(1, sizeof(*c) + capacity * sizeof(*c->cells));
+    c->capacity = capacity;
+  }
+  c->next = NULL;
+  c->used = c->live = 0;
+  if (a->newest) a->newest->next = c;
+  else a->oldest = c;
+  a->newest = c;
+  return c;
+}
+
+void line_arena_push(struct line_arena *a, const struct screen_line *line) {
+  if (a->n_lines == a->capacity) {
+    int capacity = MAX(a->capacity * 2, 64);
+    struct line_record *records = velvet_calloc(capacity, sizeof(*records));
+    for (int i = 0; i < a->n_lines; i++) records[i] = a->records[(a->first + i) % a->capacity];
+    free(a->records);
+    a->records = records;
+    a->capacity = capacity;
+    a->first = 0;
+  }
+
+  struct screen_cell fill = line->cells[a->w - 1];
+  int len = a->w;
+  for (; len && cell_equals(line->cells[len - 1], fill); len--);
+
+  struct line_arena_chunk *c = line_arena_reserve(a, len);
+  memcpy(&c->cells[c->used], line->cells, len * sizeof(*line->cells));
+  a->records[(a->first + a->n_lines) % a->capacity] = (struct line_record){
+      .chunk = c,
+      .offset = c->used,
+      .len = len,
+      .eol = line->eol,
+      .has_newline = line->has_newline,
+      .fill = fill,
+  };
+  c->used += len;
+  c->live++;
+  a->n_lines++;
+  a->n_cells += len;
+}
+
+void line_arena_drop_oldest(struct line_arena *a, int n) {
+  n = MIN(n, a->n_lines);
+  for (int i = 0; i < n; i++) {
+    struct line_record *r = &a->records[a->first];
+    struct line_arena_chunk *c = r->chunk;
+    a->n_cells -= r->len;
+    a->first = (a->first + 1) % a->capacity;
+    a->n_lines--;
+    /* lines are removed in the order they were added, so an empty chunk is always the oldest one */
+    if (--c->live == 0 && c != a->newest) {
+      assert(c == a->oldest);
+      a->oldest = c->next;
+      free(a->spare);
+      a->spare = c;
+    }
+  }
+}
+
+struct screen_line *line_arena_get(struct line_arena *a, int n) {
+  assert(n >= 0 && n < a->n_lines);
+  const struct line_record *r = &a->records[(a->first + n) % a->capacity];
+  struct screen_line *l = &a->expanded[a->next_expanded];
+  a->next_expanded = (a->next_expanded + 1) % LINE_ARENA_EXPANDED_LINES;
+  memcpy(l->cells, &r->chunk->cells[r->offset], r->len * sizeof(*l->cells));
+  for (int col = r->len; col < a->w; col++) l->cells[col] = r->fill;
+  l->eol = r->eol;
+  l->has_newline = r->has_newline;
+  return l;
+}
+
+void line_arena_mark_styles(const struct line_arena *a, uint8_t *used) {
+  for (int i = 0; i < a->n_lines; i++) {
+    const struct line_record *r = &a->records[(a->first + i) % a->capacity];
+    const struct screen_cell *cells = &r->chunk->cells[r->offset];
+    for (int col = 0; col < r->len; col++) used[cells[col].style] = 1;
+    used[r->fill.style] = 1;
+  }
+}
+
+void line_arena_mark_graphemes(const struct line_arena *a, uint8_t *used) {
+  for (int i = 0; i < a->n_lines; i++) {
+    const struct line_record *r = &a->records[(a->first + i) % a->capacity];
+    const struct screen_cell *cells = &r->chunk->cells[r->offset];
+    for (int col = 0; col < r->len; col++) grapheme_mark(used, cells[col].cp.value);
+    grapheme_mark(used, r->fill.cp.value);
+  }
+}
+
+void line_arena_mark_links(const struct line_arena *a, uint8_t *used) {
+  for (int i = 0; i < a->n_lines; i++) {
+    const struct line_record *r = &a->records[(a->first + i) % a->capacity];
+    const struct screen_cell *cells = &r->chunk->cells[r->offset];
+    for (int col = 0; col < r->len; col++) used[cells[col].link] = 1;
+    used[r->fill.link] = 1;
+  }
+}
@@ -0,0 +1,125 @@
+#include "lz.h"
+#include <string.h>
+
+#define LZ_HASH_BITS 13
+#define LZ_MAX_OFFSET 0xFFFF
+/* matches are not started this close to the end so the final token always carries a few literals */
+#define LZ_END_LITERALS 5
+
+static inline uint32_t read32(const uint8_t *p) {
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static inline uint64_t read64(const uint8_t *p) {
+  uint64_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static inline uint32_t lz_hash(uint32_t v) {
+  return (v * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+static uint8_t *write_length(uint8_t *dst, size_t n) {
+  for (; n >= 255; n -= 255) *dst++ = 255;
+  *dst++ = (uint8_t)n;
+  return dst;
+}
+
+static uint8_t *write_sequence(uint8_t *dst, const uint8_t *literals, size_t n_literals, size_t match, size_t offset) {
+  uint8_t *token = dst++;
+  size_t match_code = match ? match - LZ_MIN_MATCH : 0;
+  *token = (uint8_t)((n_literals < 15 ? n_literals : 15) << 4 | (match_code < 15 ? match_code : 15));
+  if (n_literals >= 15) dst = write_length(dst, n_literals - 15);
+  memcpy(dst, literals, n_literals);
+  dst += n_literals;
+  if (match) {
+    *dst++ = offset & 0xFF;
+    *dst++ = offset >> 8;
+    if (match_code >= 15) dst = write_length(dst, match_code - 15);
+  }
+  return dst;
+}
+
+size_t lz_compress(const uint8_t *src, size_t len, uint8_t *dst) {
+  /* positions + 1 of the most recent occurrence of each hashed 4 byte sequence */
+  uint32_t table[1 << LZ_HASH_BITS] = {0};
+  uint8_t *out = dst;
+  size_t anchor = 0;
+  size_t i = 0;
+  size_t misses = 0;
+
+  if (len > LZ_MIN_MATCH + LZ_END_LITERALS) {
+    size_t limit = len - LZ_END_LITERALS;
+    while (i + LZ_MIN_MATCH <= limit) {
+      uint32_t v = read32(src + i);
+      uint32_t h = lz_hash(v);
+      size_t candidate = table[h];
+      table[h] = (uint32_t)i + 1;
+      if (!candidate || i - (candidate - 1) > LZ_MAX_OFFSET || read32(src + candidate - 1) != v) {
+        /* skip ahead faster through data which does not compress */
+        i += 1 + (misses++ >> 6);
+        continue;
+      }
+      misses = 0;
+      candidate--;
+      size_t match = LZ_MIN_MATCH;
+      /* extend the match a word at a time. The first differing byte is the lowest set byte on little endian. */
+      while (i + match + sizeof(uint64_t) <= limit) {
+        uint64_t diff = read64(src + candidate + match) ^ read64(src + i + match);
+        if (diff) {
+          match += __builtin_ctzll(diff) / 8;
+          goto matched;
+        }
+        match += sizeof(uint64_t);
+      }
+      while (i + match < limit && src[candidate + match] == src[i + match]) match++;
+    matched:
+      out = write_sequence(out, src + anchor, i - anchor, match, i - candidate);
+      i += match;
+      anchor = i;
+    }
+  }
+
+  return write_sequence(out, src + anchor, len - anchor, 0, 0) - dst;
+}
+
+static bool read_length(const uint8_t **src, const uint8_t *end, size_t *n) {
+  uint8_t b;
+  do {
+    if (*src >= end) return false;
+    b = *(*src)++;
+    *n += b;
+  } while (b == 255);
+  return true;
+}
+
+bool lz_decompress(const uint8_t *src, size_t len, uint8_t *dst, size_t dst_len) {
+  const uint8_t *end = src + len;
+  size_t o = 0;
+  while (src < end) {
+    uint8_t token = *src++;
+    size_t n_literals = token >> 4;
+    if (n_literals == 15 && !read_length(&src, end, &n_literals)) return false;
+    if (n_literals > (size_t)(end - src) || n_literals > dst_len - o) return false;
+    memcpy(dst + o, src, n_literals);
+    src += n_literals;
+    o += n_literals;
+    /* the final sequence has no match */
+    if (src == end) break;
+
+    if (end - src < 2) return false;
+    size_t offset = src[0] | src[1] << 8;
+    src += 2;
+    size_t match = token & 0xF;
+    if (match == 15 && !read_length(&src, end, &match)) return false;
+    match += LZ_MIN_MATCH;
+    if (offset == 0 || offset > o || match > dst_len - o) return false;
+    /* matches may overlap the output, so copy forwards one byte at a time */
+    for (size_t k = 0; k < match; k++) dst[o + k] = dst[o + k - offset];
+    o += match;
+  }
+  return o == dst_len;
+}
@@ -50,7 +50,7 @@ static bool osc_get_id(struct osc *osc, struct u8_slice *id) {
 static bool osc_dispatch_hyperlink(struct vte *vte, struct osc *osc) {
   (void)vte;
   if (osc->pt.len == 0) {
-    vte->current_link = NULL;
+    vte->current_link = 0;
     return true;
   }
 
@@ -60,16 +60,30 @@ static bool osc_dispatch_hyperlink(struct vte *vte, struct osc *osc) {
   if (osc_get_id(osc, &id)) {
     /* we can reuse the same hyperlink object if the id is equal,
     * and the url is equal. Otherwise we must create a new hyperlink. */
-    vec_find(linkptr, vte->links, u8_slice_equals(id, hyperlink_get_id(*linkptr)));
+    vec_find(linkptr, vte->links, *linkptr && u8_slice_equals(id, hyperlink_get_id(*linkptr)));
     if (linkptr && u8_slice_equals(hyperlink_get_url(*linkptr), url)) {
-      vte->current_link = *linkptr;
+      vte->current_link = vec_index(&vte->links, linkptr) + 1;
       return true;
     }
     /* id exists, but the url does not match. We should generate a new id. */
     if (linkptr) id = (struct u8_slice){0};
   }
 
-  linkptr = vec_new_element(&vte->links);
+  /* ids of links which are no longer referenced by any cell are reused once the ids run out */
+  if (vte->links.length >= HYPERLINK_ID_MAX && vte->free_links.length == 0) vte_collect_links(vte);
+  hyperlink_id new_id;
+  if (vte->free_links.length) {
+    new_id = *(hyperlink_id *)vec_pop(&vte->free_links);
+    linkptr = vec_nth(vte->links, new_id - 1);
+  } else if (vte->links.length < HYPERLINK_ID_MAX) {
+    linkptr = vec_new_element(&vte->links);
+    new_id = vte->links.length;
+  } else {
+    ERROR("Hyperlink limit exceeded");
+    vte->current_link = 0;
+    return true;
+  }
+
   struct osc_hyperlink *link = velvet_calloc(1, sizeof(*link));
   *linkptr = link;
   if (id.content && id.len) {
@@ -81,7 +95,7 @@ static bool osc_dispatch_hyperlink(struct vte *vte, struct osc *osc) {
   }
   link->id_len = link->buffer.len;
   string_push_slice(&link->buffer, url);
-  vte->current_link = link;
+  vte->current_link = new_id;
 
   return true;
 }
@@ -101,14 +115,16 @@ static bool osc_set_icon(struct vte *vte, struct osc *osc) {
 }
 
 static bool osc_dispatch_clipboard(struct vte *vte, struct osc *osc) {
-  (void)vte;
-  if (vte->clipboard.set && osc->clipboard) {
+  /* OSC 52 is normally streamed by the parser. This handles the payload if it was buffered. */
+  if (osc->clipboard) {
     struct u8_slice b64 = osc->pt;
     if (b64.len && b64.content[0] == '?') {
       OMITTED("Clipboard query not planned.");
     }
     /* assume the payload is valid base64 and let the host emulator or callback handle it. */
-    vte->clipboard.set(b64, osc->clipboard, vte->clipboard.userdata);
+    vte_clipboard_begin(vte, osc->clipboard);
+    vte_clipboard_write(vte, b64);
+    vte_clipboard_end(vte);
   }
   return true;
 }
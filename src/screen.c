@@ -4,23 +4,257 @@
 #include <stdlib.h>
 #include <string.h>
 #include "screen.h"
+#include "scrollback.h"
+#include "line_arena.h"
+#include "grapheme.h"
 #include <wchar.h>
 
-static int num_lines(const struct screen *g) { return g->h + g->scroll.max; }
+uint64_t screen_generation;
 
-struct screen_line *screen_get_line(const struct screen *g, int n) {
-  int line = (num_lines(g) + g->scroll.offset + n) % num_lines(g);
-  assert(line < g->scroll.capacity);
-  return &g->lines[line];
+/* the number of scrollback lines in the line arena */
+static int hot_lines(const struct screen *g) { return MIN(g->scroll.max, SCREEN_HOT_LINES); }
+/* the number of screens inherited scrollback may be passed through before it is re-wrapped */
+#define SCREEN_REFLOW_MAX_DEPTH 4
+
+/* the number of scrollback lines stored by |g| itself, including re-wrapped inherited lines */
+static int stored_lines(const struct screen *g) {
+  return (g->history ? g->history->n_lines : 0) + (g->archive ? g->archive->n_lines : 0) +
+         (g->reflow.wrapped ? g->reflow.wrapped->n_lines : 0);
+}
+
+static void screen_reflow_block(struct screen *g);
+
+struct screen_line *screen_get_line(struct screen *g, int n) {
+  if (n < 0) {
+    /* recent lines are expanded from the line arena, older lines are decoded from the archive */
+    assert(n >= -g->scroll.height);
+    if (n < -stored_lines(g)) {
+      /* inherited lines are re-wrapped up to the requested line. Re-wrapping may change the height slightly. */
+      while (n < -stored_lines(g) && g->reflow.n_lines) screen_reflow_block(g);
+      n = MAX(n, -g->scroll.height);
+    }
+    int recent = g->history ? g->history->n_lines : 0;
+    if (n >= -recent) return line_arena_get(g->history, recent + n);
+    int archived = g->archive ? g->archive->n_lines : 0;
+    if (n >= -recent - archived) return scrollback_get(g->archive, archived + recent + n);
+    assert(g->reflow.wrapped && n >= -stored_lines(g));
+    return line_arena_get(g->reflow.wrapped, stored_lines(g) + n);
+  }
+  if (g->rotation.n && n >= g->rotation.top && n <= g->rotation.bottom) {
+    int region = g->rotation.bottom - g->rotation.top + 1;
+    n = g->rotation.top + (n - g->rotation.top + g->rotation.n) % region;
+  }
+  return &g->lines[(g->scroll.offset + n) % g->h];
+}
+
+struct screen_line *screen_get_view_line(struct screen *g, int n) {
+  return screen_get_line(g, n - g->scroll.view_offset);
+}
+
+/* the line under the cursor. It is only requested to modify it, so it is marked as modified. */
+static struct screen_line *get_current_line(struct screen *g) {
+  struct screen_line *l = screen_get_line(g, g->cursor.line);
+  screen_line_touch(l);
+  return l;
+}
+
+static inline void row_set_cell(struct screen_line *row, int col, struct screen_cell new_cell) {
+  row->cells[col] = new_cell;
+  row->eol = MAX(row->eol, col + 1);
+}
+
+/* fill |n| cells with |c|. Cells are 8 bytes, so the fill is a run of 64 bit stores which the compiler widens. */
+static inline void cells_fill(struct screen_cell *cells, int n, struct screen_cell c) {
+  _Static_assert(sizeof(struct screen_cell) == sizeof(uint64_t), "screen cells are filled as 64 bit words");
+  uint64_t word;
+  memcpy(&word, &c, sizeof(word));
+  if (word == 0) {
+    memset(cells, 0, n * sizeof(*cells));
+    return;
+  }
+  for (int i = 0; i < n; i++) memcpy(&cells[i], &word, sizeof(word));
+}
+
+/* set the cells from..to (exclusive) of |row| to |c| */
+static inline void row_fill(struct screen_line *row, int from, int to, struct screen_cell c) {
+  if (from >= to) return;
+  cells_fill(&row->cells[from], to - from, c);
+  row->eol = MAX(row->eol, to);
+}
+
+/* copy |n| cells from column |src_col| of |src| to column |dst_col| of |dst|. The ranges may overlap. */
+static inline void row_copy(struct screen_line *dst, int dst_col, const struct screen_line *src, int src_col, int n) {
+  if (n <= 0) return;
+  memmove(&dst->cells[dst_col], &src->cells[src_col], n * sizeof(*dst->cells));
+  dst->eol = MAX(dst->eol, dst_col + n);
+}
+
+/* move |n| cells of |row| from column |src| to column |dst| */
+static inline void row_move(struct screen_line *row, int dst, int src, int n) {
+  row_copy(row, dst, row, src, n);
+}
+
+/* before the cells of |row| from |left| are overwritten, clear a wide glyph whose second half is at |left|.
+ * The second half of a glyph which is overwritten is a blank cell, so the right edge needs no fixup. */
+static inline void row_split_wide(struct screen_line *row, int left) {
+  if (left > 0 && row->cells[left - 1].cp.is_wide) row->cells[left - 1].cp = codepoint_space;
 }
 
-struct screen_line *screen_get_view_line(const struct screen *g, int n) {
-  int line = (num_lines(g) + g->scroll.offset - g->scroll.view_offset + n) % num_lines(g);
-  return &g->lines[line];
+/* the fields of a style which are significant for equality, without padding */
+struct style_key {
+  uint32_t fg, bg;
+  uint16_t attr;
+  uint8_t fg_kind, bg_kind;
+};
+
+static uint32_t color_bits(struct color c) {
+  switch (c.kind) {
+  case VELVET_API_COLOR_KIND_TABLE: return c.c.table;
+  case VELVET_API_COLOR_KIND_RGB: return c.c.rgb.r | c.c.rgb.g << 8 | c.c.rgb.b << 16 | (uint32_t)c.c.rgb.t << 24;
+  default: return 0;
+  }
 }
 
-static struct screen_line *get_current_line(const struct screen *g) {
-  return screen_get_line(g, g->cursor.line);
+static struct style_key style_key(struct screen_cell_style s) {
+  return (struct style_key){
+      .fg = color_bits(s.fg), .bg = color_bits(s.bg), .attr = s.attr, .fg_kind = s.fg.kind, .bg_kind = s.bg.kind};
+}
+
+static bool style_key_equals(struct style_key a, struct style_key b) {
+  return a.fg == b.fg && a.bg == b.bg && a.attr == b.attr && a.fg_kind == b.fg_kind && a.bg_kind == b.bg_kind;
+}
+
+static uint32_t style_hash(struct style_key k) {
+  uint32_t h = k.fg * 0x9E3779B1u ^ k.bg * 0x85EBCA77u ^ (k.attr | k.fg_kind << 16 | k.bg_kind << 24) * 0xC2B2AE3Du;
+  return h ^ h >> 15;
+}
+
+bool screen_cell_style_equals(struct screen_cell_style a, struct screen_cell_style b) {
+  return style_key_equals(style_key(a), style_key(b));
+}
+
+static void style_table_insert_index(struct screen_style_table *t, style_id id) {
+  uint32_t mask = t->index_capacity - 1;
+  uint32_t i = style_hash(style_key(t->styles[id])) & mask;
+  for (; t->index[i]; i = (i + 1) & mask);
+  t->index[i] = id;
+}
+
+/* rebuild the index with a capacity of |capacity|, keeping the ids for which |keep| is set */
+static void style_table_rebuild_index(struct screen_style_table *t, uint32_t capacity, const uint8_t *keep) {
+  style_id *old = t->index;
+  uint32_t old_capacity = t->index_capacity;
+  t->index = velvet_calloc(capacity, sizeof(*t->index));
+  t->index_capacity = capacity;
+  for (uint32_t i = 0; i < old_capacity; i++)
+    if (old[i] && (!keep || keep[old[i]])) style_table_insert_index(t, old[i]);
+  free(old);
+}
+
+/* reclaim the ids which are not referenced by any cell of |g| */
+static void screen_collect_styles(struct screen *g) {
+  struct screen_style_table *t = &g->styles;
+  uint8_t *used = velvet_calloc(t->n_styles, sizeof(*used));
+  for (int i = 0; i < g->h * g->w; i++) used[g->cells[i].style] = 1;
+  /* inherited scrollback references the same ids since the style table was copied */
+  for (const struct screen *s = g; s; s = s->reflow.src) {
+    if (s->history) line_arena_mark_styles(s->history, used);
+    if (s->reflow.wrapped) line_arena_mark_styles(s->reflow.wrapped, used);
+    if (s->archive) scrollback_mark_styles(s->archive, used);
+  }
+  t->n_free = 0;
+  for (uint32_t id = t->n_styles - 1; id > 0; id--)
+    if (!used[id]) t->free[t->n_free++] = id;
+  style_table_rebuild_index(t, t->index_capacity, used);
+  free(used);
+  t->last_id = 0;
+}
+
+void screen_mark_graphemes(const struct screen *g, uint8_t *used) {
+  if (!g->cells) return;
+  for (int i = 0; i < g->h * g->w; i++) grapheme_mark(used, g->cells[i].cp.value);
+  for (const struct screen *s = g; s; s = s->reflow.src) {
+    if (s->history) line_arena_mark_graphemes(s->history, used);
+    if (s->reflow.wrapped) line_arena_mark_graphemes(s->reflow.wrapped, used);
+    if (s->archive) scrollback_mark_graphemes(s->archive, used);
+  }
+}
+
+void screen_mark_links(const struct screen *g, uint8_t *used) {
+  if (!g->cells) return;
+  for (int i = 0; i < g->h * g->w; i++) used[g->cells[i].link] = 1;
+  for (const struct screen *s = g; s; s = s->reflow.src) {
+    if (s->history) line_arena_mark_links(s->history, used);
+    if (s->reflow.wrapped) line_arena_mark_links(s->reflow.wrapped, used);
+    if (s->archive) scrollback_mark_links(s->archive, used);
+  }
+}
+
+style_id screen_intern_style(struct screen *g, struct screen_cell_style style) {
+  struct screen_style_table *t = &g->styles;
+  struct style_key key = style_key(style);
+  if (!key.attr && !key.fg_kind && !key.bg_kind) return 0;
+  if (t->last_id && style_key_equals(key, style_key(t->last))) return t->last_id;
+
+  uint32_t hash = style_hash(key);
+  if (t->index_capacity) {
+    uint32_t mask = t->index_capacity - 1;
+    for (uint32_t i = hash & mask; t->index[i]; i = (i + 1) & mask) {
+      if (style_key_equals(key, style_key(t->styles[t->index[i]]))) {
+        t->last = style;
+        return t->last_id = t->index[i];
+      }
+    }
+  }
+
+  if (t->n_free == 0 && t->n_styles > STYLE_ID_MAX) {
+    screen_collect_styles(g);
+    if (t->n_free == 0) {
+      ERROR("Style table exhausted");
+      return 0;
+    }
+  }
+
+  style_id id;
+  if (t->n_free) {
+    id = t->free[--t->n_free];
+  } else {
+    if (t->n_styles == 0) t->n_styles = 1;
+    if (t->n_styles >= t->capacity) {
+      t->capacity = MAX(t->capacity * 2, 64);
+      t->styles = velvet_erealloc(t->styles, t->capacity, sizeof(*t->styles));
+      t->free = velvet_erealloc(t->free, t->capacity, sizeof(*t->free));
+    }
+    id = t->n_styles++;
+  }
+  t->styles[id] = style;
+
+  /* keep the load factor below 1/2 */
+  uint32_t live = t->n_styles - t->n_free;
+  if (live * 2 > t->index_capacity) style_table_rebuild_index(t, MAX(t->index_capacity * 2, 128), NULL);
+  style_table_insert_index(t, id);
+  t->last = style;
+  return t->last_id = id;
+}
+
+static void style_table_copy(struct screen_style_table *dst, const struct screen_style_table *src) {
+  free(dst->styles);
+  free(dst->free);
+  free(dst->index);
+  *dst = *src;
+  dst->styles = velvet_calloc(MAX(src->capacity, 1), sizeof(*dst->styles));
+  dst->free = velvet_calloc(MAX(src->capacity, 1), sizeof(*dst->free));
+  dst->index = velvet_calloc(MAX(src->index_capacity, 1), sizeof(*dst->index));
+  if (src->n_styles) memcpy(dst->styles, src->styles, src->n_styles * sizeof(*dst->styles));
+  if (src->n_free) memcpy(dst->free, src->free, src->n_free * sizeof(*dst->free));
+  if (src->index_capacity) memcpy(dst->index, src->index, src->index_capacity * sizeof(*dst->index));
+}
+
+static void style_table_destroy(struct screen_style_table *t) {
+  free(t->styles);
+  free(t->free);
+  free(t->index);
+  *t = (struct screen_style_table){0};
 }
 
 int screen_left(const struct screen *g) {
@@ -43,12 +277,8 @@ void screen_clear_line(struct screen *g, int n) {
   assert(row->cells);
   row->has_newline = false;
   row->eol = 0;
-  memset(row->cells, 0, g->w * sizeof(struct screen_cell));
-  if (g->cursor.brush.attr | g->cursor.brush.fg.kind | g->cursor.brush.bg.kind) {
-    for (int i = 0; i < g->w; i++) {
-      row->cells[i].style = g->cursor.brush;
-    }
-  }
+  screen_line_touch(row);
+  cells_fill(row->cells, g->w, (struct screen_cell){.style = screen_intern_style(g, g->cursor.brush)});
 }
 
 void screen_set_cursor_row(struct screen *g, int y) {
@@ -71,16 +301,38 @@ void screen_move_cursor_relative(struct screen *g, int x, int y) {
   screen_set_cursor_position(g, g->cursor.column + x, g->cursor.line + y);
 }
 
-static void screen_swap_rows(struct screen *g, int r1, int r2) {
-  if (r1 != r2) {
-    struct screen_line *l1 = screen_get_line(g, r1);
-    struct screen_line *l2 = screen_get_line(g, r2);
+/* reverse the order of the rows top..bottom, ignoring the rotation of the scroll region */
+static void screen_reverse_rows(struct screen *g, int top, int bottom) {
+  for (; top < bottom; top++, bottom--) {
+    struct screen_line *l1 = &g->lines[(g->scroll.offset + top) % g->h];
+    struct screen_line *l2 = &g->lines[(g->scroll.offset + bottom) % g->h];
     struct screen_line tmp = *l1;
     *l1 = *l2;
     *l2 = tmp;
   }
 }
 
+/* move the rows of the rotated region to their natural position */
+static void screen_normalize_rows(struct screen *g) {
+  if (!g->rotation.n) return;
+  int top = g->rotation.top, bottom = g->rotation.bottom;
+  int split = top + g->rotation.n;
+  screen_reverse_rows(g, top, split - 1);
+  screen_reverse_rows(g, split, bottom);
+  screen_reverse_rows(g, top, bottom);
+  g->rotation.n = 0;
+}
+
+/* rotate the rows top..bottom by |count| rows. Positive counts move rows up. Consecutive rotations of the same
+ * region only update the rotation of the region. */
+static void screen_rotate_rows(struct screen *g, int count, int top, int bottom) {
+  if (g->rotation.n && (g->rotation.top != top || g->rotation.bottom != bottom)) screen_normalize_rows(g);
+  int region = bottom - top + 1;
+  g->rotation.top = top;
+  g->rotation.bottom = bottom;
+  g->rotation.n = ((g->rotation.n + count) % region + region) % region;
+}
+
 int screen_calc_line_height(struct screen *s, int width) {
   if (width <= s->w) return 1;
   return (width + s->w - 1) / s->w;
@@ -150,7 +402,8 @@ void screen_move_or_scroll_down(struct screen *g) {
   struct cursor *c = &g->cursor;
   if (c->line == g->margins.bottom) {
     screen_shuffle_rows_up(g, 1, g->margins.top, g->margins.bottom);
-  } else {
+  } else if (c->line < g->h - 1) {
+    // the cursor does not move past the last line when it is below the scroll region
     c->line = c->line + 1;
   }
   assert(c->line < g->h);
@@ -173,18 +426,13 @@ void screen_save_cursor(struct screen *g) {
   g->saved_cursor = g->cursor;
 }
 
-static inline void row_set_cell(struct screen_line *row, int col, struct screen_cell new_cell) {
-  row->cells[col] = new_cell;
-  row->eol = MAX(row->eol, col + 1);
-}
-
 bool cell_wide(struct screen_cell c) {
   return c.cp.is_wide;
 }
 
-static void screen_insert_batch_ascii_wrapless(struct screen *g, struct screen_cell_style brush, struct u8_slice run, hyperlink_handle link) {
+static void screen_insert_batch_ascii_wrapless(struct screen *g, style_id style, struct u8_slice run, hyperlink_id link) {
   struct cursor *cur = &g->cursor;
-  struct screen_cell c = {.style = brush, .link = link};
+  struct screen_cell c = {.style = style, .link = link};
   struct screen_line *row = get_current_line(g);
   int rem = MIN((int)run.len, screen_right(g) - cur->column);
 
@@ -203,17 +451,17 @@ static void screen_insert_batch_ascii_wrapless(struct screen *g, struct screen_c
   cur->column = MIN(cur->column, screen_right(g));
 }
 
-void screen_insert_ascii_run(struct screen *g, struct screen_cell_style brush, struct u8_slice run, bool wrap, hyperlink_handle link) {
+void screen_insert_ascii_run(struct screen *g, style_id style, struct u8_slice run, bool wrap, hyperlink_id link) {
   if (run.len == 0) return;
 
   if (!wrap) {
     /* if wrapping is disabled, we can take even more shortcuts */
-    screen_insert_batch_ascii_wrapless(g, brush, run, link);
+    screen_insert_batch_ascii_wrapless(g, style, run, link);
     return;
   }
 
   int column = g->cursor.column;
-  struct screen_cell c = {.style = brush, .link = link};
+  struct screen_cell c = {.style = style, .link = link};
   if (g->cursor.wrap_pending) {
     screen_move_or_scroll_down(g);
     column = 0;
@@ -311,32 +559,85 @@ void screen_insert(struct screen *g, struct screen_cell c, bool wrap) {
   else screen_insert_impl(g, c, false);
 }
 
-static void scrollback_init(struct screen *g, int min_cap) {
-  assert(g->scroll.capacity < num_lines(g));
-  int initial_size = g->scroll.capacity;
-  int new_size = CLAMP(g->scroll.capacity * 2, min_cap, num_lines(g));
-  assert(new_size > initial_size);
-  assert(new_size <= num_lines(g));
-  g->cells = velvet_erealloc(g->cells, new_size * g->w, sizeof(*g->cells));
-  g->lines = velvet_erealloc(g->lines, new_size, sizeof(*g->lines));
-  g->scroll.capacity = new_size;
-
-  for (int i = 0; i < initial_size; i++)
-    g->lines[i].cells = &g->cells[i * g->w];
-
-  struct screen_cell clear_cell = { .style = g->cursor.brush, .cp = codepoint_space };
-  for (int i = initial_size; i < new_size; i++) {
-    struct screen_line *l = &g->lines[i];
-    *l = (struct screen_line){
-        .has_newline = false,
-        .eol = 0,
-        .cells = &g->cells[i * g->w],
-    };
-    for (int j = 0; j < g->w; j++) {
-      l->cells[j] = clear_cell;
+void screen_insert_repeated(struct screen *g, struct screen_cell c, int n, bool wrap) {
+  if (n <= 0) return;
+  if (cell_wide(c)) {
+    for (int i = 0; i < n; i++) screen_insert(g, c, wrap);
+    return;
+  }
+  /* the first cell resolves a pending wrap and clears a wide glyph preceding the cursor */
+  screen_insert(g, c, wrap);
+  n--;
+  struct cursor *cur = &g->cursor;
+  while (n > 0) {
+    if (cur->wrap_pending) {
+      /* without wrapping, the remaining cells would overwrite the last column with the same cell */
+      if (!wrap) return;
+      screen_insert(g, c, wrap);
+      n--;
+      continue;
+    }
+    int k = MIN(n, g->w - cur->column);
+    row_fill(get_current_line(g), cur->column, cur->column + k, c);
+    cur->column += k;
+    n -= k;
+    if (cur->column > screen_right(g)) {
+      cur->wrap_pending = true;
+      cur->column = screen_right(g);
     }
   }
+}
+
+struct screen_cell *screen_get_previous_glyph(struct screen *g, int *column) {
+  struct screen_line *row = get_current_line(g);
+  /* while a wrap is pending, the cursor is still on the last glyph */
+  int col = g->cursor.wrap_pending ? g->cursor.column : g->cursor.column - 1;
+  if (col < 0) return NULL;
+  /* step over the continuation of a wide glyph */
+  if (col > 0 && row->cells[col - 1].cp.is_wide) col--;
+  *column = col;
+  return &row->cells[col];
+}
+
+void screen_widen_glyph(struct screen *g, int column) {
+  struct cursor *cur = &g->cursor;
+  /* the glyph can only grow into the cell under the cursor */
+  if (cur->wrap_pending || cur->column != column + 1) return;
+  struct screen_line *row = get_current_line(g);
+  row->cells[column].cp.is_wide = true;
+  struct screen_cell clear = row->cells[column];
+  clear.cp = codepoint_space;
+  row_set_cell(row, cur->column++, clear);
+  if (cur->column > screen_right(g)) {
+    cur->wrap_pending = true;
+    cur->column = screen_right(g);
+  }
+}
 
+/* insert a run of glyphs with resolved widths. Glyphs which fit on the current row are
+ * committed directly. Pending wraps and glyphs touching the right edge go through screen_insert. */
+void screen_insert_run(struct screen *g, style_id style, const struct codepoint *run, int n, bool wrap, hyperlink_id link) {
+  struct screen_cell c = {.style = style, .link = link};
+  struct screen_cell clear = c;
+  clear.cp = codepoint_space;
+
+  for (int i = 0; i < n;) {
+    c.cp = run[i++];
+    screen_insert(g, c, wrap);
+    if (g->cursor.wrap_pending) continue;
+
+    struct screen_line *row = get_current_line(g);
+    int column = g->cursor.column;
+    for (; i < n; i++) {
+      int width = run[i].is_wide ? 2 : 1;
+      if (column + width >= g->w) break;
+      c.cp = run[i];
+      row->cells[column++] = c;
+      if (width > 1) row->cells[column++] = clear;
+    }
+    row->eol = MAX(row->eol, column);
+    g->cursor.column = column;
+  }
 }
 
 void screen_initialize(struct screen *g, int w, int h) {
@@ -344,8 +645,14 @@ void screen_initialize(struct screen *g, int w, int h) {
   assert(!g->lines);
   g->h = h;
   g->w = w;
-  /* if scrollback is enabled, pre-allocate a couple of lines */
-  scrollback_init(g, g->scroll.max ? h * 2 : h);
+  struct screen_cell clear_cell = { .style = screen_intern_style(g, g->cursor.brush), .cp = codepoint_space };
+  g->cells = velvet_calloc(h * w, sizeof(*g->cells));
+  g->lines = velvet_calloc(h, sizeof(*g->lines));
+  for (int i = 0; i < h; i++) {
+    g->lines[i].cells = &g->cells[i * w];
+    for (int j = 0; j < w; j++) g->lines[i].cells[j] = clear_cell;
+    screen_line_touch(&g->lines[i]);
+  }
   screen_reset_scroll_region(g);
 }
 
@@ -376,16 +683,59 @@ void screen_erase_rectangle(struct screen *g, int top, int left, int bottom, int
   for (int r = top; r <= bottom; r++) {
     struct cursor from = { .line = r, .column = left };
     struct cursor to = { .line = r, .column = right };
+    row_split_wide(screen_get_line(g, r), left);
     screen_erase_between_cursors(g, from, to);
   }
 }
 
+/* inclusive fill rectangle */
+void screen_fill_rectangle(struct screen *g, int top, int left, int bottom, int right, struct screen_cell c) {
+  top = CLAMP(top, 0, g->h - 1);
+  bottom = CLAMP(bottom, 0, g->h - 1);
+  left = CLAMP(left, 0, g->w - 1);
+  right = CLAMP(right, 0, g->w - 1);
+  if (bottom < top || right < left) return;
+  for (int r = top; r <= bottom; r++) {
+    struct screen_line *row = screen_get_line(g, r);
+    screen_line_touch(row);
+    row_split_wide(row, left);
+    row_fill(row, left, right + 1, c);
+  }
+}
+
+/* inclusive copy rectangle. The source and destination may overlap. */
+void screen_copy_rectangle(struct screen *g, int top, int left, int bottom, int right, int dst_top, int dst_left) {
+  top = CLAMP(top, 0, g->h - 1);
+  bottom = CLAMP(bottom, 0, g->h - 1);
+  left = CLAMP(left, 0, g->w - 1);
+  right = CLAMP(right, 0, g->w - 1);
+  if (bottom < top || right < left || dst_top < 0 || dst_left < 0 || dst_top >= g->h || dst_left >= g->w) return;
+  /* the part of the rectangle which does not fit at the destination is not copied */
+  int height = MIN(bottom - top + 1, g->h - dst_top);
+  int width = MIN(right - left + 1, g->w - dst_left);
+  int dst_right = dst_left + width - 1;
+
+  /* copy rows in the direction of the move so overlapping rows are read before they are overwritten */
+  bool down = dst_top > top;
+  for (int i = 0; i < height; i++) {
+    int r = down ? height - 1 - i : i;
+    struct screen_line *src = screen_get_line(g, top + r);
+    struct screen_line *dst = screen_get_line(g, dst_top + r);
+    screen_line_touch(dst);
+    row_split_wide(dst, dst_left);
+    row_copy(dst, dst_left, src, left, width);
+    /* a wide glyph whose second half is outside the rectangle is split */
+    if (dst->cells[dst_right].cp.is_wide) dst->cells[dst_right].cp = codepoint_space;
+  }
+}
+
 /* inclusive erase between two cursor positions */
 void screen_erase_between_cursors(struct screen *g, struct cursor from, struct cursor to) {
-  struct screen_cell template = { .cp = codepoint_space, .style = g->cursor.brush };
+  struct screen_cell template = { .cp = codepoint_space, .style = screen_intern_style(g, g->cursor.brush) };
 
   for (int r = from.line; r <= to.line; r++) {
     struct screen_line *row = screen_get_line(g, r);
+    screen_line_touch(row);
     int col_start = r == from.line ? from.column : 0;
     int col_end = r == to.line ? to.column : screen_right(g);
     // We subtract 1 from eol because it refers to the number of significant characters.
@@ -393,10 +743,7 @@ void screen_erase_between_cursors(struct screen *g, struct cursor from, struct c
     int eol = MAX(0, row->eol - 1);
     col_end = MIN(col_end, screen_right(g));
 
-
-    for (int i = col_start; i <= col_end; i++) {
-      row_set_cell(row, i, template);
-    }
+    row_fill(row, col_start, col_end + 1, template);
 
     // if a delete command deletes the end of the line, clear the newline flag.
     // this fixes subtle wrapping issues when shell prompts become narrow enough to span multiple lines.
@@ -413,42 +760,351 @@ void screen_erase_between_cursors(struct screen *g, struct cursor from, struct c
 }
 
 void screen_insert_blanks_at_cursor(struct screen *g, int n) {
-  struct screen_cell template = {.cp = codepoint_space, .style = g->cursor.brush};
+  struct screen_cell template = {.cp = codepoint_space, .style = screen_intern_style(g, g->cursor.brush)};
   struct screen_line *row = get_current_line(g);
   int lcol = g->cursor.column;
-  for (int col = screen_right(g); col >= lcol; col--) {
-    int rcol = col - n;
-    struct screen_cell replacement = rcol < lcol ? template : row->cells[rcol];
-    row_set_cell(row, col, replacement);
-  }
+  n = MIN(n, g->w - lcol);
+  row_move(row, lcol + n, lcol, g->w - lcol - n);
+  row_fill(row, lcol, lcol + n, template);
   if (row->eol > lcol) row->eol = MIN(row->eol + n, g->w);
 }
 
 void screen_shift_from_cursor(struct screen *g, int n) {
   if (n == 0) return;
-  struct screen_cell template = { .cp = codepoint_space, .style = g->cursor.brush };
+  struct screen_cell template = { .cp = codepoint_space, .style = screen_intern_style(g, g->cursor.brush) };
   struct screen_line *row = get_current_line(g);
-  for (int col = g->cursor.column; col <= screen_right(g); col++) {
-    int rcol = col + n;
-    struct screen_cell replacement = rcol > screen_right(g) ? template : row->cells[rcol];
-    row_set_cell(row, col, replacement);
-  }
-  if (row->eol > g->cursor.column) row->eol = MAX(0, row->eol - n);
+  int col = g->cursor.column;
+  int kept = MAX(0, g->w - col - n);
+  row_move(row, col, col + n, kept);
+  row_fill(row, col + kept, g->w, template);
+  if (row->eol > col) row->eol = MAX(col, row->eol - n);
 }
 void screen_carriage_return(struct screen *g) {
   screen_set_cursor_column(g, 0);
 }
+static void screen_release_reflow(struct screen *g) {
+  if (g->reflow.src) {
+    screen_destroy(g->reflow.src);
+    free(g->reflow.src);
+  }
+  line_arena_destroy(g->reflow.wrapped);
+  memset(&g->reflow, 0, sizeof(g->reflow));
+}
+
 void screen_destroy(struct screen *screen) {
   free(screen->cells);
   free(screen->lines);
+  style_table_destroy(&screen->styles);
+  line_arena_destroy(screen->history);
+  scrollback_destroy(screen->archive);
+  free(screen->index.lines);
+  screen_release_reflow(screen);
   screen->cells = NULL;
   screen->lines = NULL;
+  screen->history = NULL;
+  screen->archive = NULL;
+  memset(&screen->index, 0, sizeof(screen->index));
+}
+
+void screen_clear_scrollback(struct screen *g) {
+  g->scroll.height = 0;
+  g->scroll.view_offset = 0;
+  if (g->history) line_arena_clear(g->history);
+  if (g->archive) scrollback_clear(g->archive);
+  screen_release_reflow(g);
+  g->index.first = g->index.n = 0;
+  g->index.open = false;
 }
 
-static bool cursor_equals(struct cursor c1, struct cursor c2) { return c1.column == c2.column && c1.line == c2.line; }
 static bool cell_empty(struct screen_cell c) { return c.cp.value == 0 || c.cp.value == ' '; }
 
-void screen_copy_primary(struct screen *restrict dst, const struct screen *restrict src) {
+/* the number of cells of |l| which are re-wrapped. If the line contains an explicit newline, trailing whitespace
+ * is discarded. This is somewhat destructive if the cell background has meaningful styling, but this appears to
+ * be how most emulators handle wrapping. Note that whitespace is always significant if the line does not have an
+ * explicit newline since it is then considered the same logical line as the next line. */
+static int line_reflow_eol(const struct screen_line *l) {
+  int eol = l->eol;
+  if (l->has_newline) {
+    for (; eol && cell_empty(l->cells[eol - 1]); eol--);
+  }
+  return eol;
+}
+
+/* the number of lines a logical line of |cells| cells occupies at width |w| */
+static int logical_rows(uint32_t cells, int w) {
+  return cells ? (int)((cells + w - 1) / w) : 1;
+}
+
+static struct logical_line *index_get(const struct screen *g, int i) {
+  return &g->index.lines[(g->index.first + i) % g->index.capacity];
+}
+
+static void index_append(struct screen *g, struct logical_line l) {
+  if (g->index.n == g->index.capacity) {
+    int capacity = MAX(g->index.capacity * 2, 64);
+    struct logical_line *lines = velvet_calloc(capacity, sizeof(*lines));
+    for (int i = 0; i < g->index.n; i++) lines[i] = *index_get(g, i);
+    free(g->index.lines);
+    g->index.lines = lines;
+    g->index.capacity = capacity;
+    g->index.first = 0;
+  }
+  *index_get(g, g->index.n++) = l;
+}
+
+static void index_drop_oldest(struct screen *g) {
+  g->index.first = (g->index.first + 1) % g->index.capacity;
+  if (--g->index.n == 0) g->index.open = false;
+}
+
+/* append |line| to the scrollback. screen_trim_history must be called afterwards. */
+static void screen_push_history(struct screen *g, const struct screen_line *line) {
+  if (!g->history) g->history = line_arena_create(g->w);
+  line_arena_push(g->history, line);
+  uint32_t cells = line_reflow_eol(line);
+  if (g->index.open) {
+    struct logical_line *l = index_get(g, g->index.n - 1);
+    l->cells += cells;
+    l->rows++;
+  } else {
+    index_append(g, (struct logical_line){.cells = cells, .rows = 1});
+  }
+  g->index.open = !line->has_newline;
+}
+
+/* the archive of |g|, which is created on demand */
+static struct scrollback *screen_archive(struct screen *g) {
+  if (!g->archive) {
+    g->archive = scrollback_create(g->w);
+    if (g->scroll.spill && !scrollback_set_spill(g->archive, true)) g->scroll.spill = false;
+  }
+  return g->archive;
+}
+
+/* move re-wrapped inherited lines to the front of the archive. Lines are moved in whole blocks, so the oldest lines
+ * are held back until they fill a block. Once no inherited lines remain they are moved as a partial first block and
+ * the inherited scrollback is released. */
+static void screen_store_reflowed(struct screen *g) {
+  struct line_arena *wrapped = g->reflow.wrapped;
+  int n = wrapped ? wrapped->n_lines : 0;
+  int keep = g->reflow.n_lines ? n % SCROLLBACK_BLOCK_LINES : 0;
+  if (n > keep) {
+    /* a partial block is padded at its start, and the padding is dropped again */
+    int padding = (SCROLLBACK_BLOCK_LINES - (n - keep) % SCROLLBACK_BLOCK_LINES) % SCROLLBACK_BLOCK_LINES;
+    struct scrollback *blocks = scrollback_create(g->w);
+    struct screen_line blank = {.cells = velvet_calloc(g->w, sizeof(*blank.cells))};
+    for (int i = 0; i < padding; i++) scrollback_push(blocks, &blank);
+    free(blank.cells);
+    for (int i = keep; i < n; i++) scrollback_push(blocks, line_arena_get(wrapped, i));
+    scrollback_drop_oldest(blocks, padding);
+    scrollback_prepend(screen_archive(g), blocks);
+    scrollback_destroy(blocks);
+
+    g->reflow.wrapped = NULL;
+    if (keep) {
+      g->reflow.wrapped = line_arena_create(g->w);
+      for (int i = 0; i < keep; i++) line_arena_push(g->reflow.wrapped, line_arena_get(wrapped, i));
+    }
+    line_arena_destroy(wrapped);
+  }
+  if (!g->reflow.n_lines) screen_release_reflow(g);
+}
+
+/* drop the |n| oldest lines stored by |g| itself */
+static void screen_drop_stored(struct screen *g, int n) {
+  assert(g->reflow.n_lines == 0);
+  int archived = g->archive ? g->archive->n_lines : 0;
+  if (archived) scrollback_drop_oldest(g->archive, MIN(n, archived));
+  if (n > archived) line_arena_drop_oldest(g->history, n - archived);
+  while (n > 0 && g->index.n) {
+    struct logical_line *l = index_get(g, 0);
+    int rows = MIN(n, (int)l->rows);
+    l->rows -= rows;
+    l->cells -= MIN(l->cells, (uint32_t)(rows * g->w));
+    n -= rows;
+    if (l->rows == 0) index_drop_oldest(g);
+  }
+}
+
+/* drop the oldest logical line of the scrollback of |g| */
+static void screen_drop_logical_line(struct screen *g) {
+  struct logical_line *l = index_get(g, 0);
+  if (g->reflow.n_lines) {
+    screen_drop_logical_line(g->reflow.src);
+    g->reflow.height -= logical_rows(l->cells, g->w);
+    g->reflow.skip = 0;
+    index_drop_oldest(g);
+    if (--g->reflow.n_lines == 0) screen_store_reflowed(g);
+  } else {
+    screen_drop_stored(g, l->rows);
+  }
+  g->scroll.height = g->reflow.height + stored_lines(g);
+}
+
+/* drop lines beyond the scrollback limit, oldest first, and move lines beyond the line arena limit to the archive */
+static void screen_trim_history(struct screen *g) {
+  int excess = g->reflow.height + stored_lines(g) - g->scroll.max;
+  /* inherited lines are the oldest */
+  while (excess > 0 && g->reflow.n_lines) {
+    struct logical_line *l = index_get(g, 0);
+    int rows = logical_rows(l->cells, g->w);
+    if (rows > excess) {
+      /* drop the start of the logical line. It is skipped when the line is re-wrapped. */
+      l->cells -= excess * g->w;
+      g->reflow.skip += excess * g->w;
+      g->reflow.height -= excess;
+      excess = 0;
+    } else {
+      screen_drop_logical_line(g);
+      excess -= rows;
+    }
+  }
+  if (excess > 0) screen_drop_stored(g, excess);
+
+  int hot = hot_lines(g);
+  int recent = g->history ? g->history->n_lines : 0;
+  if (recent > hot) {
+    struct scrollback *archive = screen_archive(g);
+    for (int i = 0; i < recent - hot; i++) scrollback_push(archive, line_arena_get(g->history, i));
+    line_arena_drop_oldest(g->history, recent - hot);
+  }
+  g->scroll.height = g->reflow.height + stored_lines(g);
+  g->scroll.view_offset = MIN(g->scroll.view_offset, g->scroll.height);
+}
+
+void screen_set_scrollback_limit(struct screen *g, int max, bool spill) {
+  g->scroll.max = max;
+  g->scroll.spill = spill;
+  screen_trim_history(g);
+  if (g->archive && !scrollback_set_spill(g->archive, spill)) g->scroll.spill = false;
+}
+
+void screen_compress_history(struct screen *g) {
+  if (g->history && g->history->n_lines) {
+    struct scrollback *archive = screen_archive(g);
+    for (int i = 0; i < g->history->n_lines; i++) scrollback_push(archive, line_arena_get(g->history, i));
+    line_arena_destroy(g->history);
+    g->history = NULL;
+  }
+  if (g->archive) scrollback_release_cache(g->archive);
+  if (g->reflow.src) screen_compress_history(g->reflow.src);
+}
+
+void screen_drop_scrollback(struct screen *g, int n) {
+  int max = g->scroll.max;
+  g->scroll.max = MAX(0, g->scroll.height - n);
+  screen_trim_history(g);
+  g->scroll.max = max;
+}
+
+static void line_arena_get_memory(const struct line_arena *a, struct screen_memory *m) {
+  for (const struct line_arena_chunk *c = a->oldest; c; c = c->next) m->cells += c->capacity * sizeof(*c->cells);
+  if (a->spare) m->cells += a->spare->capacity * sizeof(*a->spare->cells);
+  m->cells += LINE_ARENA_EXPANDED_LINES * a->w * sizeof(*a->expanded_cells);
+  m->lines += a->capacity * sizeof(*a->records);
+}
+
+struct screen_memory screen_get_memory(const struct screen *g) {
+  struct screen_memory m = {0};
+  if (!g->cells) return m;
+  m.cells = (size_t)g->w * g->h * sizeof(*g->cells);
+  m.lines = g->h * sizeof(*g->lines) + g->index.capacity * sizeof(*g->index.lines);
+  m.styles = g->styles.capacity * sizeof(*g->styles.styles) + g->styles.index_capacity * sizeof(*g->styles.index);
+  if (g->history) line_arena_get_memory(g->history, &m);
+  if (g->reflow.wrapped) line_arena_get_memory(g->reflow.wrapped, &m);
+  if (g->archive) m.scrollback = scrollback_get_stats(g->archive).heap_bytes;
+  if (g->reflow.src) {
+    struct screen_memory inherited = screen_get_memory(g->reflow.src);
+    m.cells += inherited.cells;
+    m.lines += inherited.lines;
+    m.styles += inherited.styles;
+    m.scrollback += inherited.scrollback;
+  }
+  return m;
+}
+
+static void screen_insert_cells(struct screen *g, const struct screen_line *l, int from, int eol) {
+  for (int col = from; col < eol; col += l->cells[col].cp.is_wide ? 2 : 1) screen_insert(g, l->cells[col], true);
+}
+
+/* re-wrap the newest inherited logical lines of |g| until the re-wrapped lines fill a block of the archive */
+static void screen_reflow_block(struct screen *g) {
+  assert(g->reflow.n_lines);
+  struct screen *src = g->reflow.src;
+  int n_wrapped = g->reflow.wrapped ? g->reflow.wrapped->n_lines : 0;
+  int first = g->reflow.n_lines;
+  for (int rows = n_wrapped; first > 0 && rows < SCROLLBACK_BLOCK_LINES; first--)
+    rows += logical_rows(index_get(g, first - 1)->cells, g->w);
+
+  /* the lines are read from |src|, which re-wraps its own inherited lines as far as needed. The lines of |src|
+   * after its inherited lines are stored, so the row of a logical line follows from the rows of its predecessors. */
+  while (src->reflow.n_lines > first) screen_reflow_block(src);
+  int row = -stored_lines(src);
+  for (int i = src->reflow.n_lines; i < first; i++) row += index_get(src, i)->rows;
+
+  /* re-wrap the lines on a screen of the same width and collect them from its scrollback */
+  struct screen tmp = {.scroll.max = SCREEN_SCROLLBACK_UNLIMITED, .scroll.spill = g->scroll.spill};
+  screen_initialize(&tmp, g->w, g->h);
+  int skip = first ? 0 : g->reflow.skip;
+  for (int i = first; i < g->reflow.n_lines; i++) {
+    struct logical_line *line = index_get(g, i);
+    int start = stored_lines(&tmp) + tmp.cursor.line;
+    for (int rows = index_get(src, i)->rows; rows; rows--, row++) {
+      const struct screen_line *l = screen_get_line(src, row);
+      int eol = line_reflow_eol(l);
+      int from = MIN(skip, eol);
+      skip -= from;
+      if (from > 0 && from < eol && l->cells[from - 1].cp.is_wide) from++;
+      screen_insert_cells(&tmp, l, from, eol);
+      if (l->has_newline) screen_newline(&tmp, true);
+    }
+    g->reflow.height -= logical_rows(line->cells, g->w);
+    line->rows = stored_lines(&tmp) + tmp.cursor.line - start;
+  }
+  int n_populated = tmp.cursor.line + (screen_get_line(&tmp, tmp.cursor.line)->eol > 0);
+  index_get(g, g->reflow.n_lines - 1)->rows += n_populated - tmp.cursor.line;
+
+  struct line_arena *wrapped = line_arena_create(g->w);
+  for (int i = -stored_lines(&tmp); i < n_populated; i++) line_arena_push(wrapped, screen_get_line(&tmp, i));
+  for (int i = 0; i < n_wrapped; i++) line_arena_push(wrapped, line_arena_get(g->reflow.wrapped, i));
+  screen_destroy(&tmp);
+  line_arena_destroy(g->reflow.wrapped);
+  g->reflow.wrapped = wrapped;
+  g->reflow.n_lines = first;
+  screen_store_reflowed(g);
+  screen_trim_history(g);
+}
+
+void screen_reflow_scrollback(struct screen *g) {
+  while (g->reflow.n_lines) screen_reflow_block(g);
+}
+
+static bool cursor_equals(struct cursor c1, struct cursor c2) { return c1.column == c2.column && c1.line == c2.line; }
+
+void screen_snapshot(struct screen *restrict dst, struct screen *restrict src) {
+  if (dst->w != src->w || dst->h != src->h) {
+    screen_destroy(dst);
+    *dst = (struct screen){0};
+    screen_initialize(dst, src->w, src->h);
+  }
+  for (int i = 0; i < src->h; i++) {
+    struct screen_line *from = screen_get_view_line(src, i);
+    struct screen_line *to = screen_get_line(dst, i);
+    memcpy(to->cells, from->cells, src->w * sizeof(*to->cells));
+    to->eol = from->eol;
+    to->has_newline = from->has_newline;
+    screen_line_touch(to);
+  }
+  style_table_copy(&dst->styles, &src->styles);
+  dst->margins = src->margins;
+  dst->cursor = src->cursor;
+  /* the cursor is relative to the live screen, which may be scrolled */
+  dst->cursor.line += src->scroll.view_offset;
+}
+
+void screen_copy_primary(struct screen *restrict dst, struct screen *restrict src) {
+  /* cells are copied verbatim, so they keep referencing the same style ids */
+  style_table_copy(&dst->styles, &src->styles);
   struct {
     struct cursor dst;      /* recorded cursor position */
     struct cursor src;      /* reference cursor */
@@ -471,21 +1127,39 @@ void screen_copy_primary(struct screen *restrict dst, const struct screen *restr
     if (s->eol > 0 || s->has_newline) n_populated = row + 1;
   }
 
-  int n_src_lines = src->scroll.height + n_populated;
+  /* inherited scrollback is re-wrapped in one go if it would otherwise form a long chain of screens */
+  int depth = 0;
+  for (const struct screen *s = src; s->reflow.src; s = s->reflow.src) depth++;
+  if (depth >= SCREEN_REFLOW_MAX_DEPTH) screen_reflow_scrollback(src);
+
+  /* re-wrap a margin of scrollback lines along with the screen. The margin ends at the start of a logical line,
+   * so it includes the line which continues onto the screen. A screen which already inherits scrollback usually
+   * only stores the margin of the previous resize, which is re-wrapped entirely so sequences of resizes do not
+   * grow the chain. */
+  int margin_limit = dst->h;
+  if (src->reflow.n_lines && stored_lines(src) <= 2 * dst->h) margin_limit = INT_MAX;
+  int n_inherited = src->index.n;
+  int margin = 0;
+  while (n_inherited > src->reflow.n_lines && margin < margin_limit) margin += index_get(src, --n_inherited)->rows;
+
+  /* the remaining logical lines are only measured */
+  for (int i = 0; i < n_inherited; i++) {
+    uint32_t cells = index_get(src, i)->cells;
+    index_append(dst, (struct logical_line){.cells = cells});
+    dst->reflow.height += logical_rows(cells, dst->w);
+  }
+  dst->reflow.n_lines = n_inherited;
+  dst->scroll.height = dst->reflow.height;
+  /* nothing is dropped until the inherited lines are in place */
+  int max = dst->scroll.max;
+  dst->scroll.max = SCREEN_SCROLLBACK_UNLIMITED;
+
+  int n_src_lines = margin + n_populated;
 
   for (int row = 0; row < n_src_lines; row++) {
-    int real_row = row - src->scroll.height;
+    int real_row = row - margin;
     struct screen_line *s = screen_get_line(src, real_row);
-    int eol = s->eol;
-
-    /* if the line contains an explicit newline, discard trailing whitespace.
-     * this is somewhat destructive if the cell background has meaningful styling, but
-     * this appears to be how most emulators handle wrapping. Note that whitespace
-     * is always significant if the line does not have an explicit newline since it is then considered 
-     * the same logical line as the next line. */
-    if (s->has_newline) {
-      for (; eol && cell_empty(s->cells[eol - 1]); eol--);
-    }
+    int eol = line_reflow_eol(s);
 
     /* if this line contains a cursor, include trailing characters until the cursor.
      * otherwise we will not be able to record the cursor position */
@@ -517,11 +1191,36 @@ void screen_copy_primary(struct screen *restrict dst, const struct screen *restr
     if (cursors[i].dst.column != -1) 
       *cursors[i].dst_ptr = cursors[i].dst;
   }
+
+  /* hand the inherited lines to |dst| */
+  if (n_inherited > src->reflow.n_lines) {
+    struct screen *from = velvet_calloc(1, sizeof(*from));
+    *from = *src;
+    from->cells = NULL;
+    from->lines = NULL;
+    from->styles = (struct screen_style_table){0};
+    /* lines are only dropped by the screen which inherits them */
+    from->scroll.max = SCREEN_SCROLLBACK_UNLIMITED;
+    src->history = NULL;
+    src->archive = NULL;
+    memset(&src->index, 0, sizeof(src->index));
+    memset(&src->reflow, 0, sizeof(src->reflow));
+    dst->reflow.src = from;
+  } else if (n_inherited) {
+    /* lines |src| already re-wrapped were part of the margin */
+    line_arena_destroy(src->reflow.wrapped);
+    dst->reflow.src = src->reflow.src;
+    dst->reflow.skip = src->reflow.skip;
+    memset(&src->reflow, 0, sizeof(src->reflow));
+  }
+  dst->scroll.max = max;
+  screen_trim_history(dst);
 }
 
 /* copy to content from one screen to another. This is a naive resizing implementation which just re-inserts everything
  * and counts on the final screen to be accurate */
-void screen_copy_alternate(struct screen *restrict dst, const struct screen *const restrict src) {
+void screen_copy_alternate(struct screen *restrict dst, struct screen *restrict src) {
+  style_table_copy(&dst->styles, &src->styles);
   int h = MIN(src->h, dst->h);
   int w = MIN(src->w, dst->w);
   for (int row = 0; row < h ; row++) {
@@ -532,6 +1231,7 @@ void screen_copy_alternate(struct screen *restrict dst, const struct screen *con
     }
     d->has_newline = s->has_newline;
     d->eol = MIN(w, s->eol);
+    screen_line_touch(d);
   }
   dst->cursor = src->cursor;
   dst->cursor.column = MIN(dst->cursor.column, w - 1);
@@ -564,9 +1264,7 @@ void screen_shuffle_rows_down(struct screen *g, int count, int top, int bottom)
   int n_affected_rows = bottom - top + 1;
   count = MIN(count, n_affected_rows);
 
-  for (int row = bottom; row >= top + count; row--) {
-    screen_swap_rows(g, row, row - count);
-  }
+  screen_rotate_rows(g, -count, top, bottom);
 
   // clear the first `count` rows
   for (int row = top; row < top + count; row++) screen_clear_line(g, row);
@@ -584,11 +1282,13 @@ void screen_shuffle_rows_up(struct screen *g, int count, int top, int bottom) {
   count = MIN(count, n_affected_rows);
 
   if (top == 0 && bottom == g->h - 1) {
+    screen_normalize_rows(g);
+    /* the rows scrolling out at the top become scrollback, and their slots are reused at the bottom */
+    if (g->scroll.max) {
+      for (int row = 0; row < count; row++) screen_push_history(g, screen_get_line(g, row));
+      screen_trim_history(g);
+    }
     g->scroll.offset += count;
-    g->scroll.height = MIN(g->scroll.height + count, g->scroll.max);
-    int required_capacity = CLAMP(g->scroll.offset + g->h, 0, num_lines(g));
-    if (required_capacity > g->scroll.capacity) scrollback_init(g, required_capacity);
-
 
     /* adjust scroll view if set */
     if (g->scroll.view_offset > 0) {
@@ -596,9 +1296,7 @@ void screen_shuffle_rows_up(struct screen *g, int count, int top, int bottom) {
     }
 
   } else {
-    for (int row = top; row <= bottom - count; row++) {
-      screen_swap_rows(g, row, row + count);
-    }
+    screen_rotate_rows(g, count, top, bottom);
   }
 
   // clear the final `count` rows
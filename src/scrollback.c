@@ -0,0 +1,481 @@
+#include "scrollback.h"
+#include "lz.h"
+#include "utils.h"
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/* the worst case encoded size of a line of |w| cells: every cell starts a run and holds a wide 5 byte codepoint */
+#define LINE_ENCODING_BOUND(w) ((w) * 13 + 24)
+
+static inline uint8_t *put_varint(uint8_t *o, uint32_t v) {
+  for (; v >= 0x80; v >>= 7) *o++ = (uint8_t)(v | 0x80);
+  *o++ = (uint8_t)v;
+  return o;
+}
+
+static uint32_t read_varint(const uint8_t **p, const uint8_t *end) {
+  uint32_t v = 0;
+  for (int shift = 0; *p < end && shift < 32; shift += 7) {
+    uint8_t b = *(*p)++;
+    v |= (uint32_t)(b & 0x7F) << shift;
+    if (!(b & 0x80)) break;
+  }
+  return v;
+}
+
+static inline uint8_t *put_u16(uint8_t *o, uint16_t v) {
+  *o++ = v & 0xFF;
+  *o++ = v >> 8;
+  return o;
+}
+
+static uint16_t read_u16(const uint8_t **p, const uint8_t *end) {
+  if (end - *p < 2) {
+    *p = end;
+    return 0;
+  }
+  uint16_t v = (*p)[0] | (*p)[1] << 8;
+  *p += 2;
+  return v;
+}
+
+struct scrollback *scrollback_create(int w) {
+  struct scrollback *sb = velvet_calloc(1, sizeof(*sb));
+  sb->w = w;
+  sb->spill_fd = -1;
+  sb->next_serial = 1;
+  sb->open.serial = sb->next_serial++;
+  return sb;
+}
+
+static void block_destroy(struct scrollback_block *b) {
+  free(b->data);
+  free(b->styles);
+  free(b->graphemes);
+  free(b->links);
+  *b = (struct scrollback_block){0};
+}
+
+static void scrollback_reset_open(struct scrollback *sb) {
+  for (uint32_t i = 0; i < sb->open.n_styles; i++) sb->open_seen[sb->open.styles[i] / 8] = 0;
+  sb->open.n_styles = 0;
+  for (uint32_t i = 0; i < sb->open.n_graphemes; i++) {
+    uint32_t id = (sb->open.graphemes[i] & ~GRAPHEME_HANDLE) % GRAPHEME_STORE_CAPACITY;
+    sb->open_seen_graphemes[id / 8] = 0;
+  }
+  sb->open.n_graphemes = 0;
+  for (uint32_t i = 0; i < sb->open.n_links; i++) sb->open_seen_links[sb->open.links[i] / 8] = 0;
+  sb->open.n_links = 0;
+  sb->open.serial = sb->next_serial++;
+  sb->open_lines = 0;
+  string_clear(&sb->open_data);
+}
+
+static void scrollback_unmap(struct scrollback *sb) {
+  if (sb->map) munmap(sb->map, sb->map_size);
+  sb->map = NULL;
+  sb->map_size = 0;
+}
+
+void scrollback_clear(struct scrollback *sb) {
+  for (int i = 0; i < sb->n_blocks; i++) block_destroy(&sb->blocks[i]);
+  sb->n_blocks = 0;
+  sb->n_lines = 0;
+  sb->first = 0;
+  scrollback_reset_open(sb);
+  if (sb->spill_fd >= 0 && sb->spill_size) {
+    scrollback_unmap(sb);
+    if (ftruncate(sb->spill_fd, 0) == -1) ERROR("ftruncate scrollback:");
+    sb->spill_size = 0;
+  }
+}
+
+void scrollback_destroy(struct scrollback *sb) {
+  if (!sb) return;
+  scrollback_clear(sb);
+  scrollback_unmap(sb);
+  if (sb->spill_fd >= 0) close(sb->spill_fd);
+  free(sb->blocks);
+  free(sb->open.styles);
+  free(sb->open.graphemes);
+  free(sb->open.links);
+  string_destroy(&sb->open_data);
+  scrollback_release_cache(sb);
+  free(sb);
+}
+
+void scrollback_release_cache(struct scrollback *sb) {
+  for (int i = 0; i < SCROLLBACK_CACHE_BLOCKS; i++) {
+    free(sb->cache[i].lines);
+    free(sb->cache[i].cells);
+    sb->cache[i] = (struct scrollback_cache){0};
+  }
+}
+
+/* append the data of |b| to the spill file and release it */
+static bool scrollback_spill_block(struct scrollback *sb, struct scrollback_block *b) {
+  for (uint32_t written = 0; written < b->size;) {
+    ssize_t n = pwrite(sb->spill_fd, b->data + written, b->size - written, sb->spill_size + written);
+    if (n <= 0) {
+      ERROR("write scrollback:");
+      return false;
+    }
+    written += n;
+  }
+  b->offset = sb->spill_size;
+  sb->spill_size += b->size;
+  free(b->data);
+  b->data = NULL;
+  return true;
+}
+
+static const uint8_t *scrollback_block_data(struct scrollback *sb, const struct scrollback_block *b) {
+  if (b->data) return b->data;
+  if (b->offset + b->size > sb->map_size) {
+    /* grow the mapping in large steps so it is rarely remapped */
+    scrollback_unmap(sb);
+    size_t size = (sb->spill_size + mB(4)) & ~(size_t)(mB(4) - 1);
+    void *map = mmap(NULL, size, PROT_READ, MAP_SHARED, sb->spill_fd, 0);
+    if (map == MAP_FAILED) {
+      ERROR("mmap scrollback:");
+      return NULL;
+    }
+    sb->map = map;
+    sb->map_size = size;
+  }
+  return sb->map + b->offset;
+}
+
+bool scrollback_set_spill(struct scrollback *sb, bool spill) {
+  if (spill == (sb->spill_fd >= 0)) return true;
+  if (spill) {
+    const char *dir = getenv("TMPDIR");
+    struct string path = {0};
+    string_joinpath(&path, dir && *dir ? dir : "/tmp", "velvet-scrollback-XXXXXX");
+    string_ensure_null_terminated(&path);
+    sb->spill_fd = mkstemp((char *)path.content);
+    if (sb->spill_fd >= 0) unlink((char *)path.content);
+    string_destroy(&path);
+    if (sb->spill_fd < 0) {
+      ERROR("mkstemp scrollback:");
+      return false;
+    }
+    set_cloexec(sb->spill_fd);
+    for (int i = 0; i < sb->n_blocks; i++) scrollback_spill_block(sb, &sb->blocks[i]);
+  } else {
+    for (int i = 0; i < sb->n_blocks; i++) {
+      struct scrollback_block *b = &sb->blocks[i];
+      if (b->data) continue;
+      const uint8_t *data = scrollback_block_data(sb, b);
+      b->data = velvet_calloc(MAX(b->size, 1), 1);
+      if (data) memcpy(b->data, data, b->size);
+    }
+    scrollback_unmap(sb);
+    close(sb->spill_fd);
+    sb->spill_fd = -1;
+    sb->spill_size = 0;
+  }
+  return true;
+}
+
+static void scrollback_seal(struct scrollback *sb) {
+  struct scrollback_block b = sb->open;
+  b.raw_size = sb->open_data.len;
+  b.data = velvet_calloc(MAX(lz_compress_bound(b.raw_size), 1), 1);
+  b.size = lz_compress(sb->open_data.content, b.raw_size, b.data);
+  b.compressed = b.size < b.raw_size;
+  if (!b.compressed) {
+    memcpy(b.data, sb->open_data.content, b.raw_size);
+    b.size = b.raw_size;
+  }
+  b.data = velvet_erealloc(b.data, MAX(b.size, 1), 1);
+  b.styles = velvet_calloc(MAX(b.n_styles, 1), sizeof(*b.styles));
+  if (b.n_styles) memcpy(b.styles, sb->open.styles, b.n_styles * sizeof(*b.styles));
+  b.graphemes = NULL;
+  if (b.n_graphemes) {
+    b.graphemes = velvet_calloc(b.n_graphemes, sizeof(*b.graphemes));
+    memcpy(b.graphemes, sb->open.graphemes, b.n_graphemes * sizeof(*b.graphemes));
+  }
+  b.links = NULL;
+  if (b.n_links) {
+    b.links = velvet_calloc(b.n_links, sizeof(*b.links));
+    memcpy(b.links, sb->open.links, b.n_links * sizeof(*b.links));
+  }
+
+  if (sb->n_blocks == sb->blocks_capacity) {
+    sb->blocks_capacity = MAX(sb->blocks_capacity * 2, 8);
+    sb->blocks = velvet_erealloc(sb->blocks, sb->blocks_capacity, sizeof(*sb->blocks));
+  }
+  if (sb->spill_fd >= 0) scrollback_spill_block(sb, &b);
+  sb->blocks[sb->n_blocks++] = b;
+  scrollback_reset_open(sb);
+}
+
+static void scrollback_see_style(struct scrollback *sb, style_id style) {
+  if (sb->open_seen[style / 8] & (1 << (style % 8))) return;
+  sb->open_seen[style / 8] |= 1 << (style % 8);
+  if (sb->open.n_styles % 64 == 0)
+    sb->open.styles = velvet_erealloc(sb->open.styles, sb->open.n_styles + 64, sizeof(*sb->open.styles));
+  sb->open.styles[sb->open.n_styles++] = style;
+}
+
+static void scrollback_see_grapheme(struct scrollback *sb, uint32_t handle) {
+  uint32_t id = (handle & ~GRAPHEME_HANDLE) % GRAPHEME_STORE_CAPACITY;
+  if (sb->open_seen_graphemes[id / 8] & (1 << (id % 8))) return;
+  sb->open_seen_graphemes[id / 8] |= 1 << (id % 8);
+  if (sb->open.n_graphemes % 64 == 0)
+    sb->open.graphemes = velvet_erealloc(sb->open.graphemes, sb->open.n_graphemes + 64, sizeof(*sb->open.graphemes));
+  sb->open.graphemes[sb->open.n_graphemes++] = handle;
+}
+
+static void scrollback_see_link(struct scrollback *sb, hyperlink_id link) {
+  if (sb->open_seen_links[link / 8] & (1 << (link % 8))) return;
+  sb->open_seen_links[link / 8] |= 1 << (link % 8);
+  if (sb->open.n_links % 64 == 0)
+    sb->open.links = velvet_erealloc(sb->open.links, sb->open.n_links + 64, sizeof(*sb->open.links));
+  sb->open.links[sb->open.n_links++] = link;
+}
+
+/* the style and hyperlink of a cell, which are adjacent in struct screen_cell */
+static inline uint32_t cell_attributes(struct screen_cell c) {
+  uint32_t bits;
+  memcpy(&bits, &c.style, sizeof(bits));
+  return bits;
+}
+
+static inline uint32_t codepoint_bits(struct codepoint cp) {
+  uint32_t bits;
+  memcpy(&bits, &cp, sizeof(bits));
+  return bits;
+}
+
+/* Codepoints are encoded as varints. DEL is never written to a cell, so it is used to mark wide codepoints. */
+#define WIDE_MARKER 0x7F
+
+static inline uint8_t *put_codepoint(uint8_t *o, struct codepoint cp) {
+  if (cp.is_wide) *o++ = WIDE_MARKER;
+  return put_varint(o, cp.value);
+}
+
+/* grapheme cluster handles are recorded so the emulator does not reclaim them */
+static inline uint8_t *scrollback_put_codepoint(struct scrollback *sb, uint8_t *o, struct codepoint cp) {
+  if (grapheme_is_handle(cp.value)) scrollback_see_grapheme(sb, cp.value);
+  return put_codepoint(o, cp);
+}
+
+static inline struct codepoint read_codepoint(const uint8_t **p, const uint8_t *end) {
+  bool wide = *p < end && **p == WIDE_MARKER;
+  if (wide) (*p)++;
+  return (struct codepoint){.value = read_varint(p, end), .is_wide = wide};
+}
+
+/* line encoding:
+ *   varint eol, u8 has_newline,
+ *   u16 n_runs, n_runs * (varint length, u16 style, u16 link),
+ *   codepoint fill, varint n_codepoints, n_codepoints * codepoint
+ * Runs cover the whole line, and the cells after the final codepoint hold the fill codepoint. */
+void scrollback_push(struct scrollback *sb, const struct screen_line *line) {
+  struct string *s = &sb->open_data;
+  size_t len = s->len;
+  string_truncate(s, len + LINE_ENCODING_BOUND(sb->w));
+  uint8_t *o = s->content + len;
+  const struct screen_cell *cells = line->cells;
+  o = put_varint(o, line->eol);
+  *o++ = line->has_newline;
+
+  /* the run count is patched in once the runs are written */
+  uint8_t *n_runs_slot = o;
+  o += 2;
+  uint16_t n_runs = 0;
+  for (int col = 0; col < sb->w; n_runs++) {
+    int start = col;
+    uint32_t attributes = cell_attributes(cells[start]);
+    /* runs are usually long, so scan them four cells at a time */
+    for (col++; col + 4 <= sb->w &&
+                ((cell_attributes(cells[col]) ^ attributes) | (cell_attributes(cells[col + 1]) ^ attributes) |
+                 (cell_attributes(cells[col + 2]) ^ attributes) | (cell_attributes(cells[col + 3]) ^ attributes)) == 0;
+         col += 4);
+    for (; col < sb->w && cell_attributes(cells[col]) == attributes; col++);
+    o = put_varint(o, col - start);
+    o = put_u16(o, cells[start].style);
+    o = put_u16(o, cells[start].link);
+    if (cells[start].style) scrollback_see_style(sb, cells[start].style);
+    if (cells[start].link) scrollback_see_link(sb, cells[start].link);
+  }
+  put_u16(n_runs_slot, n_runs);
+
+  /* cleared cells are usually identical, so trailing cells equal to the final cell are not stored */
+  struct codepoint fill = cells[sb->w - 1].cp;
+  int n_codepoints = sb->w;
+  for (; n_codepoints && codepoint_bits(cells[n_codepoints - 1].cp) == codepoint_bits(fill); n_codepoints--);
+  o = scrollback_put_codepoint(sb, o, fill);
+  o = put_varint(o, n_codepoints);
+  int col = 0;
+  for (; col + 4 <= n_codepoints; col += 4) {
+    uint32_t a = codepoint_bits(cells[col].cp), b = codepoint_bits(cells[col + 1].cp);
+    uint32_t c = codepoint_bits(cells[col + 2].cp), d = codepoint_bits(cells[col + 3].cp);
+    /* narrow ascii is encoded as-is */
+    if ((a | b | c | d) < 0x80) {
+      o[0] = a, o[1] = b, o[2] = c, o[3] = d;
+      o += 4;
+    } else {
+      for (int i = col; i < col + 4; i++) o = scrollback_put_codepoint(sb, o, cells[i].cp);
+    }
+  }
+  for (; col < n_codepoints; col++) o = scrollback_put_codepoint(sb, o, cells[col].cp);
+  s->len = o - s->content;
+
+  sb->n_lines++;
+  if (++sb->open_lines == SCROLLBACK_BLOCK_LINES) scrollback_seal(sb);
+}
+
+void scrollback_drop_oldest(struct scrollback *sb, int n) {
+  n = MIN(n, sb->n_lines);
+  if (n <= 0) return;
+  sb->n_lines -= n;
+  sb->first += n;
+  int dropped = 0;
+  while (dropped < sb->n_blocks && sb->first >= SCROLLBACK_BLOCK_LINES) {
+    block_destroy(&sb->blocks[dropped++]);
+    sb->first -= SCROLLBACK_BLOCK_LINES;
+  }
+  if (dropped) {
+    memmove(sb->blocks, sb->blocks + dropped, (sb->n_blocks - dropped) * sizeof(*sb->blocks));
+    sb->n_blocks -= dropped;
+  }
+  if (sb->n_lines == 0) scrollback_clear(sb);
+}
+
+void scrollback_prepend(struct scrollback *sb, struct scrollback *src) {
+  assert(sb->first == 0 && src->open_lines == 0);
+  if (!src->n_blocks) return;
+  if (sb->n_blocks + src->n_blocks > sb->blocks_capacity) {
+    sb->blocks_capacity = MAX(sb->blocks_capacity * 2, sb->n_blocks + src->n_blocks);
+    sb->blocks = velvet_erealloc(sb->blocks, sb->blocks_capacity, sizeof(*sb->blocks));
+  }
+  memmove(sb->blocks + src->n_blocks, sb->blocks, sb->n_blocks * sizeof(*sb->blocks));
+  for (int i = 0; i < src->n_blocks; i++) {
+    struct scrollback_block b = src->blocks[i];
+    /* serials identify blocks in the decode cache of |sb| */
+    b.serial = sb->next_serial++;
+    if (sb->spill_fd >= 0 && b.data) scrollback_spill_block(sb, &b);
+    sb->blocks[i] = b;
+  }
+  sb->n_blocks += src->n_blocks;
+  sb->n_lines += src->n_lines;
+  sb->first = src->first;
+  src->n_blocks = src->n_lines = src->first = 0;
+}
+
+static void decode_lines(struct scrollback *sb, const uint8_t *p, const uint8_t *end, struct scrollback_cache *c, int n_lines) {
+  for (int i = 0; i < n_lines; i++) {
+    struct screen_line *l = &c->lines[i];
+    struct screen_cell *cells = &c->cells[i * sb->w];
+    int eol = read_varint(&p, end);
+    *l = (struct screen_line){.cells = cells, .eol = MIN(eol, sb->w)};
+    l->has_newline = p < end && *p++;
+
+    int n_runs = read_u16(&p, end);
+    for (int run = 0, col = 0; run < n_runs; run++) {
+      int len = read_varint(&p, end);
+      style_id style = read_u16(&p, end);
+      hyperlink_id link = read_u16(&p, end);
+      for (int stop = MIN(col + len, sb->w); col < stop; col++) {
+        cells[col].style = style;
+        cells[col].link = link;
+      }
+    }
+
+    struct codepoint fill = read_codepoint(&p, end);
+    int n_codepoints = read_varint(&p, end);
+    for (int col = 0; col < sb->w; col++) cells[col].cp = col < n_codepoints ? read_codepoint(&p, end) : fill;
+  }
+}
+
+static struct scrollback_cache *scrollback_decode(struct scrollback *sb, const struct scrollback_block *b, const uint8_t *raw, int n_lines) {
+  struct scrollback_cache *c = &sb->cache[0];
+  for (int i = 0; i < SCROLLBACK_CACHE_BLOCKS; i++) {
+    struct scrollback_cache *candidate = &sb->cache[i];
+    if (candidate->serial == b->serial && candidate->n_lines == n_lines) {
+      candidate->stamp = ++sb->clock;
+      return candidate;
+    }
+    if (candidate->stamp < c->stamp) c = candidate;
+  }
+
+  if (!c->lines) {
+    c->lines = velvet_calloc(SCROLLBACK_BLOCK_LINES, sizeof(*c->lines));
+    c->cells = velvet_calloc(SCROLLBACK_BLOCK_LINES * sb->w, sizeof(*c->cells));
+  }
+
+  uint8_t *scratch = NULL;
+  if (b->compressed) {
+    scratch = velvet_calloc(b->raw_size, 1);
+    if (!raw || !lz_decompress(raw, b->size, scratch, b->raw_size)) ERROR("Corrupt scrollback block");
+    raw = scratch;
+  } else if (!raw) {
+    raw = scratch = velvet_calloc(MAX(b->raw_size, 1), 1);
+  }
+  decode_lines(sb, raw, raw + b->raw_size, c, n_lines);
+  free(scratch);
+
+  c->serial = b->serial;
+  c->n_lines = n_lines;
+  c->stamp = ++sb->clock;
+  return c;
+}
+
+struct screen_line *scrollback_get(struct scrollback *sb, int n) {
+  assert(n >= 0 && n < sb->n_lines);
+  int index = n + sb->first;
+  int block = index / SCROLLBACK_BLOCK_LINES;
+  struct scrollback_cache *c;
+  if (block < sb->n_blocks) {
+    c = scrollback_decode(sb, &sb->blocks[block], scrollback_block_data(sb, &sb->blocks[block]), SCROLLBACK_BLOCK_LINES);
+  } else {
+    struct scrollback_block open = sb->open;
+    open.raw_size = sb->open_data.len;
+    c = scrollback_decode(sb, &open, sb->open_data.content, sb->open_lines);
+  }
+  return &c->lines[index % SCROLLBACK_BLOCK_LINES];
+}
+
+void scrollback_mark_styles(const struct scrollback *sb, uint8_t *used) {
+  for (int i = 0; i < sb->n_blocks; i++)
+    for (uint32_t j = 0; j < sb->blocks[i].n_styles; j++) used[sb->blocks[i].styles[j]] = 1;
+  for (uint32_t j = 0; j < sb->open.n_styles; j++) used[sb->open.styles[j]] = 1;
+}
+
+void scrollback_mark_graphemes(const struct scrollback *sb, uint8_t *used) {
+  for (int i = 0; i < sb->n_blocks; i++)
+    for (uint32_t j = 0; j < sb->blocks[i].n_graphemes; j++) grapheme_mark(used, sb->blocks[i].graphemes[j]);
+  for (uint32_t j = 0; j < sb->open.n_graphemes; j++) grapheme_mark(used, sb->open.graphemes[j]);
+}
+
+void scrollback_mark_links(const struct scrollback *sb, uint8_t *used) {
+  for (int i = 0; i < sb->n_blocks; i++)
+    for (uint32_t j = 0; j < sb->blocks[i].n_links; j++) used[sb->blocks[i].links[j]] = 1;
+  for (uint32_t j = 0; j < sb->open.n_links; j++) used[sb->open.links[j]] = 1;
+}
+
+struct scrollback_stats scrollback_get_stats(const struct scrollback *sb) {
+  struct scrollback_stats stats = {.lines = sb->n_lines};
+  stats.raw_bytes = (size_t)sb->n_lines * sb->w * sizeof(struct screen_cell);
+  for (int i = 0; i < sb->n_blocks; i++) {
+    stats.bytes += sb->blocks[i].size + sb->blocks[i].n_styles * sizeof(style_id) +
+                   sb->blocks[i].n_graphemes * sizeof(*sb->blocks[i].graphemes) +
+                   sb->blocks[i].n_links * sizeof(*sb->blocks[i].links);
+    if (!sb->blocks[i].data) stats.spilled_bytes += sb->blocks[i].size;
+  }
+  stats.bytes += sb->open_data.len + sb->open.n_styles * sizeof(style_id) +
+                 sb->open.n_graphemes * sizeof(*sb->open.graphemes) + sb->open.n_links * sizeof(*sb->open.links);
+  stats.heap_bytes = stats.bytes - stats.spilled_bytes + sb->blocks_capacity * sizeof(*sb->blocks);
+  for (int i = 0; i < SCROLLBACK_CACHE_BLOCKS; i++) {
+    if (sb->cache[i].lines)
+      stats.heap_bytes += SCROLLBACK_BLOCK_LINES * (sizeof(struct screen_line) + sb->w * sizeof(struct screen_cell));
+  }
+  return stats;
+}
@@ -1,6 +1,9 @@
 #include "text.h"
 #include "utils.h"
 #include "utf8proc/utf8proc.h"
+#include <string.h>
+
+#include "unicode_table.c"
 
 // assume *str is a valid utf8 string
 int utf8_strlen(char *str) {
@@ -86,8 +89,231 @@ int codepoint_to_utf8(uint32_t cp, uint8_t u[4]) {
   }
 }
 
+size_t utf8_decode_run(const uint8_t *str, size_t len, uint32_t *out, size_t max, size_t *consumed) {
+  size_t i = 0, n = 0;
+  for (; n < max && i < len; n++) {
+    uint8_t lead = str[i];
+    size_t seqlen = utf8_expected_length(lead);
+    if (seqlen == 0 || i + seqlen > len) break;
+    /* every continuation byte must match 0b10xxxxxx */
+    uint8_t bad = 0;
+    for (size_t k = 1; k < seqlen; k++) bad |= (str[i + k] ^ 0x80);
+    if (bad & 0xC0) break;
+
+    uint32_t cp;
+    switch (seqlen) {
+    case 1: cp = lead; break;
+    case 2: cp = ((lead & 0x1F) << 6) | (str[i + 1] & 0x3F); break;
+    case 3: cp = ((lead & 0x0F) << 12) | ((str[i + 1] & 0x3F) << 6) | (str[i + 2] & 0x3F); break;
+    default:
+      cp = ((lead & 0x07) << 18) | ((str[i + 1] & 0x3F) << 12) | ((str[i + 2] & 0x3F) << 6) | (str[i + 3] & 0x3F);
+      break;
+    }
+    out[n] = cp;
+    i += seqlen;
+  }
+  *consumed = i;
+  return n;
+}
+
 void utf8_push(struct utf8 *u, uint8_t byte) {
   assert(u->utf8[3] == 0);
   uint8_t n = utf8_length(*u);
   u->utf8[n] = byte;
 }
+
+#define SWAR_ONES 0x0101010101010101ULL
+#define SWAR_HIGH 0x8080808080808080ULL
+
+static inline size_t scan_ascii_tail(const uint8_t *str, size_t i, size_t len) {
+  for (; i < len && str[i] >= 0x20 && str[i] < 0x7f; i++);
+  return i;
+}
+
+static inline size_t scan_utf8_tail(const uint8_t *str, size_t i, size_t len) {
+  for (; i < len && str[i] >= 0x80; i++);
+  return i;
+}
+
+static inline size_t scan_string_tail(const uint8_t *str, size_t i, size_t len) {
+  for (; i < len && str[i] >= 0x20; i++);
+  return i;
+}
+
+static size_t scan_ascii_scalar(const uint8_t *str, size_t len) {
+  size_t i = 0;
+  for (; i + 8 <= len; i += 8) {
+    uint64_t w;
+    memcpy(&w, str + i, 8);
+    /* any byte < 0x20, any byte >= 0x80, or any byte == 0x7f */
+    uint64_t low = (w - SWAR_ONES * 0x20) & ~w;
+    uint64_t del = w ^ (SWAR_ONES * 0x7f);
+    del = (del - SWAR_ONES) & ~del;
+    if ((low | w | del) & SWAR_HIGH) break;
+  }
+  return scan_ascii_tail(str, i, len);
+}
+
+static size_t scan_utf8_scalar(const uint8_t *str, size_t len) {
+  size_t i = 0;
+  for (; i + 8 <= len; i += 8) {
+    uint64_t w;
+    memcpy(&w, str + i, 8);
+    if ((w & SWAR_HIGH) != SWAR_HIGH) break;
+  }
+  return scan_utf8_tail(str, i, len);
+}
+
+static size_t scan_string_scalar(const uint8_t *str, size_t len) {
+  size_t i = 0;
+  for (; i + 8 <= len; i += 8) {
+    uint64_t w;
+    memcpy(&w, str + i, 8);
+    /* any byte < 0x20 */
+    if ((w - SWAR_ONES * 0x20) & ~w & SWAR_HIGH) break;
+  }
+  return scan_string_tail(str, i, len);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+
+__attribute__((target("sse2"))) static size_t scan_ascii_sse2(const uint8_t *str, size_t len) {
+  const __m128i lo = _mm_set1_epi8(0x1f);
+  const __m128i hi = _mm_set1_epi8(0x7f);
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    __m128i v = _mm_loadu_si128((const __m128i *)(str + i));
+    /* signed compare: bytes >= 0x80 are negative and fail the lower bound */
+    __m128i ok = _mm_and_si128(_mm_cmpgt_epi8(v, lo), _mm_cmplt_epi8(v, hi));
+    uint32_t mask = (uint32_t)_mm_movemask_epi8(ok) ^ 0xFFFF;
+    if (mask) return i + __builtin_ctz(mask);
+  }
+  return scan_ascii_tail(str, i, len);
+}
+
+__attribute__((target("sse2"))) static size_t scan_utf8_sse2(const uint8_t *str, size_t len) {
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    __m128i v = _mm_loadu_si128((const __m128i *)(str + i));
+    uint32_t mask = (uint32_t)_mm_movemask_epi8(v) ^ 0xFFFF;
+    if (mask) return i + __builtin_ctz(mask);
+  }
+  return scan_utf8_tail(str, i, len);
+}
+
+__attribute__((target("sse2"))) static size_t scan_string_sse2(const uint8_t *str, size_t len) {
+  const __m128i c0 = _mm_set1_epi8(0x1f);
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    __m128i v = _mm_loadu_si128((const __m128i *)(str + i));
+    /* unsigned v <= 0x1f */
+    __m128i hit = _mm_cmpeq_epi8(_mm_min_epu8(v, c0), v);
+    uint32_t mask = (uint32_t)_mm_movemask_epi8(hit);
+    if (mask) return i + __builtin_ctz(mask);
+  }
+  return scan_string_tail(str, i, len);
+}
+
+__attribute__((target("avx2"))) static size_t scan_ascii_avx2(const uint8_t *str, size_t len) {
+  const __m256i lo = _mm256_set1_epi8(0x1f);
+  const __m256i hi = _mm256_set1_epi8(0x7f);
+  size_t i = 0;
+  for (; i + 32 <= len; i += 32) {
+    __m256i v = _mm256_loadu_si256((const __m256i *)(str + i));
+    __m256i ok = _mm256_and_si256(_mm256_cmpgt_epi8(v, lo), _mm256_cmpgt_epi8(hi, v));
+    uint32_t mask = ~(uint32_t)_mm256_movemask_epi8(ok);
+    if (mask) return i + __builtin_ctz(mask);
+  }
+  return i + scan_ascii_sse2(str + i, len - i);
+}
+
+__attribute__((target("avx2"))) static size_t scan_utf8_avx2(const uint8_t *str, size_t len) {
+  size_t i = 0;
+  for (; i + 32 <= len; i += 32) {
+    __m256i v = _mm256_loadu_si256((const __m256i *)(str + i));
+    uint32_t mask = ~(uint32_t)_mm256_movemask_epi8(v);
+    if (mask) return i + __builtin_ctz(mask);
+  }
+  return i + scan_utf8_sse2(str + i, len - i);
+}
+
+__attribute__((target("avx2"))) static size_t scan_string_avx2(const uint8_t *str, size_t len) {
+  const __m256i c0 = _mm256_set1_epi8(0x1f);
+  size_t i = 0;
+  for (; i + 32 <= len; i += 32) {
+    __m256i v = _mm256_loadu_si256((const __m256i *)(str + i));
+    /* unsigned v <= 0x1f */
+    __m256i hit = _mm256_cmpeq_epi8(_mm256_min_epu8(v, c0), v);
+    uint32_t mask = (uint32_t)_mm256_movemask_epi8(hit);
+    if (mask) return i + __builtin_ctz(mask);
+  }
+  return i + scan_string_sse2(str + i, len - i);
+}
+
+static bool text_scanner_supported(enum text_scanner_kind kind) {
+  __builtin_cpu_init();
+  switch (kind) {
+  case TEXT_SCANNER_AVX2: return __builtin_cpu_supports("avx2");
+  case TEXT_SCANNER_SSE2: return __builtin_cpu_supports("sse2");
+  default: return true;
+  }
+}
+#else
+static bool text_scanner_supported(enum text_scanner_kind kind) {
+  return kind == TEXT_SCANNER_SCALAR;
+}
+#endif
+
+static size_t scan_ascii_resolve(const uint8_t *str, size_t len) {
+  text_scanner_select(TEXT_SCANNER_AUTO);
+  return text_scanner.ascii(str, len);
+}
+
+static size_t scan_utf8_resolve(const uint8_t *str, size_t len) {
+  text_scanner_select(TEXT_SCANNER_AUTO);
+  return text_scanner.utf8(str, len);
+}
+
+static size_t scan_string_resolve(const uint8_t *str, size_t len) {
+  text_scanner_select(TEXT_SCANNER_AUTO);
+  return text_scanner.string(str, len);
+}
+
+/* the first call through any scanner resolves the best implementation */
+struct text_scanner text_scanner = {
+  .kind = TEXT_SCANNER_AUTO,
+  .ascii = scan_ascii_resolve,
+  .utf8 = scan_utf8_resolve,
+  .string = scan_string_resolve,
+};
+
+enum text_scanner_kind text_scanner_select(enum text_scanner_kind kind) {
+  if (kind == TEXT_SCANNER_AUTO || !text_scanner_supported(kind)) {
+    kind = TEXT_SCANNER_SCALAR;
+    if (text_scanner_supported(TEXT_SCANNER_SSE2)) kind = TEXT_SCANNER_SSE2;
+    if (text_scanner_supported(TEXT_SCANNER_AVX2)) kind = TEXT_SCANNER_AVX2;
+  }
+
+  struct text_scanner s = {
+    .kind = TEXT_SCANNER_SCALAR, .ascii = scan_ascii_scalar, .utf8 = scan_utf8_scalar, .string = scan_string_scalar
+  };
+#if defined(__x86_64__) || defined(__i386__)
+  if (kind == TEXT_SCANNER_SSE2)
+    s = (struct text_scanner){ .kind = kind, .ascii = scan_ascii_sse2, .utf8 = scan_utf8_sse2, .string = scan_string_sse2 };
+  else if (kind == TEXT_SCANNER_AVX2)
+    s = (struct text_scanner){ .kind = kind, .ascii = scan_ascii_avx2, .utf8 = scan_utf8_avx2, .string = scan_string_avx2 };
+#endif
+  text_scanner = s;
+  return s.kind;
+}
+
+const char *text_scanner_name(enum text_scanner_kind kind) {
+  switch (kind) {
+  case TEXT_SCANNER_AUTO: return "auto";
+  case TEXT_SCANNER_SCALAR: return "scalar";
+  case TEXT_SCANNER_SSE2: return "sse2";
+  case TEXT_SCANNER_AVX2: return "avx2";
+  }
+  return "unknown";
+}
@@ -531,6 +531,82 @@ bool window_visible(struct velvet *v, struct velvet_window *w) {
   return rects_intersect(v->scene.size, w->geometry);
 }
 
+static void on_synchronized_update_timeout(void *data) {
+  struct velvet *v = data;
+  struct velvet_window *w;
+  vec_where(w, v->scene.windows, vte_synchronized_update_expire(&w->emulator)) {
+    w->emulator.synchronized_update.completed = false;
+    if (window_visible(v, w)) velvet_invalidate_render(v, "synchronized update timeout");
+  }
+}
+
+static void velvet_flush_window_output(struct velvet *v);
+
+static void on_clipboard_timeout(void *data) {
+  struct velvet *v = data;
+  struct velvet_window *w;
+  vec_foreach(w, v->scene.windows) velvet_window_expire_clipboard(w);
+  /* the aborted sequence is closed with CAN, and the output which was held back is released */
+  velvet_flush_window_output(v);
+}
+
+static void on_alternate_screen_timeout(void *data) {
+  struct velvet *v = data;
+  struct velvet_window *w;
+  vec_foreach(w, v->scene.windows) vte_alternate_screen_expire(&w->emulator);
+}
+
+static void on_memory_budget_check(void *data) {
+  struct velvet *v = data;
+  velvet_scene_enforce_memory_budget(&v->scene);
+}
+
+static void velvet_multicast_window_output(struct velvet *v, struct velvet_window *w) {
+  if (w->emulator_output_buffer.len == 0) return;
+  struct velvet_client *client;
+  /* multicast output to all clients. In practice, there will only be one client connected,
+   * but since there is no good way to determine if a client supports OSC 8, just send it to every
+   * client with an output pipe. The worst case is something like the system clipboard being set multiple times
+   * which is harmless. */
+  vec_where(client, v->clients, client->output) {
+    string_push_string(&client->pending_output, w->emulator_output_buffer);
+  }
+
+  /* Consider the output handled even if it was not transmitted to any client.
+   * We really don't want the buffer to accumulate when no clients are connected,
+   * and allowing a process to e.g. set the clipboard when no client is connected
+   * is kind of an anti-feature anyway,
+   */
+  string_clear(&w->emulator_output_buffer);
+}
+
+/* OSC 52 payloads reach clients in chunks while the window is still writing them. Until the sequence
+ * is closed, anything else sent to clients would end up in the clipboard, so the output of other windows
+ * and render frames are held back. The sequence is aborted if it stays open longer than VTE_CLIPBOARD_TIMEOUT. */
+static void velvet_flush_window_output(struct velvet *v) {
+  struct velvet_window *w;
+  if (v->clipboard_window) {
+    vec_find(w, v->scene.windows, w->id == v->clipboard_window);
+    if (w) {
+      velvet_multicast_window_output(v, w);
+      if (vte_clipboard_open(&w->emulator)) return;
+    } else {
+      /* the window closed in the middle of the sequence. CAN cancels it. */
+      struct velvet_client *client;
+      vec_where(client, v->clients, client->output) string_push_char(&client->pending_output, 0x18);
+    }
+    v->clipboard_window = 0;
+    velvet_invalidate_render(v, "clipboard stream closed");
+  }
+  vec_where(w, v->scene.windows, !w->is_lua_window) {
+    velvet_multicast_window_output(v, w);
+    if (vte_clipboard_open(&w->emulator)) {
+      v->clipboard_window = w->id;
+      return;
+    }
+  }
+}
+
 static void on_window_output(struct io_source *src, struct u8_slice str) {
   struct velvet *v = src->data;
   if (str.len == 0) {
@@ -546,29 +622,50 @@ static void on_window_output(struct io_source *src, struct u8_slice str) {
   assert(vte);
   velvet_window_process_output(vte, str);
 
-  if (vte->emulator_output_buffer.len) {
-    struct velvet_client *client;
-    /* multicast output to all clients. In practice, there will only be one client connected,
-     * but since there is no good way to determine if a client supports OSC 8, just send it to every
-     * client with an output pipe. The worst case is something like the system clipboard being set multiple times
-     * which is harmless. */
-    vec_where(client, v->clients, client->output) {
-      string_push_string(&client->pending_output, vte->emulator_output_buffer);
-    }
-
-    /* Consider the output handled even if it was not transmitted to any client.
-     * We really don't want the buffer to accumulate when no clients are connected,
-     * and allowing a process to e.g. set the clipboard when no client is connected
-     * is kind of an anti-feature anyway,
-     */
-    string_clear(&vte->emulator_output_buffer);
+  velvet_flush_window_output(v);
+  if (vte_clipboard_open(&vte->emulator)) {
+    uint64_t now = get_ms_since_startup();
+    uint64_t deadline = vte->emulator.clipboard_stream.since + VTE_CLIPBOARD_TIMEOUT;
+    struct io_schedule *timeout = io_schedule_get(&v->event_loop, vte->clipboard_token);
+    if (!timeout || timeout->when != deadline)
+      io_reschedule(&v->event_loop, deadline > now ? deadline - now : 0, on_clipboard_timeout, v, &vte->clipboard_token);
+  } else {
+    io_schedule_cancel(&v->event_loop, vte->clipboard_token);
+  }
+  /* a left alternate screen is released after the grace period even if the window goes quiet */
+  if (vte_alternate_screen_kept(&vte->emulator)) {
+    uint64_t now = get_ms_since_startup();
+    uint64_t deadline = vte->emulator.alternate_left + VTE_ALTERNATE_SCREEN_GRACE;
+    struct io_schedule *release = io_schedule_get(&v->event_loop, vte->alternate_screen_token);
+    if (!release || release->when != deadline)
+      io_reschedule(&v->event_loop, deadline > now ? deadline - now : 0, on_alternate_screen_timeout, v,
+                    &vte->alternate_screen_token);
+  } else {
+    io_schedule_cancel(&v->event_loop, vte->alternate_screen_token);
   }
 
   vte->had_output = true;
-
-  if (window_visible(v, vte)) {
-    velvet_invalidate_render(v, "window output");
+  /* the budget is checked at most once per interval since measuring the windows is not free */
+  if (v->scene.memory_budget && !io_schedule_exists(&v->event_loop, v->memory_budget_token))
+    v->memory_budget_token = io_schedule(&v->event_loop, VELVET_MEMORY_BUDGET_INTERVAL, on_memory_budget_check, v);
+
+  /* while a synchronized update is open, the window keeps showing its last complete frame.
+   * Rendering is deferred until the update completes or times out. */
+  bool completed = vte->emulator.synchronized_update.completed;
+  vte->emulator.synchronized_update.completed = false;
+  bool pending = vte_synchronized_update_pending(&vte->emulator);
+  if (pending) {
+    /* each window times out on its own, even if the application goes quiet without closing the update */
+    uint64_t now = get_ms_since_startup();
+    uint64_t deadline = vte->emulator.synchronized_update.since + VTE_SYNCHRONIZED_UPDATE_TIMEOUT;
+    struct io_schedule *timeout = io_schedule_get(&v->event_loop, vte->synchronized_update_token);
+    if (!timeout || timeout->when != deadline)
+      io_reschedule(&v->event_loop, deadline > now ? deadline - now : 0, on_synchronized_update_timeout, v,
+                    &vte->synchronized_update_token);
+  } else {
+    io_schedule_cancel(&v->event_loop, vte->synchronized_update_token);
   }
+  if (window_visible(v, vte) && (completed || !pending)) velvet_invalidate_render(v, "window output");
 }
 
 static bool velvet_align_and_arrange(struct velvet *v, struct velvet_client *focus) {
@@ -599,7 +696,9 @@ static void velvet_dispatch_frame(void *data) {
   struct velvet *v = data;
 
   struct velvet_client *focus = velvet_get_focused_client(v);
-  if (focus) {
+  /* frames are held back while a window streams an OSC 52 sequence to clients.
+   * The damage is kept, and a render is requested again when the sequence closes. */
+  if (focus && !v->clipboard_window) {
     bool is_idle = io_schedule_exists(&v->event_loop, v->active_render_token);
     struct velvet_api_pre_render_event_args event_args = {
         .time = get_ms_since_startup(),
@@ -711,6 +810,8 @@ void velvet_dispatch(struct velvet *velvet) {
    * because a new file handle can be allocated to the free'd up slot, meaning a io_dispatch()
    * can dispatch a callback to an, unrelated file descriptor, causing mayhem. */
   if (velvet->reap) velvet_reap_all(velvet);
+  /* release held output if the window streaming to the clipboard was closed */
+  if (velvet->clipboard_window) velvet_flush_window_output(velvet);
 
   struct io *const loop = &velvet->event_loop;
   struct velvet_client *focus = velvet_get_focused_client(velvet);
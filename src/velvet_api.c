@@ -1,6 +1,7 @@
 #include "velvet_api.h"
 #include "lauxlib.h"
 #include "platform.h"
+#include "scrollback.h"
 #include "utf8proc/utf8proc.h"
 #include "velvet.h"
 #include "velvet_lua.h"
@@ -638,7 +639,7 @@ static lua_stackRetCount vv_api_window_get_text(struct velvet *v, lua_Integer wi
         lua_setfield(L, -2, "truncated");
       } else {
         /* if this cell is wide, increment col to skip the next 0-width cell. */
-        string_push_codepoint(&scratch, c->cp.value ? c->cp.value : ' ');
+        string_push_grapheme(&scratch, &w->emulator.graphemes, c->cp.value ? c->cp.value : ' ');
         if (c->cp.is_wide) col++;
       }
     }
@@ -1002,6 +1003,59 @@ static lua_Integer vv_api_window_get_scrollback_size(struct velvet *v, lua_Integ
   struct screen *active = vte_get_current_screen(&w->emulator);
   return active->scroll.height;
 }
+static struct velvet_api_scrollback_compression vv_api_window_get_scrollback_compression(struct velvet *v, lua_Integer win_id) {
+  struct velvet_window *w = check_window(v, win_id);
+  struct screen *active = vte_get_current_screen(&w->emulator);
+  struct scrollback_stats stats = active->archive ? scrollback_get_stats(active->archive) : (struct scrollback_stats){0};
+  return (struct velvet_api_scrollback_compression){
+      .lines = stats.lines,
+      .raw_bytes = stats.raw_bytes,
+      .compressed_bytes = stats.bytes,
+      .spilled_bytes = stats.spilled_bytes,
+      .ratio = stats.bytes ? (float)stats.raw_bytes / stats.bytes : 1,
+  };
+}
+static struct velvet_api_memory_usage memory_usage(struct vte_memory m) {
+  return (struct velvet_api_memory_usage){
+      .cells = m.screens.cells,
+      .lines = m.screens.lines,
+      .styles = m.screens.styles,
+      .hyperlinks = m.hyperlinks,
+      .scrollback = m.screens.scrollback,
+      .total = vte_memory_total(m),
+  };
+}
+static struct velvet_api_memory_usage vv_api_window_get_memory_usage(struct velvet *v, lua_Integer win_id) {
+  struct velvet_window *w = check_window(v, win_id);
+  return memory_usage(vte_get_memory(&w->emulator));
+}
+static struct velvet_api_memory_usage vv_api_get_memory_usage(struct velvet *v) {
+  struct velvet_api_memory_usage total = {0};
+  struct velvet_window *w;
+  vec_foreach(w, v->scene.windows) {
+    struct velvet_api_memory_usage usage = memory_usage(vte_get_memory(&w->emulator));
+    total.cells += usage.cells;
+    total.lines += usage.lines;
+    total.styles += usage.styles;
+    total.hyperlinks += usage.hyperlinks;
+    total.scrollback += usage.scrollback;
+    total.total += usage.total;
+  }
+  return total;
+}
+static enum velvet_api_scrollback_mode vv_api_window_get_scrollback_mode(struct velvet *v, lua_Integer win_id) {
+  struct velvet_window *w = check_window(v, win_id);
+  return w->emulator.primary.scroll.spill ? VELVET_API_SCROLLBACK_MODE_DISK : VELVET_API_SCROLLBACK_MODE_MEMORY;
+}
+static void vv_api_window_set_scrollback_mode(struct velvet *v, lua_Integer win_id, enum velvet_api_scrollback_mode mode) {
+  lua_State *L = v->current;
+  struct velvet_window *w = check_window(v, win_id);
+  switch (mode) {
+  case VELVET_API_SCROLLBACK_MODE_MEMORY: screen_set_scrollback_limit(&w->emulator.primary, VTE_SCROLLBACK_LINES, false); break;
+  case VELVET_API_SCROLLBACK_MODE_DISK: screen_set_scrollback_limit(&w->emulator.primary, SCREEN_SCROLLBACK_UNLIMITED, true); break;
+  default: bail("Invalid scrollback mode %I", mode);
+  }
+}
 static lua_Integer vv_api_window_get_scroll_offset(struct velvet *v, lua_Integer win_id) {
   struct velvet_window *w = check_window(v, win_id);
   struct screen *active = vte_get_current_screen(&w->emulator);
@@ -1202,7 +1256,7 @@ static lua_Integer vv_api_string_display_width(struct velvet *v, struct u8_slice
   lua_Integer result = 0;
   struct u8_slice_codepoint_iterator it = {.src = string};
   while (u8_slice_codepoint_iterator_next(&it)) {
-    result += utf8proc_charwidth(it.current.value);
+    result += unicode_width(it.current.value);
   }
   if (it.reject) bail("Could not determine display width of '%s': Invalid utf8 sequence.", string.content);
   return result;
@@ -1545,6 +1599,33 @@ static void vv_api_set_scrollback_scroll_multiplier(struct velvet *v, lua_Intege
   v->input.options.scroll_multiplier = new_value;
 }
 
+static lua_Integer vv_api_get_scrollback_memory_budget(struct velvet *v) {
+  return v->scene.memory_budget;
+}
+
+static void vv_api_set_scrollback_memory_budget(struct velvet *v, lua_Integer new_value) {
+  lua_State *L = v->current;
+  if (new_value < 0) bail("Memory budget must not be negative: %I", new_value);
+  v->scene.memory_budget = new_value;
+  velvet_scene_enforce_memory_budget(&v->scene);
+}
+
+static bool vv_api_get_left_right_margins(struct velvet *v) {
+  return v->scene.renderer.options.left_right_margins;
+}
+
+static void vv_api_set_left_right_margins(struct velvet *v, bool new_value) {
+  v->scene.renderer.options.left_right_margins = new_value;
+}
+
+static bool vv_api_get_repeat_characters(struct velvet *v) {
+  return v->scene.renderer.options.repeat_characters;
+}
+
+static void vv_api_set_repeat_characters(struct velvet *v, bool new_value) {
+  v->scene.renderer.options.repeat_characters = new_value;
+}
+
 static struct velvet_api_coordinate vv_api_get_mouse_position(struct velvet *v) {
   return v->input.last_mouse_position;
 }
@@ -1608,6 +1689,7 @@ static void lua_pushcolor(lua_State *L, struct color col) {
 
 static lua_stackRetCount vv_api_window_get_cells(struct velvet *v, lua_Integer win_id, struct velvet_api_rect region) {
   uint8_t decode_buf[4] = {0};
+  struct string scratch = {0};
   lua_State *L = v->current;
   struct velvet_window *w = check_window(v, win_id);
   struct screen *screen = vte_get_current_screen(&w->emulator);
@@ -1640,20 +1722,27 @@ static lua_stackRetCount vv_api_window_get_cells(struct velvet *v, lua_Integer w
       { /* cell[content] = cp.value */
         uint32_t cp = c->cp.value;
         if (!cp) cp = ' ';
-        int n = codepoint_to_utf8(cp, decode_buf);
-        lua_pushlstring(L, (char *)decode_buf, n);
+        if (grapheme_is_handle(cp)) {
+          string_clear(&scratch);
+          string_push_grapheme(&scratch, &w->emulator.graphemes, cp);
+          lua_pushlstring(L, (char *)scratch.content, scratch.len);
+        } else {
+          int n = codepoint_to_utf8(cp, decode_buf);
+          lua_pushlstring(L, (char *)decode_buf, n);
+        }
         lua_setfield(L, -2, "content");
       }
-      { /* cell[background] = c->style.bg */
-        lua_pushcolor(L, c->style.bg);
+      struct screen_cell_style style = screen_get_style(screen, c->style);
+      { /* cell[background] = style.bg */
+        lua_pushcolor(L, style.bg);
         lua_setfield(L, -2, "background");
       }
-      { /* cell[foreground] = c->style.fg */
-        lua_pushcolor(L, c->style.fg);
+      { /* cell[foreground] = style.fg */
+        lua_pushcolor(L, style.fg);
         lua_setfield(L, -2, "foreground");
       }
-      { /* cell[style] = c->style.attr */
-        lua_pushinteger(L, c->style.attr);
+      { /* cell[style] = style.attr */
+        lua_pushinteger(L, style.attr);
         lua_setfield(L, -2, "style");
       }
 
@@ -1662,6 +1751,7 @@ static lua_stackRetCount vv_api_window_get_cells(struct velvet *v, lua_Integer w
     lua_setfield(L, -2, "cells"); /* cell_line.cells = cells */
     lua_seti(L, -2, line_idx++); /* cell_lines[line_idx] = cell_line */
   }
+  string_destroy(&scratch);
   return 1;
 }
 
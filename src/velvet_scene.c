@@ -12,12 +12,11 @@
 #include "velvet_api.h"
 #include "velvet.h"
 #include "velvet_process.h"
+#include "platform.h"
 
-static bool cell_equals(struct screen_cell a, struct screen_cell b);
-static bool cell_style_equals(struct screen_cell_style a, struct screen_cell_style b);
 static bool color_equals(struct color a, struct color b);
 
-static bool blank(struct screen_cell c) {
+static bool blank(struct velvet_render_cell c) {
   return (c.style.attr & (ATTR_UNDERLINE_ANY | ATTR_FRAMED | ATTR_OVERLINED |
                           ATTR_ENCIRCLED | ATTR_CROSSED_OUT)) == 0 &&
          (c.cp.value == ' ' || c.cp.value == 0);
@@ -124,6 +123,7 @@ static void velvet_scene_remove_window(struct velvet_scene *m, struct velvet_win
 
 /* returns 0 on success, otherwise the errno set by execlp */
 static int velvet_window_start(struct velvet_window *velvet_window, char * const *arglist, char * const *envp);
+static void velvet_window_bind_clipboard(struct velvet_window *velvet_window);
 
 int velvet_scene_spawn_process_from_template(struct velvet_scene *scene, struct velvet_window template, char * const *arglist, char * const *envp) {
   assert(scene->windows.element_size == sizeof(struct velvet_window));
@@ -146,6 +146,10 @@ static void velvet_render_destroy(struct velvet_render *renderer) {
   }
   free(renderer->staged.buffer.cells);
   free(renderer->staged.buffer.lines);
+  grapheme_store_destroy(&renderer->graphemes);
+  free(renderer->dirty);
+  free(renderer->occlusion);
+  vec_destroy(&renderer->layers);
 }
 
 void velvet_scene_resize(struct velvet_scene *m, struct rect new_size) {
@@ -159,6 +163,51 @@ void velvet_scene_resize(struct velvet_scene *m, struct rect new_size) {
   }
 }
 
+static int window_compare_last_used(const void *a1, const void *b1) {
+  const struct velvet_window *a = *(struct velvet_window *const *)a1;
+  const struct velvet_window *b = *(struct velvet_window *const *)b1;
+  return a->last_used == b->last_used ? a->id - b->id : a->last_used < b->last_used ? -1 : 1;
+}
+
+void velvet_scene_enforce_memory_budget(struct velvet_scene *m) {
+  if (!m->memory_budget || m->windows.length == 0) return;
+  size_t total = 0;
+  struct velvet_window *win;
+  vec_foreach(win, m->windows) total += vte_memory_total(vte_get_memory(&win->emulator));
+  if (total <= m->memory_budget) return;
+
+  /* least recently used first */
+  size_t n = m->windows.length;
+  struct velvet_window **lru = velvet_calloc(n, sizeof(*lru));
+  for (size_t i = 0; i < n; i++) lru[i] = vec_nth(m->windows, i);
+  qsort(lru, n, sizeof(*lru), window_compare_last_used);
+
+  /* compressing the recent scrollback is cheap to undo, so it is preferred over discarding lines */
+  for (size_t i = 0; i < n && total > m->memory_budget; i++) {
+    struct vte *e = &lru[i]->emulator;
+    size_t before = vte_memory_total(vte_get_memory(e));
+    screen_compress_history(&e->primary);
+    total -= before - vte_memory_total(vte_get_memory(e));
+  }
+
+  for (size_t i = 0; i < n && total > m->memory_budget; i++) {
+    struct vte *e = &lru[i]->emulator;
+    struct screen *g = &e->primary;
+    struct vte_memory before = vte_get_memory(e);
+    /* spilled lines are not counted, so the estimate below would discard the unlimited history of a window
+     * in disk mode while freeing almost no memory. Its compression above already moved the lines out of memory. */
+    if (g->scroll.spill || !g->scroll.height || !before.screens.scrollback) continue;
+    /* estimate the number of lines to drop from the average size of a compressed line */
+    size_t excess = total - m->memory_budget;
+    size_t per_line = MAX(before.screens.scrollback / g->scroll.height, 1);
+    int drop = (int)MIN((excess + per_line - 1) / per_line, (size_t)g->scroll.height);
+    velvet_log("Memory budget exceeded: dropping %d scrollback lines of window %d", drop, lru[i]->id);
+    screen_drop_scrollback(g, drop);
+    total -= vte_memory_total(before) - vte_memory_total(vte_get_memory(e));
+  }
+  free(lru);
+}
+
 static inline struct rgb_color rgb_color(int red, int green, int blue) { return (struct rgb_color){ .r = red, .g = green, .b = blue }; }
 
 static struct color xterm256_to_rgb(struct velvet_theme t, uint8_t n) {
@@ -236,7 +285,7 @@ static struct color color_alpha_blend(struct color a, struct color b, float frac
 
 
 /* convert cell colors to RGB colors based on the current theme, and convert null characters to spaces */
-static struct screen_cell normalize_cell(struct velvet_theme t, struct screen_cell c) {
+static struct velvet_render_cell normalize_cell(struct velvet_theme t, struct velvet_render_cell c) {
   bool is_reverse = c.style.attr & ATTR_REVERSE;
   if (t.bold_bright_colors) {
     struct color col = is_reverse ? c.style.bg : c.style.fg;
@@ -259,7 +308,17 @@ static struct screen_cell normalize_cell(struct velvet_theme t, struct screen_ce
   return c;
 }
 
-static struct screen_cell *velvet_render_get_staged_cell(struct velvet_render *r, int line, int column) {
+/* Composited cells are compared bytewise when calculating damage, so everything which does not affect
+ * how a cell is drawn must be cleared. The foreground of a blank cell is never drawn. */
+static struct velvet_render_cell canonical_cell(struct velvet_render_cell c) {
+  if (blank(c)) {
+    c.cp = codepoint_space;
+    c.style.fg = (struct color){0};
+  }
+  return c;
+}
+
+static struct velvet_render_cell *velvet_render_get_staged_cell(struct velvet_render *r, int line, int column) {
   if (!(line >= 0 && line < r->h)) return NULL;
   if (!(column >= 0 && column < r->w)) return NULL;
 
@@ -268,13 +327,13 @@ static struct screen_cell *velvet_render_get_staged_cell(struct velvet_render *r
   return &l->cells[column];
 }
 
-static void velvet_render_set_cell(struct velvet_render *r, int line, int column, struct screen_cell value, struct velvet_theme t) {
+static void velvet_render_set_cell(struct velvet_render *r, int line, int column, struct velvet_render_cell value, struct velvet_theme t) {
   /* out of bounds writes here is not a bug. It is expected for controls which are partially off-screen. */
   if (!(line >= 0 && line < r->h)) return;
   if (!(column >= 0 && column < r->w)) return;
   struct velvet_render_buffer *b = &r->staged.buffer;
   struct velvet_render_buffer_line *l = &b->lines[line];
-  struct screen_cell *c = l->cells;
+  struct velvet_render_cell *c = l->cells;
   int left, right;
   left = right = column;
 
@@ -355,34 +414,94 @@ static void velvet_render_set_hyperlink(struct velvet_render *r, hyperlink_handl
   }
 }
 
+/* a short control sequence. The longest sequence built is a carriage return followed by two CSI sequences. */
+struct sequence {
+  uint8_t bytes[32];
+  int len;
+};
+
+static void sequence_push(struct sequence *s, char ch, int n) {
+  for (int i = 0; i < n; i++) s->bytes[s->len++] = ch;
+}
+
+static void sequence_push_int(struct sequence *s, int n) {
+  uint8_t digits[10];
+  int k = 0;
+  do digits[k++] = '0' + n % 10;
+  while (n /= 10);
+  while (k) s->bytes[s->len++] = digits[--k];
+}
+
+/* CSI |n| |final|. The parameter is omitted when it is the default of 1. */
+static void sequence_push_csi(struct sequence *s, int n, char final) {
+  sequence_push(s, '\x1b', 1);
+  sequence_push(s, '[', 1);
+  if (n != 1) sequence_push_int(s, n);
+  sequence_push(s, final, 1);
+}
+
+/* The shortest sequence which moves the cursor from |from| to |line|, |col|. Each combination of a vertical motion
+ * (none, CUU/CUD, line feeds, VPA) and a horizontal motion (none, CUB/CUF, backspaces, CHA, carriage return) is
+ * weighed against an absolute CUP. Relative column motions are only used from a known column without a pending wrap,
+ * since terminals disagree about where the cursor is after writing the last column. Line feeds also return the
+ * carriage in newline mode (LNM), so they are only combined with absolute column motions. */
+static struct sequence cursor_motion(struct cursor from, int line, int col) {
+  struct sequence best = {0};
+  sequence_push(&best, '\x1b', 1);
+  sequence_push(&best, '[', 1);
+  if (line || col) sequence_push_int(&best, line + 1);
+  if (col) {
+    sequence_push(&best, ';', 1);
+    sequence_push_int(&best, col + 1);
+  }
+  sequence_push(&best, 'H', 1);
+  if (from.line < 0) return best;
+
+  enum { MOTION_NONE, MOTION_RELATIVE, MOTION_REPEAT, MOTION_ABSOLUTE, MOTION_RETURN };
+  int dl = line - from.line, dc = col - from.column;
+  bool known_column = from.column >= 0 && !from.wrap_pending;
+  for (int v = MOTION_NONE; v <= MOTION_ABSOLUTE; v++) {
+    if ((v == MOTION_NONE) != (dl == 0)) continue;
+    if (v == MOTION_REPEAT && dl > 4) continue;
+    for (int h = MOTION_NONE; h <= MOTION_RETURN; h++) {
+      if (h < MOTION_ABSOLUTE && (!known_column || v == MOTION_REPEAT)) continue;
+      if (h == MOTION_NONE && dc != 0) continue;
+      if (h == MOTION_RELATIVE && dc == 0) continue;
+      if (h == MOTION_REPEAT && (dc >= 0 || dc < -4)) continue;
+      if (v == MOTION_REPEAT && dl < 0) continue;
+
+      struct sequence m = {0};
+      if (h == MOTION_RETURN) sequence_push(&m, '\r', 1);
+      if (v == MOTION_RELATIVE) sequence_push_csi(&m, abs(dl), dl > 0 ? 'B' : 'A');
+      if (v == MOTION_REPEAT) sequence_push(&m, '\n', dl);
+      if (v == MOTION_ABSOLUTE) sequence_push_csi(&m, line + 1, 'd');
+      if (h == MOTION_RELATIVE) sequence_push_csi(&m, abs(dc), dc > 0 ? 'C' : 'D');
+      if (h == MOTION_REPEAT) sequence_push(&m, '\b', -dc);
+      if (h == MOTION_ABSOLUTE) sequence_push_csi(&m, col + 1, 'G');
+      if (h == MOTION_RETURN && col) sequence_push_csi(&m, col, 'C');
+      if (m.len < best.len) best = m;
+    }
+  }
+  return best;
+}
+
 static void velvet_render_position_cursor(struct velvet_render *r, int line, int col) {
   line = CLAMP(line, 0, r->h - 1);
   col = CLAMP(col, 0, r->w - 1);
-  if (r->state.cursor.position.line != line && r->state.cursor.position.column != col) {
-    string_push_csi(&r->draw_buffer, 0, INT_SLICE(line + 1, col + 1), "H");
-  } else if (r->state.cursor.position.line != line) {
-    string_push_csi(&r->draw_buffer, 0, INT_SLICE(line + 1), "d");
-  } else if (r->state.cursor.position.column != col) {
-    string_push_csi(&r->draw_buffer, 0, INT_SLICE(col + 1), "G");
-  }
+  struct sequence m = cursor_motion(r->state.cursor.position, line, col);
+  string_push_range(&r->draw_buffer, m.bytes, m.len);
 
   r->state.cursor.position.column = col;
   r->state.cursor.position.line = line;
+  r->state.cursor.position.wrap_pending = false;
 }
 
-static void render_buffer_add_damage(struct velvet_render_buffer_line *f, int start, int end, bool consolidate) {
-  /* merge with previous damage if they are reasonably close. The reason being that in most cases, it is cheaper to emit
-   * a few characters than a cursor move. Consolidation is disabled when `display_damage` is set. */
-  static const int consolidate_max = 10;
-  int n_damage = f->n_damage;
-
-  if (__builtin_expect(consolidate, true) && n_damage && start - f->damage[n_damage - 1].end < consolidate_max) {
-    f->damage[n_damage - 1].end = end;
-  } else {
-    f->damage[n_damage].start = start;
-    f->damage[n_damage].end = end;
-    f->n_damage++;
-  }
+static void render_buffer_add_damage(struct velvet_render_buffer_line *f, int start, int end) {
+  /* Nearby regions are not merged here. When they are drawn, the cells between them are redrawn instead of moving
+   * the cursor if that is cheaper. */
+  f->damage[f->n_damage].start = start;
+  f->damage[f->n_damage].end = end;
+  f->n_damage++;
 }
 
 static struct velvet_render_buffer *get_previous_buffer(struct velvet_render *r) {
@@ -394,6 +513,42 @@ static struct velvet_render_buffer *get_current_buffer(struct velvet_render *r)
   return &r->buffers[r->current_buffer];
 }
 
+static inline uint64_t read64(const void *p) {
+  uint64_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+_Static_assert(sizeof(struct velvet_render_cell) % sizeof(uint64_t) == 0, "render cells are compared a word at a time");
+
+/* the first cell in [start, end) which differs between |a| and |b|, or |end|. Cells are compared a word at a
+ * time, and the first differing byte is the lowest set byte on little endian. */
+static int cells_find_difference(const struct velvet_render_cell *a, const struct velvet_render_cell *b, int start, int end) {
+  const uint8_t *pa = (const uint8_t *)a, *pb = (const uint8_t *)b;
+  size_t last = end * sizeof(*a);
+  for (size_t i = start * sizeof(*a); i < last; i += sizeof(uint64_t)) {
+    uint64_t diff = read64(pa + i) ^ read64(pb + i);
+    if (diff) return (i + __builtin_ctzll(diff) / 8) / sizeof(*a);
+  }
+  return end;
+}
+
+/* the last cell in [start, end) which differs between |a| and |b|, or start - 1 */
+static int cells_find_last_difference(const struct velvet_render_cell *a, const struct velvet_render_cell *b, int start, int end) {
+  const uint8_t *pa = (const uint8_t *)a, *pb = (const uint8_t *)b;
+  size_t first = start * sizeof(*a);
+  for (size_t i = end * sizeof(*a); i > first; i -= sizeof(uint64_t)) {
+    if (read64(pa + i - sizeof(uint64_t)) != read64(pb + i - sizeof(uint64_t))) return (i - 1) / sizeof(*a);
+  }
+  return start - 1;
+}
+
+/* the first cell in [start, end) which is equal in |a| and |b|, or |end| */
+static int cells_find_equal(const struct velvet_render_cell *a, const struct velvet_render_cell *b, int start, int end) {
+  for (; start < end && memcmp(&a[start], &b[start], sizeof(*a)); start++);
+  return start;
+}
+
 static int velvet_render_calculate_damage(struct velvet_render *r) {
   int damage = 0;
   struct velvet_render_buffer *front = get_current_buffer(r);
@@ -404,40 +559,140 @@ static int velvet_render_calculate_damage(struct velvet_render *r) {
     struct velvet_render_buffer_line *b = &back->lines[line];
 
     f->n_damage = 0;
-    int start = 0;
-    for (; f->n_damage < DAMAGE_MAX - 1 && start < r->w; start++) {
-      if (!cell_equals(f->cells[start], b->cells[start])) {
-        int end = start + 1;
-        for (; end < r->w && !cell_equals(f->cells[end], b->cells[end]); end++);
-        end--;
-        assert(start <= end);
-        assert(end < r->w);
-        render_buffer_add_damage(f, start, end, !r->options.display_damage);
-        start = end;
-        if (end == r->w - 1) break;
-      }
+    /* rows which were not recomposited are copies of the previous frame */
+    if (!r->dirty[line]) continue;
+    /* Composited cells are canonical, so cells are equal exactly when their bytes are. Rows are compared
+     * directly rather than by hash: hashing a row costs several times more than comparing it against the
+     * previous frame, even when the previous frame is no longer cached. Rows whose windows did not change
+     * are not dirty, and are skipped without either. */
+    if (memcmp(f->cells, b->cells, r->w * sizeof(*f->cells)) == 0) continue;
+
+    int start = cells_find_difference(f->cells, b->cells, 0, r->w);
+    while (start < r->w && f->n_damage < DAMAGE_MAX - 1) {
+      int end = cells_find_equal(f->cells, b->cells, start + 1, r->w);
+      render_buffer_add_damage(f, start, end - 1);
+      start = cells_find_difference(f->cells, b->cells, end, r->w);
     }
 
-    for (; start < r->w; start++) {
-      if (!cell_equals(f->cells[start], b->cells[start])) {
-        for (int end = r->w - 1; end >= start; end--) {
-          if (!cell_equals(f->cells[end], b->cells[end])) {
-            assert(start <= end);
-            assert(end < r->w);
-            render_buffer_add_damage(f, start, end, !r->options.display_damage);
-            goto next;
-          }
-        }
-      }
+    /* out of damage regions. The remaining changes are covered by a single region. */
+    if (start < r->w) {
+      int end = cells_find_last_difference(f->cells, b->cells, start, r->w);
+      assert(start <= end);
+      render_buffer_add_damage(f, start, end);
     }
 
-  next:
     for (int i = 0; i < f->n_damage; i++)
       damage += 1 + (f->damage[i].end - f->damage[i].start);
   }
   return damage;
 }
 
+/* Erase the |n| blank cells from |col| if that is cheaper than writing them. Cells which end the line are erased with
+ * EL, and other runs with ECH, after which the cursor is moved past them unless they end at |end|. Only runs with the
+ * theme background are erased, since terminals without BCE erase with their default background instead of the
+ * current one, and EL also clears the terminal beyond the draw area. Returns true if the cells were erased. */
+static bool velvet_render_erase(struct velvet_render *r, int line, int col, int n, int end) {
+  /* terminals disagree about the color of erased cells when reverse video is set */
+  if (r->state.cell.style.attr & ATTR_REVERSE) return false;
+  if (!color_equals(r->state.cell.style.bg, r->theme.background)) return false;
+  if (col + n == r->w) {
+    if (n <= 3) return false;
+    string_push(&r->draw_buffer, (uint8_t *)"\x1b[K");
+    return true;
+  }
+
+  struct sequence erase = {0};
+  sequence_push_csi(&erase, n, 'X');
+  int cost = erase.len;
+  if (col + n <= end) cost += cursor_motion(r->state.cursor.position, line, col + n).len;
+  if (cost >= n) return false;
+  string_push_range(&r->draw_buffer, erase.bytes, erase.len);
+  if (col + n <= end) velvet_render_position_cursor(r, line, col + n);
+  return true;
+}
+
+/* draw the cells [start, end] of |line|, starting from the cursor position */
+static void velvet_render_draw_cells(struct velvet_render *r,
+                                     struct velvet_render_buffer_line *f,
+                                     int line,
+                                     int start,
+                                     int end,
+                                     bool highlight_damage,
+                                     struct screen_cell_style highlight) {
+  /* the end of the run of equal cells containing the current cell */
+  int run_end = start;
+  for (int col = start; col <= end; col++) {
+    struct velvet_render_cell *c = &f->cells[col];
+    struct screen_cell_style cell_style = c->style;
+    if (highlight_damage) {
+      cell_style = highlight;
+    }
+
+    if (blank(*c)) {
+      velvet_render_set_style(r, cell_style, true);
+    } else {
+      velvet_render_set_style(r, cell_style, false);
+    }
+
+    /* runs of equal cells are erased or repeated when that is cheaper than writing every cell */
+    int run = 1;
+    if (col >= run_end && !highlight_damage) {
+      for (run_end = col + 1; run_end <= end && memcmp(&f->cells[run_end], c, sizeof(*c)) == 0; run_end++);
+      run = run_end - col;
+    }
+    if (run > 1 && blank(*c) && !c->link && velvet_render_erase(r, line, col, run, end)) {
+      col += run - 1;
+      continue;
+    }
+
+    velvet_render_set_hyperlink(r, c->link);
+
+    bool cluster = grapheme_is_handle(c->cp.value);
+    if (cluster) {
+      string_push_grapheme(&r->draw_buffer, &r->graphemes, c->cp.value);
+    } else {
+      uint8_t buf[4];
+      uint8_t utf8_len = codepoint_to_utf8(c->cp.value, buf);
+      struct u8_slice text = {.content = buf, .len = utf8_len};
+      string_push_slice(&r->draw_buffer, text);
+
+      if (run > 1 && r->options.repeat_characters && !c->cp.is_wide) {
+        struct sequence repeat = {0};
+        sequence_push_csi(&repeat, run - 1, 'b');
+        if (repeat.len < (run - 1) * utf8_len) {
+          string_push_range(&r->draw_buffer, repeat.bytes, repeat.len);
+          col += run - 1;
+        }
+      }
+    }
+
+    if (c->cp.is_wide) col++;
+    r->state.cursor.position.column = MIN(col + 1, r->w - 1);
+    r->state.cursor.position.wrap_pending = col == r->w - 1;
+    /* terminals may disagree about the width of wide characters and clusters, so the next motion is absolute */
+    if (c->cp.is_wide || cluster) r->state.cursor.position.column = -1;
+  }
+}
+
+/* Move the cursor forward to |col| on |line| by redrawing the unchanged cells before it, if that is cheaper than a
+ * cursor motion. The cells are drawn, measured, and rolled back if they turned out more expensive. */
+static bool velvet_render_draw_gap(struct velvet_render *r, struct velvet_render_buffer_line *f, int line, int col) {
+  struct cursor from = r->state.cursor.position;
+  if (from.line != line || from.column < 0 || from.wrap_pending || from.column >= col) return false;
+  int motion = cursor_motion(from, line, col).len;
+  /* every cell costs at least a byte */
+  if (col - from.column > motion) return false;
+
+  struct velvet_render_state_cache state = r->state;
+  size_t len = r->draw_buffer.len;
+  velvet_render_draw_cells(r, f, line, from.column, col - 1, false, (struct screen_cell_style){0});
+  struct cursor to = r->state.cursor.position;
+  if (to.column == col && !to.wrap_pending && r->draw_buffer.len - len <= (size_t)motion) return true;
+  r->state = state;
+  r->draw_buffer.len = len;
+  return false;
+}
+
 static void velvet_render_render_buffer(struct velvet_render *r,
                                         struct velvet_render_buffer *front,
                                         bool highlight_damage,
@@ -447,29 +702,10 @@ static void velvet_render_render_buffer(struct velvet_render *r,
     for (int dmg = 0; dmg < f->n_damage; dmg++) {
       int start = f->damage[dmg].start;
       int end = f->damage[dmg].end;
-      velvet_render_position_cursor(r, line, start);
-      for (int col = start; col <= end; col++) {
-        struct screen_cell *c = &f->cells[col];
-        struct screen_cell_style cell_style = c->style;
-        if (highlight_damage) {
-          cell_style = highlight;
-        }
-
-        if (blank(*c)) {
-          velvet_render_set_style(r, cell_style, true);
-        } else {
-          velvet_render_set_style(r, cell_style, false);
-        }
-        velvet_render_set_hyperlink(r, c->link);
-
-        uint8_t buf[4];
-        uint8_t utf8_len = codepoint_to_utf8(c->cp.value, buf);
-        struct u8_slice text = {.content = buf, .len = utf8_len};
-        string_push_slice(&r->draw_buffer, text);
-
-        if (c->cp.is_wide) col++;
-        r->state.cursor.position.column = MIN(col + 1, r->w - 1);
-      }
+      /* regions are drawn exactly when damage is displayed */
+      if (highlight_damage || !velvet_render_draw_gap(r, f, line, start))
+        velvet_render_position_cursor(r, line, start);
+      velvet_render_draw_cells(r, f, line, start, end, highlight_damage, highlight);
     }
   }
 }
@@ -512,10 +748,14 @@ static bool should_emulate_cursor(struct cursor_options cur) {
   }
 }
 
+static inline bool velvet_render_is_occluded(struct velvet_render *r, struct velvet_window *win, int row, int column) {
+  return r->occlusion[row * r->w + column] > win->composited.layer + 1;
+}
+
 static void
 velvet_render_copy_cells_from_window(struct velvet_scene *scene, struct velvet_window *win, struct velvet_theme t) {
   struct velvet_render *r = &scene->renderer;
-  struct screen *win_buf = vte_get_current_screen(&win->emulator);
+  struct screen *win_buf = win->composited.screen;
   assert(win_buf->w == win->geometry.width);
   assert(win_buf->h == win->geometry.height);
 
@@ -528,11 +768,18 @@ velvet_render_copy_cells_from_window(struct velvet_scene *scene, struct velvet_w
     return;
 
   for (int line = l_start; line < l_end; line++) {
-    struct screen_line *screen_line = screen_get_view_line(win_buf, line);
     int render_line = win->geometry.top + line;
+    if (!r->dirty[render_line]) continue;
+    struct screen_line *screen_line = screen_get_view_line(win_buf, line);
     for (int column = c_start; column < c_end; column++) {
       int render_column = win->geometry.left + column;
-      struct screen_cell cell = screen_line->cells[column];
+      if (velvet_render_is_occluded(r, win, render_line, render_column)) continue;
+      struct screen_cell src = screen_line->cells[column];
+      struct velvet_render_cell cell = {
+          .cp = src.cp,
+          .style = screen_get_style(win_buf, src.style),
+          .link = vte_get_hyperlink(&win->emulator, src.link),
+      };
       if (r->options.display_eol) {
         if (screen_line->has_newline) {
           if (screen_line->eol == 0 && column == 0) {
@@ -547,6 +794,11 @@ velvet_render_copy_cells_from_window(struct velvet_scene *scene, struct velvet_w
 
       /* owner needed to disambiguate identical links from different windows */
       if (cell.link) cell.link->owner = win->id;
+      if (grapheme_is_handle(cell.cp.value)) {
+        cell.cp.value = grapheme_store_copy(&r->graphemes, &win->emulator.graphemes, cell.cp.value);
+        /* the store is recycled on the next full redraw */
+        if (grapheme_store_full(&r->graphemes)) scene->force_redraw = true;
+      }
       velvet_render_set_cell(r, render_line, render_column, cell, t);
       if (cell.cp.is_wide) column++;
     }
@@ -556,10 +808,10 @@ velvet_render_copy_cells_from_window(struct velvet_scene *scene, struct velvet_w
   if (is_focused && should_emulate_cursor(win->emulator.options.cursor)) {
     int x = win->geometry.left + win_buf->cursor.column;
     int y = win->geometry.top + win_buf->cursor.line + screen_get_scroll_offset(win_buf);
-    if (y < win->geometry.top + win->geometry.height) {
-      struct screen_cell *current = velvet_render_get_staged_cell(r, y, x);
+    if (y < win->geometry.top + win->geometry.height && y >= 0 && y < r->h && r->dirty[y]) {
+      struct velvet_render_cell *current = velvet_render_get_staged_cell(r, y, x);
       if (current) {
-        struct screen_cell cursor = *current;
+        struct velvet_render_cell cursor = *current;
         switch (win->emulator.options.cursor.style) {
         case CURSOR_STYLE_DEFAULT:
         case CURSOR_STYLE_BLINKING_BLOCK:
@@ -604,12 +856,37 @@ static void velvet_render_init_buffers(struct velvet_scene *m) {
   for (int i = 0; i < LENGTH(r->buffers); i++) velvet_render_init_buffer(&r->buffers[i], r->w, r->h);
   velvet_render_init_buffer(&r->staged.buffer, r->w, r->h);
   r->state = render_state_cache_invalidated;
+  /* the new buffers do not reference any clusters */
+  grapheme_store_clear(&r->graphemes);
   velvet_render_reset_staged_region(r);
-}
-
-static void velvet_render_clear_buffer(struct velvet_render *r, struct velvet_render_buffer *b, struct screen_cell space) {
-  for (int i = 0; i < r->h * r->w; i++) {
-    b->cells[i] = space;
+  free(r->dirty);
+  r->dirty = velvet_calloc(r->h, sizeof(*r->dirty));
+  free(r->occlusion);
+  r->occlusion = velvet_calloc(r->w * r->h, sizeof(*r->occlusion));
+  r->composited = false;
+}
+
+/* reclaim the clusters which are no longer referenced by a render buffer. Since the handles of the remaining
+ * clusters do not change, the buffers can still be compared with the next frame. */
+static void velvet_render_collect_graphemes(struct velvet_render *r) {
+  uint8_t *used = velvet_calloc(GRAPHEME_STORE_CAPACITY, sizeof(*used));
+  for (int i = 0; i < LENGTH(r->buffers); i++)
+    for (int c = 0; c < r->w * r->h; c++) grapheme_mark(used, r->buffers[i].cells[c].cp.value);
+  for (int c = 0; c < r->w * r->h; c++) grapheme_mark(used, r->staged.buffer.cells[c].cp.value);
+  grapheme_store_sweep(&r->graphemes, used);
+  free(used);
+}
+
+/* clear the dirty rows of the current buffer, and copy the other rows from the previous frame */
+static void velvet_render_clear_buffer(struct velvet_render *r, struct velvet_render_buffer *b, struct velvet_render_cell space) {
+  struct velvet_render_buffer *previous = get_previous_buffer(r);
+  for (int row = 0; row < r->h; row++) {
+    struct velvet_render_cell *cells = &b->cells[row * r->w];
+    if (r->dirty[row]) {
+      for (int i = 0; i < r->w; i++) cells[i] = space;
+    } else if (previous != b) {
+      memcpy(cells, &previous->cells[row * r->w], r->w * sizeof(*cells));
+    }
   }
 }
 
@@ -624,10 +901,11 @@ void velvet_scene_set_display_damage(struct velvet_scene *m, bool display_damage
         /* fully wipe out buffers -- unlike swap_buffers, this actually zero's cells instead of turning them into
          * spaces. This is needed because highlighted spaces will not register as damage */
         for (int i = 0; i < LENGTH(m->renderer.buffers); i++) {
-          memset(m->renderer.buffers[i].cells, 0, sizeof(struct screen_cell) * m->renderer.w * m->renderer.h);
+          memset(m->renderer.buffers[i].cells, 0, sizeof(struct velvet_render_cell) * m->renderer.w * m->renderer.h);
         }
     }
     m->renderer.options.display_damage = display_damage;
+    m->renderer.composited = false;
   }
 }
 
@@ -637,9 +915,10 @@ void velvet_scene_render_full(struct velvet_scene *m, render_func_t *render_func
 
   /* fully damage buffers */
   for (int i = 0; i < LENGTH(m->renderer.buffers); i++) {
-    memset(m->renderer.buffers[i].cells, 0, sizeof(struct screen_cell) * m->renderer.w * m->renderer.h);
+    memset(m->renderer.buffers[i].cells, 0, sizeof(struct velvet_render_cell) * m->renderer.w * m->renderer.h);
   }
   m->renderer.state = render_state_cache_invalidated;
+  m->renderer.composited = false;
   velvet_scene_render_damage(m, render_func, context);
 }
 
@@ -648,7 +927,7 @@ struct composite_options {
   float dim;
 };
 
-static bool is_cell_bg_clear(struct screen_cell c) {
+static bool is_cell_bg_clear(struct velvet_render_cell c) {
   if (c.style.attr & ATTR_REVERSE) return c.style.fg.kind == VELVET_API_COLOR_KIND_RESET;
   else return c.style.bg.kind == VELVET_API_COLOR_KIND_RESET;
 }
@@ -673,7 +952,7 @@ static void velvet_scene_commit_staged(struct velvet_scene *m, struct velvet_win
     case CURSOR_STYLE_DEFAULT:
     case CURSOR_STYLE_BLINKING_BLOCK:
     case CURSOR_STYLE_STEADY_BLOCK: {
-      struct screen *screen = vte_get_current_screen(&win->emulator);
+      struct screen *screen = win->composited.screen;
       struct cursor *cursor = &screen->cursor;
       int cursor_line = cursor->line + win->geometry.top + screen->scroll.view_offset;
       int cursor_col = cursor->column + win->geometry.left;
@@ -683,18 +962,21 @@ static void velvet_scene_commit_staged(struct velvet_scene *m, struct velvet_win
     }
   }
 
-  struct screen_cell empty = {0};
+  struct velvet_render_cell empty = {0};
   struct velvet_render_buffer *composite = get_current_buffer(r);
   struct velvet_render_buffer *staging = &r->staged.buffer;
 
   for (int row = r->staged.top; row <= r->staged.bottom; row++) {
+    if (!r->dirty[row]) continue;
     for (int column = r->staged.left; column <= r->staged.right; column++) {
       int cell_index = row * r->w + column;
-      struct screen_cell above = staging->cells[cell_index];
-      struct screen_cell below = normalize_cell(t, composite->cells[cell_index]);
-      struct screen_cell a_norm = normalize_cell(t, above);
+      /* cells covered by an opaque window are not blended. They were not staged either. */
+      if (velvet_render_is_occluded(r, win, row, column)) continue;
+      struct velvet_render_cell above = staging->cells[cell_index];
+      struct velvet_render_cell below = normalize_cell(t, composite->cells[cell_index]);
+      struct velvet_render_cell a_norm = normalize_cell(t, above);
 
-      struct screen_cell *before = column ? &composite->cells[cell_index - 1] : NULL;
+      struct velvet_render_cell *before = column ? &composite->cells[cell_index - 1] : NULL;
       bool is_wide_continuation = before && before->cp.is_wide && blank(above);
       bool fg_seethrough = !is_wide_continuation && (blank(above) || color_equals(a_norm.style.fg, a_norm.style.bg) || a_norm.style.fg.c.rgb.t == 255);
 
@@ -746,10 +1028,12 @@ static void velvet_scene_commit_staged(struct velvet_scene *m, struct velvet_win
 
       /* Wide chars on layers below can 'bleed through'. Clear the previous cell if it contains a wide char,
          * and this character is not a space. */
-      if (!blank(above) && column && composite->cells[cell_index - 1].cp.is_wide)
+      if (!blank(above) && column && composite->cells[cell_index - 1].cp.is_wide) {
         composite->cells[cell_index - 1].cp = codepoint_space;
+        composite->cells[cell_index - 1] = canonical_cell(composite->cells[cell_index - 1]);
+      }
 
-      composite->cells[cell_index] = normalize_cell(t, above);
+      composite->cells[cell_index] = canonical_cell(normalize_cell(t, above));
       staging->cells[cell_index] = empty;
     }
   }
@@ -775,6 +1059,291 @@ bool velvet_scene_hit(struct velvet_scene *scene, int x, int y, struct velvet_wi
   return false;
 }
 
+static bool theme_equals(struct velvet_theme a, struct velvet_theme b) {
+  if (!color_equals(a.background, b.background) || !color_equals(a.foreground, b.foreground)) return false;
+  if (!color_equals(a.cursor.foreground, b.cursor.foreground) || !color_equals(a.cursor.background, b.cursor.background)) return false;
+  for (int i = 0; i < LENGTH(a.palette); i++)
+    if (!color_equals(a.palette[i], b.palette[i])) return false;
+  return a.bold_bright_colors == b.bold_bright_colors;
+}
+
+static struct velvet_render_layer velvet_window_layer(struct velvet_scene *m, struct velvet_window *win) {
+  return (struct velvet_render_layer){
+      .id = win->id,
+      .geometry = win->geometry,
+      .transparency = win->transparency,
+      .dim_factor = win->dim_factor,
+      .reverse_video = win->emulator.options.reverse_video,
+      .focused = win->id == m->focus,
+  };
+}
+
+static bool layer_equals(struct velvet_render_layer a, struct velvet_render_layer b) {
+  return a.id == b.id && memcmp(&a.geometry, &b.geometry, sizeof(a.geometry)) == 0 &&
+         a.transparency.mode == b.transparency.mode && a.transparency.transparency == b.transparency.transparency &&
+         a.dim_factor == b.dim_factor && a.reverse_video == b.reverse_video && a.focused == b.focused;
+}
+
+/* the render position of the emulated cursor of |win|. The line is -1 if the cursor is not drawn. */
+static void velvet_window_emulated_cursor(struct velvet_scene *m, struct velvet_window *win, int *line, int *column) {
+  struct screen *screen = win->composited.screen;
+  *line = *column = -1;
+  if (win->id != m->focus || !should_emulate_cursor(win->emulator.options.cursor)) return;
+  *line = win->geometry.top + screen->cursor.line + screen->scroll.view_offset;
+  *column = win->geometry.left + screen->cursor.column;
+}
+
+static void velvet_render_mark_dirty(struct velvet_render *r, int row) {
+  if (row >= 0 && row < r->h) r->dirty[row] = true;
+}
+
+/* true if no window shows through |win| */
+static bool velvet_window_is_opaque(struct velvet_window *win, bool opaque_theme) {
+  /* lua windows may draw with translucent colors */
+  if (win->is_lua_window || !opaque_theme) return false;
+  return win->transparency.mode == VELVET_API_TRANSPARENCY_MODE_NONE || win->transparency.transparency == 0;
+}
+
+static bool theme_is_opaque(struct velvet_theme t) {
+  bool opaque = !t.background.c.rgb.t && !t.foreground.c.rgb.t && !t.cursor.foreground.c.rgb.t && !t.cursor.background.c.rgb.t;
+  for (int i = 0; i < LENGTH(t.palette); i++) opaque = opaque && !t.palette[i].c.rgb.t;
+  return opaque;
+}
+
+/* number the visible windows bottom to top, and record the topmost opaque window covering each cell */
+static void velvet_render_compute_occlusion(struct velvet_scene *m) {
+  struct velvet_render *r = &m->renderer;
+  memset(r->occlusion, 0, r->w * r->h * sizeof(*r->occlusion));
+  bool opaque_theme = theme_is_opaque(m->theme);
+  int layer = 0;
+  struct velvet_window *win;
+  vec_where(win, m->windows, !win->hidden) {
+    win->composited.layer = layer++;
+    if (!velvet_window_is_opaque(win, opaque_theme)) continue;
+    int top = MAX(win->geometry.top, 0), bottom = MIN(win->geometry.top + win->geometry.height, r->h);
+    int left = MAX(win->geometry.left, 0), right = MIN(win->geometry.left + win->geometry.width, r->w);
+    for (int row = top; row < bottom; row++) {
+      int *cells = &r->occlusion[row * r->w];
+      for (int column = left; column < right; column++) cells[column] = layer;
+    }
+  }
+}
+
+/* true if every cell of |win| on |row| is covered by an opaque window */
+static bool velvet_render_row_occluded(struct velvet_render *r, struct velvet_window *win, int row) {
+  int left = MAX(win->geometry.left, 0), right = MIN(win->geometry.left + win->geometry.width, r->w);
+  for (int column = left; column < right; column++)
+    if (!velvet_render_is_occluded(r, win, row, column)) return false;
+  return true;
+}
+
+/* Guess how far the content of |win| moved since it was composited. Lines keep their cells when the screen scrolls,
+ * so a line shown |n| rows above the row it was composited in moved up |n| rows. The guess is confirmed by the line
+ * below it, since lines cleared by a scroll are reused from the other end of the scroll region. */
+static int velvet_window_detect_scroll(struct velvet_window *win, struct screen *screen) {
+  int h = win->geometry.height;
+  if (win->composited.screen != screen || win->composited.n_lines != h) return 0;
+  if (win->composited.view_offset != screen->scroll.view_offset)
+    return win->composited.view_offset - screen->scroll.view_offset;
+
+  struct screen_cell **composited = win->composited.lines;
+  for (int line = screen->scroll.view_offset; line < h - 1; line++) {
+    struct screen_cell *cells = screen_get_view_line(screen, line)->cells;
+    if (cells == composited[line]) continue;
+    for (int k = screen->scroll.view_offset; k < h - 1; k++) {
+      if (composited[k] == cells && composited[k + 1] == screen_get_view_line(screen, line + 1)->cells)
+        return k - line;
+    }
+  }
+  return 0;
+}
+
+/* mark the rows showing lines of |win| which changed since the window was last composited */
+static void velvet_render_mark_window_damage(struct velvet_scene *m, struct velvet_window *win) {
+  struct velvet_render *r = &m->renderer;
+  /* the visible screen changes when a synchronized update completes, so it is fixed for the frame */
+  struct screen *screen = vte_get_visible_screen(&win->emulator);
+  win->composited.scrolled = velvet_window_detect_scroll(win, screen);
+  bool all = win->composited.screen != screen || win->composited.n_lines != win->geometry.height ||
+             win->composited.view_offset != screen->scroll.view_offset;
+  win->composited.screen = screen;
+
+  for (int line = 0; line < win->geometry.height; line++) {
+    int row = win->geometry.top + line;
+    if (row < 0 || row >= r->h || r->dirty[row] || velvet_render_row_occluded(r, win, row)) continue;
+    /* scrollback lines are expanded into shared buffers, so they are always restaged */
+    if (all || line < screen->scroll.view_offset) {
+      r->dirty[row] = true;
+      continue;
+    }
+    struct screen_line *l = screen_get_view_line(screen, line);
+    if (l->cells != win->composited.lines[line] || l->generation > win->composited.generation) r->dirty[row] = true;
+  }
+
+  int cursor_line, cursor_column;
+  velvet_window_emulated_cursor(m, win, &cursor_line, &cursor_column);
+  if (cursor_line != win->composited.cursor_line || cursor_column != win->composited.cursor_column ||
+      win->emulator.options.cursor.style != win->composited.cursor_style) {
+    velvet_render_mark_dirty(r, win->composited.cursor_line);
+    velvet_render_mark_dirty(r, cursor_line);
+  }
+}
+
+/* remember the lines of |win| which were composited in this frame */
+static void velvet_window_save_composited(struct velvet_scene *m, struct velvet_window *win) {
+  struct screen *screen = win->composited.screen;
+  int h = win->geometry.height;
+  if (win->composited.n_lines != h) {
+    free(win->composited.lines);
+    win->composited.lines = velvet_calloc(h, sizeof(*win->composited.lines));
+    win->composited.n_lines = h;
+  }
+  for (int line = 0; line < h; line++)
+    win->composited.lines[line] = line < screen->scroll.view_offset ? NULL : screen_get_view_line(screen, line)->cells;
+  win->composited.view_offset = screen->scroll.view_offset;
+  win->composited.generation = screen_generation;
+  velvet_window_emulated_cursor(m, win, &win->composited.cursor_line, &win->composited.cursor_column);
+  win->composited.cursor_style = win->emulator.options.cursor.style;
+}
+
+/* decide which rows of the render buffer are recomposited. All rows are recomposited if the previous frame is not
+ * available, or if the set of windows or the way they are composited changed. */
+static void velvet_render_mark_damage(struct velvet_scene *m) {
+  struct velvet_render *r = &m->renderer;
+  bool all = !r->composited || r->options.display_damage || r->options.display_eol || !theme_equals(r->theme, m->theme);
+
+  struct velvet_window *win;
+  size_t n_layers = 0;
+  vec_where(win, m->windows, !win->hidden) {
+    struct velvet_render_layer *previous = n_layers < r->layers.length ? vec_nth(r->layers, n_layers) : NULL;
+    if (!previous || !layer_equals(*previous, velvet_window_layer(m, win))) all = true;
+    n_layers++;
+  }
+  if (n_layers != r->layers.length) all = true;
+
+  for (int row = 0; row < r->h; row++) r->dirty[row] = all;
+  velvet_render_compute_occlusion(m);
+  vec_where(win, m->windows, !win->hidden) {
+    velvet_render_mark_window_damage(m, win);
+  }
+}
+
+/* remember how the windows were composited, so the next frame can reuse unchanged rows */
+static void velvet_render_save_composited(struct velvet_scene *m) {
+  struct velvet_render *r = &m->renderer;
+  uint64_t now = get_ms_since_startup();
+  struct velvet_window *win;
+  /* windows which were shown, moved or refocused count as used. Output is stamped when it is processed,
+   * so windows which are merely visible keep the time they were last written to. */
+  vec_where(win, m->windows, !win->hidden) {
+    struct velvet_render_layer *previous;
+    vec_find(previous, r->layers, previous->id == win->id);
+    if (!previous || !layer_equals(*previous, velvet_window_layer(m, win))) win->last_used = now;
+  }
+  vec_clear(&r->layers);
+  vec_where(win, m->windows, !win->hidden) {
+    struct velvet_render_layer layer = velvet_window_layer(m, win);
+    vec_push(&r->layers, &layer);
+    velvet_window_save_composited(m, win);
+  }
+  r->theme = m->theme;
+  r->composited = true;
+}
+
+struct scroll_region {
+  int top, bottom, left, right;
+  /* rows scrolled up, or down if negative */
+  int n;
+};
+
+/* Find the rows of |win| which can be scrolled by the terminal instead of redrawn. The region is scrolled if more of
+ * its rows match the previous frame after scrolling it than before. */
+static bool velvet_render_find_scroll(struct velvet_render *r, struct velvet_window *win, struct scroll_region *region) {
+  int n = win->composited.scrolled;
+  int top = MAX(win->geometry.top, 0), bottom = MIN(win->geometry.top + win->geometry.height, r->h) - 1;
+  int left = MAX(win->geometry.left, 0), right = MIN(win->geometry.left + win->geometry.width, r->w) - 1;
+  if (!n || abs(n) > bottom - top || left > right) return false;
+  bool full_width = left == 0 && right == r->w - 1;
+  if (!full_width && !r->options.left_right_margins) return false;
+
+  struct velvet_render_buffer *front = get_current_buffer(r);
+  struct velvet_render_buffer *back = get_previous_buffer(r);
+  size_t width = (right - left + 1) * sizeof(struct velvet_render_cell);
+  int first = -1, last = -1;
+  for (int row = MAX(top, top - n); row <= MIN(bottom, bottom - n); row++) {
+    if (memcmp(&front->lines[row].cells[left], &back->lines[row + n].cells[left], width)) continue;
+    if (first < 0) first = row;
+    last = row;
+  }
+  if (first < 0) return false;
+  *region = (struct scroll_region){.top = first + MIN(n, 0), .bottom = last + MAX(n, 0), .left = left, .right = right, .n = n};
+
+  int scrolled = 0, unscrolled = 0;
+  for (int row = region->top; row <= region->bottom; row++) {
+    struct velvet_render_cell *cells = &front->lines[row].cells[left];
+    int source = row + n;
+    if (source >= region->top && source <= region->bottom && !memcmp(cells, &back->lines[source].cells[left], width))
+      scrolled++;
+    if (!memcmp(cells, &back->lines[row].cells[left], width)) unscrolled++;
+    /* terminals do not agree on what happens to a wide character split by a margin */
+    struct velvet_render_cell *previous = back->lines[row].cells;
+    if (!full_width && ((left > 0 && previous[left - 1].cp.is_wide) || (right < r->w - 1 && previous[right].cp.is_wide)))
+      return false;
+  }
+  return scrolled > unscrolled;
+}
+
+/* Scroll |region| in the terminal, and scroll the previous frame the same way so it still matches the terminal.
+ * Rows scrolled into the region are cleared in the previous frame so they are always redrawn. */
+static void velvet_render_scroll_region(struct velvet_scene *m, struct scroll_region region) {
+  struct velvet_render *r = &m->renderer;
+  bool full_width = region.left == 0 && region.right == r->w - 1;
+  /* the terminal fills the rows scrolled into the region with the current background */
+  velvet_render_set_style(r, (struct screen_cell_style){.bg = m->theme.background}, false);
+  if (!full_width) string_push_slice(&r->draw_buffer, vt_left_right_margins_on);
+  string_push_csi(&r->draw_buffer, 0, INT_SLICE(region.top + 1, region.bottom + 1), "r");
+  if (!full_width) string_push_csi(&r->draw_buffer, 0, INT_SLICE(region.left + 1, region.right + 1), "s");
+  string_push_csi(&r->draw_buffer, 0, INT_SLICE(abs(region.n)), region.n > 0 ? "S" : "T");
+  if (!full_width) string_push_slice(&r->draw_buffer, vt_left_right_margins_off);
+  string_push_slice(&r->draw_buffer, vt_reset_top_bottom_margins);
+  /* setting the margins moves the cursor home */
+  r->state.cursor.position.line = r->state.cursor.position.column = 0;
+  r->state.cursor.position.wrap_pending = false;
+
+  struct velvet_render_buffer *back = get_previous_buffer(r);
+  size_t width = (region.right - region.left + 1) * sizeof(struct velvet_render_cell);
+  int n = abs(region.n);
+  if (region.n > 0) {
+    for (int row = region.top; row <= region.bottom - n; row++)
+      memcpy(&back->lines[row].cells[region.left], &back->lines[row + n].cells[region.left], width);
+    for (int row = region.bottom - n + 1; row <= region.bottom; row++) memset(&back->lines[row].cells[region.left], 0, width);
+  } else {
+    for (int row = region.bottom; row >= region.top + n; row--)
+      memcpy(&back->lines[row].cells[region.left], &back->lines[row - n].cells[region.left], width);
+    for (int row = region.top; row < region.top + n; row++) memset(&back->lines[row].cells[region.left], 0, width);
+  }
+  /* the scrolled rows no longer match the previous frame, so they are compared even if they were not recomposited */
+  for (int row = region.top; row <= region.bottom; row++) r->dirty[row] = true;
+}
+
+/* scroll the windows whose content moved vertically. Returns true if anything was scrolled, in which case a
+ * synchronized update was started. */
+static bool velvet_render_scroll_windows(struct velvet_scene *m) {
+  struct velvet_render *r = &m->renderer;
+  /* the damage display draws the previous frames, which must not change */
+  if (r->options.display_damage) return false;
+  bool scrolled = false;
+  struct velvet_window *win;
+  vec_where(win, m->windows, !win->hidden) {
+    struct scroll_region region;
+    if (!velvet_render_find_scroll(r, win, &region)) continue;
+    if (!scrolled) string_push_slice(&r->draw_buffer, vt_synchronized_rendering_on);
+    scrolled = true;
+    velvet_render_scroll_region(m, region);
+  }
+  return scrolled;
+}
+
 static void velvet_scene_stage_and_commit_window(struct velvet_scene *m, struct velvet_window *w) {
   struct velvet_theme t = m->theme;
   if (w->emulator.options.reverse_video) {
@@ -798,6 +1367,12 @@ void velvet_scene_render_damage(struct velvet_scene *m, render_func_t *render_fu
   struct velvet_render *r = &m->renderer;
 
   string_clear(&r->draw_buffer);
+  /* the render buffers may reference hyperlinks which were reclaimed by a window */
+  struct velvet_window *win;
+  vec_where(win, m->windows, win->emulator.links_collected) {
+    win->emulator.links_collected = false;
+    m->force_redraw = true;
+  }
   if (r->h != m->size.height || r->w != m->size.width || m->force_redraw) {
     m->force_redraw = false;
     velvet_render_init_buffers(m);
@@ -818,31 +1393,35 @@ void velvet_scene_render_damage(struct velvet_scene *m, render_func_t *render_fu
     string_push_slice(&r->draw_buffer, ED);
   }
 
-  struct screen_cell space = {.cp = codepoint_space, .style.bg = m->theme.background};
+  /* clusters which are no longer shown are never released, so the store is swept long before it fills up */
+  if (r->graphemes.interned >= GRAPHEME_STORE_CAPACITY / 2) velvet_render_collect_graphemes(r);
+
+  velvet_render_mark_damage(m);
+  struct velvet_render_cell space = canonical_cell((struct velvet_render_cell){.cp = codepoint_space, .style.bg = m->theme.background});
   velvet_render_clear_buffer(r, get_current_buffer(r), space);
 
 
   struct velvet_window *focused = velvet_scene_get_focus(m);
 
-  struct velvet_window *win;
   vec_where(win, m->windows, !win->hidden) {
     velvet_scene_stage_and_commit_window(m, win);
   }
+  velvet_render_save_composited(m);
+  bool scrolled = velvet_render_scroll_windows(m);
 
   /* damage: a rough estimate of the required screen update. Currently number of modified cells */
   int damage = velvet_render_calculate_damage(r);
   static const int damage_threshold = 1024; // 1024 is guaranteed to not fit in a single write, but is otherwise arbitrary
-  if (damage) {
-    if (damage > damage_threshold) string_push_slice(&r->draw_buffer, vt_synchronized_rendering_on);
-    velvet_render_render_damage_to_buffer(r);
-    if (damage > damage_threshold) string_push_slice(&r->draw_buffer, vt_synchronized_rendering_off);
-  }
+  bool synchronized = scrolled || damage > damage_threshold;
+  if (synchronized && !scrolled) string_push_slice(&r->draw_buffer, vt_synchronized_rendering_on);
+  if (damage) velvet_render_render_damage_to_buffer(r);
+  if (synchronized) string_push_slice(&r->draw_buffer, vt_synchronized_rendering_off);
 
   if (focused && !focused->hidden) {
     if (should_emulate_cursor(focused->emulator.options.cursor) || !focused->emulator.options.cursor.visible) {
       velvet_render_set_cursor_visible(r, false);
     } else if (focused->emulator.options.cursor.visible) {
-      struct screen *screen = vte_get_current_screen(&focused->emulator);
+      struct screen *screen = vte_get_visible_screen(&focused->emulator);
       struct cursor *cursor = &screen->cursor;
       int line = cursor->line + focused->geometry.top + screen->scroll.view_offset;
       int col = cursor->column + focused->geometry.left;
@@ -1038,19 +1617,6 @@ static bool color_equals(struct color a, struct color b) {
   return false;
 }
 
-static bool cell_equals(struct screen_cell a, struct screen_cell b) {
-  /* ATTR_REVERSE has been normalized out at this point */
-  assert(!(a.style.attr & ATTR_REVERSE));
-  assert(!(b.style.attr & ATTR_REVERSE));
-  if (blank(a) && blank(b)) 
-    return color_equals(a.style.bg, b.style.bg) && a.style.attr == b.style.attr && a.link == b.link;
-  return a.cp.value == b.cp.value && cell_style_equals(a.style, b.style) && a.link == b.link;
-}
-
-static bool cell_style_equals(struct screen_cell_style a, struct screen_cell_style b) {
-  return a.attr == b.attr && color_equals(a.fg, b.fg) && color_equals(a.bg, b.bg);
-}
-
 void velvet_window_destroy(struct velvet_window *velvet_window) {
   if (velvet_window->pty > 0) {
     /* CONT and HUP the process group of the pty.
@@ -1079,7 +1645,12 @@ void velvet_window_destroy(struct velvet_window *velvet_window) {
     }
   }
 
+  velvet_window_bind_clipboard(velvet_window);
   vte_destroy(&velvet_window->emulator);
+  free(velvet_window->composited.lines);
+  velvet_window->composited.lines = NULL;
+  velvet_window->composited.n_lines = 0;
+  velvet_window->composited.screen = NULL;
   string_destroy(&velvet_window->title);
   string_destroy(&velvet_window->cmdline);
   string_destroy(&velvet_window->cwd);
@@ -1092,24 +1663,55 @@ void velvet_scene_close_and_remove_window(struct velvet_scene *s, struct velvet_
     velvet_scene_remove_window(s, w);
 }
 
-static void on_set_clipboard(struct u8_slice base64, enum osc_clipboard clip, void *ud) {
+/* OSC 52 payloads are forwarded as they arrive. The output buffer is flushed to clients after each
+ * chunk of window output, so large clipboard copies never need to be buffered in full.
+ * While the sequence is open, velvet holds back everything else it would send to clients. */
+static void on_clipboard_begin(enum osc_clipboard clip, void *ud) {
   assert(clip == 'c' || clip == 'p');
   struct velvet_window *w = ud;
   string_push_cstr(&w->emulator_output_buffer, "\x1b]52;");
   string_push_char(&w->emulator_output_buffer, clip);
   string_push_char(&w->emulator_output_buffer, ';');
+}
+
+static void on_clipboard_write(struct u8_slice base64, void *ud) {
+  struct velvet_window *w = ud;
   /* let the host emulator figure out if the payload is valid */
   string_push_slice(&w->emulator_output_buffer, base64);
+}
+
+static void on_clipboard_end(void *ud) {
+  struct velvet_window *w = ud;
   string_push_char(&w->emulator_output_buffer, '\a');
 }
 
+static void on_clipboard_abort(void *ud) {
+  struct velvet_window *w = ud;
+  /* CAN cancels the sequence in the host emulator without setting the clipboard */
+  string_push_char(&w->emulator_output_buffer, 0x18);
+}
+
+/* windows live in a vec, so the userdata is refreshed every time the emulator may call back */
+static void velvet_window_bind_clipboard(struct velvet_window *velvet_window) {
+  velvet_window->emulator.clipboard.userdata = velvet_window;
+  velvet_window->emulator.clipboard.begin = on_clipboard_begin;
+  velvet_window->emulator.clipboard.write = on_clipboard_write;
+  velvet_window->emulator.clipboard.end = on_clipboard_end;
+  velvet_window->emulator.clipboard.abort = on_clipboard_abort;
+}
+
 void velvet_window_process_output(struct velvet_window *velvet_window, struct u8_slice str) {
   assert(velvet_window->emulator.ws.height == velvet_window->geometry.height);
   assert(velvet_window->emulator.ws.width == velvet_window->geometry.width);
   assert(velvet_window->geometry.height && velvet_window->geometry.width);
-  velvet_window->emulator.clipboard.userdata = velvet_window;
-  velvet_window->emulator.clipboard.set = on_set_clipboard;
+  velvet_window_bind_clipboard(velvet_window);
   vte_process(&velvet_window->emulator, str);
+  velvet_window->last_used = get_ms_since_startup();
+}
+
+bool velvet_window_expire_clipboard(struct velvet_window *velvet_window) {
+  velvet_window_bind_clipboard(velvet_window);
+  return vte_clipboard_expire(&velvet_window->emulator);
 }
 
 static bool rect_same_position(struct rect b1, struct rect b2) {
@@ -4,11 +4,13 @@
 #include "dcs.h"
 #include "osc.h"
 #include "text.h"
-#include "utf8proc/utf8proc.h"
 #include "utils.h"
+#include "platform.h"
 #include <string.h>
 #include <unistd.h>
 
+#include "vte_table.c"
+
 // Commented charsets are not supported and will be treated as ASCII (0)
 static enum charset charset_lookup[] = {
     ['0'] = CHARSET_DEC_SPECIAL, ['B'] = CHARSET_ASCII,
@@ -38,6 +40,8 @@ static enum charset charset_lookup[] = {
 #define SI 0x0F
 #define SO 0x0E
 #define ENQ 0x5
+#define CAN 0x18
+#define SUB 0x1a
 
 // Unclear what this should be -- an escape sequence can contain clipboard information, which can
 // in be arbitrarily large, but in practice will probably not exceed a couple of kB
@@ -45,10 +49,10 @@ static enum charset charset_lookup[] = {
 #define MAX_ESC_SEQ_LEN (1 << 16)
 
 void vte_send_device_attributes(struct vte *vte) {
-  // Advertise VT102 support (same as alacritty)
-  // TODO: Figure out how to advertise exact supported features here.
-  // Step 0: find good documentation.
-  string_push(&vte->pending_input, (uint8_t*)"\x1b[?6c");
+  // Advertise a VT220 class terminal with ANSI color (22) and rectangular area operations (28),
+  // so applications can copy, fill and erase regions with DECCRA, DECFRA and DECERA.
+  // https://invisible-island.net/xterm/ctlseqs/ctlseqs.html#h3-Functions-using-CSI-_-ordered-by-the-final-character_s_
+  string_push(&vte->pending_input, (uint8_t*)"\x1b[?62;22;28c");
 }
 
 void vte_send_status_report(struct vte *vte, enum vte_dsr n) {
@@ -89,8 +93,6 @@ static void vte_dispatch_charset(struct vte *vte, uint8_t ch) {
     return;
   }
 
-  vte->state = vte_ground;
-
   uint8_t designate = vte->command_buffer.content[1];
   int index = 0;
   if (designate == '(') { // G0
@@ -123,7 +125,6 @@ static void vte_dispatch_charset(struct vte *vte, uint8_t ch) {
 static void vte_dispatch_pnd(struct vte *vte, unsigned char ch) {
   // All pnd commands are single character commands
   // and can be applied immediately
-  vte->state = vte_ground;
   switch (ch) {
   case '3': OMITTED("DECDHL / TOP"); break;
   case '4': OMITTED("DECDHL / BOTTOM"); break;
@@ -138,6 +139,7 @@ static void vte_dispatch_pnd(struct vte *vte, unsigned char ch) {
         row->cells[col] = E;
       }
       row->eol = g->w;
+      screen_line_touch(row);
     }
   } break;
   default: {
@@ -146,10 +148,9 @@ static void vte_dispatch_pnd(struct vte *vte, unsigned char ch) {
   }
 }
 
-static void ground_esc(struct vte *vte, uint8_t ch) {
-  vte->state = vte_escape;
+static void ground_esc(struct vte *vte) {
   string_clear(&vte->command_buffer);
-  string_push_char(&vte->command_buffer, ch);
+  string_push_char(&vte->command_buffer, ESC);
 }
 static void ground_noop(struct vte *vte, uint8_t ch) {
   (void)vte, (void)ch;
@@ -192,22 +193,78 @@ static void ground_newline(struct vte *vte, uint8_t ch) {
   screen_newline(vte_get_current_screen(vte), vte->options.auto_return);
 }
 
+void vte_collect_graphemes(struct vte *vte) {
+  struct grapheme_store *s = &vte->graphemes;
+  if (s->n_clusters == s->n_free) return;
+  uint8_t *used = velvet_calloc(GRAPHEME_STORE_CAPACITY, sizeof(*used));
+  screen_mark_graphemes(&vte->primary, used);
+  screen_mark_graphemes(&vte->alternate, used);
+  if (vte->options.synchronized_update) screen_mark_graphemes(&vte->synchronized_update.frame, used);
+  grapheme_mark(used, vte->previous_symbol.value);
+  grapheme_store_sweep(s, used);
+  free(used);
+}
+
+void vte_collect_links(struct vte *vte) {
+  uint8_t *used = velvet_calloc(HYPERLINK_ID_MAX + 1, sizeof(*used));
+  screen_mark_links(&vte->primary, used);
+  screen_mark_links(&vte->alternate, used);
+  if (vte->options.synchronized_update) screen_mark_links(&vte->synchronized_update.frame, used);
+  used[vte->current_link] = 1;
+  vec_clear(&vte->free_links);
+  struct osc_hyperlink **link;
+  vec_foreach(link, vte->links) {
+    hyperlink_id id = vec_index(&vte->links, link) + 1;
+    if (*link && used[id]) continue;
+    if (*link) {
+      hyperlink_destroy(*link);
+      free(*link);
+      *link = NULL;
+      vte->links_collected = true;
+    }
+    vec_push(&vte->free_links, &id);
+  }
+  free(used);
+}
+
+/* append |cp| to the grapheme cluster preceding the cursor.
+ * Returns false if |cp| starts a new cluster. */
+static bool vte_extend_grapheme(struct vte *vte, uint32_t cp) {
+  struct screen *g = vte_get_current_screen(vte);
+  int column;
+  struct screen_cell *prev = screen_get_previous_glyph(g, &column);
+  if (!prev || !grapheme_extends(&vte->graphemes, prev->cp.value, cp)) return false;
+
+  uint32_t cluster[GRAPHEME_MAX_LENGTH];
+  int n = grapheme_store_get(&vte->graphemes, prev->cp.value, cluster);
+  /* overlong clusters are truncated, but the codepoint is still consumed */
+  if (n == GRAPHEME_MAX_LENGTH) return true;
+  cluster[n++] = cp;
+  /* every prefix of a cluster is interned while it is being written, so the store fills up with clusters
+   * which are no longer referenced. They are reclaimed once the store is full, but only after enough
+   * clusters were interned to make the sweep worthwhile if most of the store is still in use. */
+  if (grapheme_store_full(&vte->graphemes) && vte->graphemes.interned >= GRAPHEME_STORE_CAPACITY / 16)
+    vte_collect_graphemes(vte);
+  prev->cp.value = grapheme_store_intern(&vte->graphemes, cluster, n);
+  if (!prev->cp.is_wide && grapheme_width(cluster, n) > 1) screen_widen_glyph(g, column);
+  vte->previous_symbol = prev->cp;
+  return true;
+}
+
 static void ground_accept(struct vte *vte) {
   struct screen *g = vte_get_current_screen(vte);
 
   int len;
   uint32_t symbol = utf8_to_codepoint(vte->pending_symbol.utf8, &len);
-  int width = utf8proc_charwidth(symbol);
-  /* this is true for codepoints which modify the preceding characters, such
-   * as acutes and variation selectors. Since we don't properly handle
-   * graphemes, we just ignore those characters for now. */
-  if (width == 0) {
-    TODO("grapheme clusters");
+  int width = unicode_width(symbol);
+  /* combining marks, joiners and variation selectors are appended to the preceding cluster.
+   * Zero width codepoints with nothing to attach to are dropped. */
+  if ((grapheme_may_extend(vte->previous_symbol.value, symbol) && vte_extend_grapheme(vte, symbol)) || width == 0) {
     vte->pending_symbol = (struct utf8){0};
     return;
   }
   struct codepoint cp = { .is_wide = width > 1, .value = symbol };
-  struct screen_cell c = { .cp = cp, .style = g->cursor.brush, .link = vte->current_link };
+  struct screen_cell c = { .cp = cp, .style = screen_intern_style(g, g->cursor.brush), .link = vte->current_link };
   screen_insert(g, c, vte->options.auto_wrap_mode);
   vte->previous_symbol = cp;
   vte->pending_symbol = (struct utf8){0};
@@ -273,38 +330,34 @@ static void DISPATCH_APC(struct vte *vte)   {
 }
 
 
-static void vte_dispatch_ground(struct vte *vte, uint8_t ch) {
+static void vte_execute(struct vte *vte, uint8_t ch) {
   // These symbols have special behavior in terms of how they affect layout
   switch (ch) {
-#define CONTROL(C0, C1, cmd, _2)                                                                                      \
-  case C1: DISPATCH_##cmd(vte); break;
-#include "control_sequences/control_characters.def"
-#undef CONTROL
   case NUL: ground_noop(vte, ch); break;
-  case ESC: ground_esc(vte, ch); break;
   case RET: ground_carriage_return(vte, ch); break;
   case BSP: ground_backspace(vte, ch); break;
   case BELL: ground_bell(vte, ch); break;
   case SI: ground_process_shift_in(vte, ch); break;
   case SO: ground_process_shift_out(vte, ch); break;
-  case DEL: ground_noop(vte, ch); break;
   case TAB: ground_tab(vte, ch); break;
   case VTAB: ground_vtab(vte, ch); break;
   case FORMFEED: ground_newline(vte, ch); break;
   case NEWLINE: ground_newline(vte, ch); break;
   case ENQ: ground_enquiry(vte, ch); break;
-  default: {
-    if (ch >= 0xC2 && ch <= 0xF4) { // UTF8 leading byte range
-      utf8_push(&vte->pending_symbol, ch);
-      vte->state = vte_utf8;
-    } else if (ch <= 0x7F) { // ASCII range
-      utf8_push(&vte->pending_symbol, ch);
-      ground_accept(vte);
-    } else { // Outside of ascii range, and not part of a valid utf8 sequence -- error symbol
-      vte->pending_symbol = utf8_fffd;
-      ground_accept(vte);
-    }
-  } break;
+  default: ground_noop(vte, ch); break;
+  }
+}
+
+static void vte_print(struct vte *vte, uint8_t ch) {
+  if (ch >= 0xC2 && ch <= 0xF4) { // UTF8 leading byte range
+    utf8_push(&vte->pending_symbol, ch);
+    vte->state = vte_utf8;
+  } else if (ch <= 0x7F) { // ASCII range
+    utf8_push(&vte->pending_symbol, ch);
+    ground_accept(vte);
+  } else { // Outside of ascii range, and not part of a valid utf8 sequence -- error symbol
+    vte->pending_symbol = utf8_fffd;
+    ground_accept(vte);
   }
 }
 
@@ -334,35 +387,24 @@ static void vte_dispatch_utf8(struct vte *vte, uint8_t ch) {
 }
 
 static void vte_full_reset(struct vte *vte) {
+  vte_clipboard_abort(vte);
+  vte_set_synchronized_update(vte, false);
   vte->options = emulator_options_default;
   vte_enter_primary_screen(vte);
   screen_full_reset(&vte->primary);
+  /* the scrollback survives a reset, so the store is collected rather than cleared */
+  vte->previous_symbol = (struct codepoint){0};
+  vte_collect_graphemes(vte);
 }
 
 static void vte_dispatch_escape(struct vte *vte, uint8_t ch) {
   string_push_char(&vte->command_buffer, ch);
-  vte->state = vte_ground;
   switch (ch) {
-  case PCT: vte->state = vte_pct; break;
-  case SPC: vte->state = vte_spc; break;
-  case PND: vte->state = vte_pnd; break;
   case '7': screen_save_cursor(vte_get_current_screen(vte)); break;
   case '8': screen_restore_cursor(vte_get_current_screen(vte)); break;
   case '=': vte->options.application_keypad_mode = true; break;
   case '>': vte->options.application_keypad_mode = false; break;
-  case ESC: // Escape inside an escape sequence should restart the sequence.
-      vte->command_buffer.len = 1;
-    break;
   case 'c': vte_full_reset(vte); break;
-  case '(': // designate G0, VT100
-  case ')': // designate G1, VT100
-  case '*': // designate G2, VT220
-  case '+': // designate G3, VT220
-  case '-': // designate G1, VT300
-  case '.': // designate G2, VT300
-  case '/': // designate G3, VT300
-    vte->state = vte_charset;
-    break;
   case 'n':
   case 'o':
   case '|':
@@ -402,22 +444,121 @@ void vte_dispatch_dcs(struct vte *vte, uint8_t ch) {
   }
 }
 
+/* the 7-bit equivalent of C1 controls */
+static uint8_t c1_to_c0(uint8_t ch) {
+  return ch >= 0x80 ? ch - 0x40 : ch;
+}
+
+/* CSI parameters are accumulated in vte->csi as they arrive. The sequence is never buffered,
+ * and a rejected sequence is consumed up to its final byte without being dispatched. */
 static void vte_dispatch_csi(struct vte *vte, uint8_t ch) {
-  string_push_char(&vte->command_buffer, ch);
-  if (ch >= 0x40 && ch <= 0x7E) {
-    struct csi csi = {0};
-    // Strip the prefix escape sequence
-    struct u8_slice csi_body = string_range(&vte->command_buffer, 2, -1);
-    csi_parse(&csi, csi_body);
-    if (csi.state == CSI_ACCEPT) {
-      csi_dispatch(vte, &csi);
-    } else {
-      velvet_log("Reject CSI: %.*s", (int)csi_body.len, csi_body.content);
-    }
-    vte->state = vte_ground;
-  } else if (vte->command_buffer.len >= MAX_ESC_SEQ_LEN) {
+  csi_finish(&vte->csi, ch);
+  if (vte->csi.state == CSI_ACCEPT) csi_dispatch(vte, &vte->csi);
+}
+
+/* OSC, DCS and APC strings are buffered with their introducer (ESC ], ESC P, ESC _) */
+static void vte_string_enter(struct vte *vte, uint8_t ch) {
+  string_clear(&vte->command_buffer);
+  string_push_char(&vte->command_buffer, ESC);
+  string_push_char(&vte->command_buffer, c1_to_c0(ch));
+}
+
+void vte_clipboard_begin(struct vte *vte, enum osc_clipboard clipboard) {
+  if (vte->clipboard.begin) vte->clipboard.begin(clipboard, vte->clipboard.userdata);
+}
+
+static inline bool is_base64(uint8_t ch) {
+  return (ch >= 'A' && ch <= 'Z') || (ch >= 'a' && ch <= 'z') || (ch >= '0' && ch <= '9') || ch == '+' ||
+         ch == '/' || ch == '=';
+}
+
+void vte_clipboard_write(struct vte *vte, struct u8_slice base64) {
+  vte->clipboard_stream.size += base64.len;
+  if (vte->clipboard_stream.size > VTE_CLIPBOARD_MAX_SIZE) {
+    velvet_log("Abort OSC 52: max length exceeded");
+    vte_clipboard_abort(vte);
+    return;
+  }
+  if (!vte->clipboard.write) return;
+  /* bytes outside the base64 alphabet, such as line breaks, are dropped so they never reach the host sequence */
+  for (size_t i = 0; i < base64.len;) {
+    size_t start = i;
+    for (; i < base64.len && is_base64(base64.content[i]); i++);
+    if (i > start) vte->clipboard.write(u8_slice_range(base64, start, i), vte->clipboard.userdata);
+    for (; i < base64.len && !is_base64(base64.content[i]); i++);
+  }
+}
+
+void vte_clipboard_end(struct vte *vte) {
+  if (vte->clipboard.end) vte->clipboard.end(vte->clipboard.userdata);
+}
+
+bool vte_clipboard_open(const struct vte *vte) {
+  return vte->state == vte_clipboard;
+}
+
+void vte_clipboard_abort(struct vte *vte) {
+  if (!vte_clipboard_open(vte)) return;
+  string_clear(&vte->command_buffer);
+  vte->state = vte_ground;
+  if (vte->clipboard.abort) vte->clipboard.abort(vte->clipboard.userdata);
+}
+
+bool vte_clipboard_expire(struct vte *vte) {
+  if (!vte_clipboard_open(vte) || get_ms_since_startup() - vte->clipboard_stream.since < VTE_CLIPBOARD_TIMEOUT)
+    return false;
+  velvet_log("Abort OSC 52: timed out");
+  vte_clipboard_abort(vte);
+  return true;
+}
+
+/* OSC 52 payloads can be arbitrarily large. Once the clipboard selection is known, the payload
+ * is streamed to the clipboard callbacks instead of being buffered. */
+static bool vte_osc_begin_clipboard(struct vte *vte) {
+  struct u8_slice cmd = string_as_u8_slice(vte->command_buffer);
+  static const char prefix[] = "\x1b]52;";
+  const size_t n = sizeof(prefix) - 1;
+  if (cmd.len < n + 1 || cmd.len > n + 2 || memcmp(cmd.content, prefix, n)) return false;
+
+  /* the selection may be omitted, in which case the system clipboard is used */
+  uint8_t selection = cmd.len == n + 1 ? 'c' : cmd.content[n];
+  enum osc_clipboard clipboard;
+  switch (selection) {
+  case 'c': clipboard = OSC_CLIPBOARD_SYSTEM; break;
+  case 'p': clipboard = OSC_CLIPBOARD_X11_PRIMARY_SELECTION; break;
+  default: return false;
+  }
+  string_clear(&vte->command_buffer);
+  vte->state = vte_clipboard;
+  vte->clipboard_stream.since = get_ms_since_startup();
+  vte->clipboard_stream.size = 0;
+  vte_clipboard_begin(vte, clipboard);
+  return true;
+}
+
+static void vte_step(struct vte *vte, uint8_t ch);
+
+/* The payload ends with BEL or ST. CAN and SUB abort the sequence, and an ESC which does not
+ * start ST aborts it and begins a new escape sequence, so a truncated OSC 52 cannot swallow
+ * the output which follows it. */
+static void vte_dispatch_clipboard(struct vte *vte, uint8_t ch) {
+  /* the command buffer only holds an ESC which may be the start of ST */
+  bool escaped = vte->command_buffer.len > 0;
+  if (ch == BELL || (escaped && ch == '\\')) {
+    string_clear(&vte->command_buffer);
+    vte_clipboard_end(vte);
     vte->state = vte_ground;
-    velvet_log("Abort CSI: max length exceeded");
+  } else if (escaped) {
+    vte_clipboard_abort(vte);
+    vte->state = vte_escape;
+    ground_esc(vte);
+    vte_step(vte, ch);
+  } else if (ch == ESC) {
+    string_push_char(&vte->command_buffer, ch);
+  } else if (ch == CAN || ch == SUB) {
+    vte_clipboard_abort(vte);
+  } else {
+    vte_clipboard_write(vte, (struct u8_slice){.content = &ch, .len = 1});
   }
 }
 
@@ -427,6 +568,7 @@ static void vte_dispatch_osc(struct vte *vte, uint8_t ch) {
   // same terminator as the one we received for maximum compatibility
   char prev = vte->command_buffer.len > 1 ? vte->command_buffer.content[vte->command_buffer.len - 1] : 0;
   string_push_char(&vte->command_buffer, ch);
+  if (ch == ';' && vte_osc_begin_clipboard(vte)) return;
   if (ch == BELL || (ch == '\\' && prev == ESC)) {
     const char *st = ch == BELL ? BEL : ST;
     uint8_t *buffer = vte->command_buffer.content + 2;
@@ -478,12 +620,11 @@ static void vte_dispatch_apc(struct vte *vte, uint8_t ch) {
 }
 
 static void vte_dispatch_pct(struct vte *vte, uint8_t ch) {
-  (void)ch;
-  vte->state = vte_ground;
+  (void)vte, (void)ch;
   TODO("Select Character Set");
 }
 static void vte_dispatch_spc(struct vte *vte, uint8_t ch) {
-  vte->state = vte_ground;
+  (void)vte;
   switch (ch) {
   case 'F': TODO("7-bit controls"); break;
   case 'G': TODO("8-bit controls"); break;
@@ -495,7 +636,7 @@ static void vte_dispatch_spc(struct vte *vte, uint8_t ch) {
 }
 
 static void vte_init_alternate_screen(struct vte *vte) {
-  if (vte->alternate.w != vte->ws.width || vte->alternate.h != vte->ws.height) {
+  if (vte->alternate.cells == NULL || vte->alternate.w != vte->ws.width || vte->alternate.h != vte->ws.height) {
     struct screen new = {.w = vte->ws.width, .h =  vte->ws.height};
     screen_initialize(&new, vte->ws.width,  vte->ws.height);
     if (vte->alternate.cells) {
@@ -506,9 +647,28 @@ static void vte_init_alternate_screen(struct vte *vte) {
   }
 }
 
+/* the alternate screen is only allocated while it is in use */
+static void vte_release_alternate_screen(struct vte *vte) {
+  if (vte->options.alternate_screen || !vte->alternate.cells) return;
+  screen_destroy(&vte->alternate);
+  vte->alternate = (struct screen){0};
+}
+
+bool vte_alternate_screen_kept(const struct vte *vte) {
+  return vte->alternate.cells && !vte->options.alternate_screen;
+}
+
+bool vte_alternate_screen_expire(struct vte *vte) {
+  if (!vte_alternate_screen_kept(vte) || get_ms_since_startup() - vte->alternate_left < VTE_ALTERNATE_SCREEN_GRACE)
+    return false;
+  vte_release_alternate_screen(vte);
+  return true;
+}
+
 void vte_enter_alternate_screen(struct vte *vte) {
   if (vte->options.alternate_screen) return;
   vte->options.alternate_screen = true;
+  /* a screen kept from the last time the alternate screen was used is reused. It always has the current size. */
   vte_init_alternate_screen(vte);
   struct screen *g = &vte->alternate;
   struct cursor start = {.column = screen_left(g), .line = screen_top(g)};
@@ -519,7 +679,12 @@ void vte_enter_alternate_screen(struct vte *vte) {
 
 static void vte_init_primary_screen(struct vte *vte) {
   if (vte->primary.w != vte->ws.width || vte->primary.h !=  vte->ws.height) {
-    struct screen new = { .w = vte->ws.width, .h =  vte->ws.height, .scroll.max = vte->primary.scroll.max };
+    struct screen new = {
+        .w = vte->ws.width,
+        .h = vte->ws.height,
+        .scroll.max = vte->primary.scroll.max,
+        .scroll.spill = vte->primary.scroll.spill,
+    };
     screen_initialize(&new, vte->ws.width,  vte->ws.height);
     if (vte->primary.cells) {
       screen_copy_primary(&new, &vte->primary);
@@ -532,32 +697,59 @@ static void vte_init_primary_screen(struct vte *vte) {
 void vte_enter_primary_screen(struct vte *vte) {
   if (!vte->options.alternate_screen) return;
   vte->options.alternate_screen = false;
+  vte->alternate_left = get_ms_since_startup();
   vte_init_primary_screen(vte);
 }
 
+void vte_set_synchronized_update(struct vte *vte, bool on) {
+  if (on == vte->options.synchronized_update) return;
+  vte->options.synchronized_update = on;
+  if (on) {
+    screen_snapshot(&vte->synchronized_update.frame, vte_get_current_screen(vte));
+    vte->synchronized_update.since = get_ms_since_startup();
+  } else {
+    vte->synchronized_update.completed = true;
+  }
+}
+
+bool vte_synchronized_update_pending(const struct vte *vte) {
+  return vte->options.synchronized_update &&
+         get_ms_since_startup() - vte->synchronized_update.since < VTE_SYNCHRONIZED_UPDATE_TIMEOUT;
+}
+
+bool vte_synchronized_update_expire(struct vte *vte) {
+  if (!vte->options.synchronized_update || vte_synchronized_update_pending(vte)) return false;
+  velvet_log("Synchronized update timed out");
+  vte_set_synchronized_update(vte, false);
+  return true;
+}
+
+struct screen *vte_get_visible_screen(struct vte *vte) {
+  return vte_synchronized_update_pending(vte) ? &vte->synchronized_update.frame : vte_get_current_screen(vte);
+}
+
 void vte_set_size(struct vte *vte, struct rect sz) {
   struct screen *g = vte_get_current_screen(vte);
   vte->ws = sz;
+  /* the frame of a pending update no longer fits the window */
+  if (sz.width != g->w || sz.height != g->h) vte_set_synchronized_update(vte, false);
 
   if (g->cells == NULL || g->w != sz.width || g->h != sz.height) {
-    vte_init_alternate_screen(vte);
+    /* an inactive alternate screen would be cleared before it is used again, so it is released instead of resized */
+    if (vte->options.alternate_screen) vte_init_alternate_screen(vte);
+    else vte_release_alternate_screen(vte);
     vte_init_primary_screen(vte);
   }
 }
 
-static bool is_ascii(uint8_t ch) {
-  return ch >= SPC && ch < DEL;
-}
-
 static int ascii_fastpath(struct vte *vte, struct u8_slice str, size_t i) {
   /* consume as many ascii characters as we can in a single run.
    * In a pure ascii run, grid insertion can be made much faster because
    * we don't need to account for state machine changes, such as cell style and wrapping behavior. */
-  size_t j = i;
-  for (; j < str.len && is_ascii(str.content[j]); j++);
+  size_t j = i + text_scanner.ascii(str.content + i, str.len - i);
   if (j > i) {
     struct screen *s = vte_get_current_screen(vte);
-    struct screen_cell_style style = s->cursor.brush;
+    style_id style = screen_intern_style(s, s->cursor.brush);
     bool wrap = vte->options.auto_wrap_mode;
     struct u8_slice run = u8_slice_range(str, i, j);
     screen_insert_ascii_run(s, style, run, wrap, vte->current_link);
@@ -568,80 +760,160 @@ static int ascii_fastpath(struct vte *vte, struct u8_slice str, size_t i) {
 
 static int unicode_fastpath(struct vte *vte, struct u8_slice str, size_t j) {
   /* consume as many unicode characters as we can.
-   * This is not as dramatic as the ascii fastpath because we now need to account
-   * for character width, and collecting a "run" of characters would require copying the variable-length
-   * encoded input to a fixed-length buffer.
-
-   * The primary win here is spending less time going through the state machine,
-   * and more time decoding characters. (measured ~2x performance boost)
-   * */
+   * The non-ascii run is validated and decoded in blocks. Widths are then resolved for
+   * the whole block, and the resulting glyphs are committed to the screen as a single run.
+   * If an invalid or truncated sequence is found, we break from the fastpath
+   * and let the state machine figure out how to restore state. */
   struct screen *g = vte_get_current_screen(vte);
   bool wrap = vte->options.auto_wrap_mode;
-  struct screen_cell c = {.style = g->cursor.brush, .link = vte->current_link};
-  int n = 0;
-  for (; j + 3 < str.len; j += n) {
-    uint32_t symbol = utf8_to_codepoint(&str.content[j], &n);
-    if (n < 2) break;
-    /* XOR trick: We want to check for each continuation byte if EITHER
-     * 1. The first bit is NOT set (invalid continuation)
-     * 2. The second bit IS set (invalid continuation)
-     * This works because continuation bytes follow the format 0b10xxxxxx
-     * If an invalid sequence is detected, we should break from the fastpath
-     * and let the main loop figure out how to restore state. */
-    uint8_t bad = (str.content[j+1] ^ 0x80);
-    if (n >= 3) bad |= (str.content[j+2] ^ 0x80);
-    if (n >= 4) bad |= (str.content[j+3] ^ 0x80);
-    /* invalid utf8 -- break from the fastpath and let the state machine handle it */
-    if (bad & 0xC0) break;
-    int width = utf8proc_charwidth(symbol);
-    if (width == 0) {
-      TODO("grapheme clusters");
-      continue;
+  uint32_t symbols[256];
+  struct codepoint glyphs[LENGTH(symbols)];
+  struct codepoint last = vte->previous_symbol;
+
+  size_t end = j + text_scanner.utf8(str.content + j, str.len - j);
+  while (j < end) {
+    size_t consumed;
+    size_t n = utf8_decode_run(str.content + j, end - j, symbols, LENGTH(symbols), &consumed);
+    if (n == 0) break;
+    j += consumed;
+
+    int n_glyphs = 0;
+    for (size_t i = 0; i < n; i++) {
+      uint32_t cp = symbols[i];
+      int width = unicode_width(cp);
+      if (grapheme_may_extend(last.value, cp)) {
+        /* clusters are extended in place on the screen, so the pending glyphs must be committed first */
+        if (n_glyphs) {
+          screen_insert_run(g, screen_intern_style(g, g->cursor.brush), glyphs, n_glyphs, wrap, vte->current_link);
+          vte->previous_symbol = glyphs[n_glyphs - 1];
+          n_glyphs = 0;
+        }
+        if (vte_extend_grapheme(vte, cp)) {
+          last = vte->previous_symbol;
+          continue;
+        }
+        if (width == 0) continue;
+      }
+      last = glyphs[n_glyphs++] = (struct codepoint){ .is_wide = width > 1, .value = cp };
     }
-    c.cp = (struct codepoint) { .is_wide = width > 1, .value = symbol };
-    screen_insert(g, c, wrap);
+    if (n_glyphs == 0) continue;
+    screen_insert_run(g, screen_intern_style(g, g->cursor.brush), glyphs, n_glyphs, wrap, vte->current_link);
   }
-  if (c.cp.value) vte->previous_symbol = c.cp;
+  vte->previous_symbol = last;
   vte->pending_symbol = (struct utf8){0};
   return j;
 }
 
+static void vte_step(struct vte *vte, uint8_t ch) {
+  /* the state is updated before the action runs. Actions may override it. */
+  struct vte_transition t = vte_transitions[vte->state][ch];
+  vte->state = t.next;
+  switch (t.action) {
+  case VTE_ACTION_IGNORE: break;
+  case VTE_ACTION_PRINT: vte_print(vte, ch); break;
+  case VTE_ACTION_EXECUTE: vte_execute(vte, ch); break;
+  case VTE_ACTION_UTF8: vte_dispatch_utf8(vte, ch); break;
+  case VTE_ACTION_ESC_ENTER: ground_esc(vte); break;
+  case VTE_ACTION_ESC_DISPATCH: vte_dispatch_escape(vte, c1_to_c0(ch)); break;
+  case VTE_ACTION_COLLECT: string_push_char(&vte->command_buffer, ch); break;
+  case VTE_ACTION_CSI_ENTER: csi_reset(&vte->csi); break;
+  case VTE_ACTION_CSI_COLLECT: csi_push(&vte->csi, ch); break;
+  case VTE_ACTION_CSI_DISPATCH: vte_dispatch_csi(vte, ch); break;
+  case VTE_ACTION_STRING_ENTER: vte_string_enter(vte, ch); break;
+  case VTE_ACTION_OSC_PUT: vte_dispatch_osc(vte, ch); break;
+  case VTE_ACTION_DCS_PUT: vte_dispatch_dcs(vte, ch); break;
+  case VTE_ACTION_APC_PUT: vte_dispatch_apc(vte, ch); break;
+  case VTE_ACTION_PND_DISPATCH: vte_dispatch_pnd(vte, ch); break;
+  case VTE_ACTION_SPC_DISPATCH: vte_dispatch_spc(vte, ch); break;
+  case VTE_ACTION_PCT_DISPATCH: vte_dispatch_pct(vte, ch); break;
+  case VTE_ACTION_CHARSET_DISPATCH: vte_dispatch_charset(vte, ch); break;
+  case VTE_ACTION_CLIPBOARD_PUT: vte_dispatch_clipboard(vte, ch); break;
+  default: assert(!"Unreachable");
+  }
+}
+
+/* length of the longest OSC 52 prefix (ESC ] 5 2 ; c ;). Shorter OSC strings are buffered
+ * byte by byte so the clipboard selection can be detected. */
+#define OSC_CLIPBOARD_PREFIX_LEN 7
+
+static size_t string_fastpath(struct vte *vte, struct u8_slice str, size_t i) {
+  /* append the payload of an OSC, DCS or APC string up to the next possible terminator in a single copy.
+   * Terminators, and the byte following an ESC, are left to the per-byte dispatchers.
+   * The span is capped so the dispatchers still observe MAX_ESC_SEQ_LEN. */
+  struct string *buf = &vte->command_buffer;
+  if (vte->state == vte_clipboard) {
+    /* clipboard payloads are forwarded without copying them to the command buffer */
+    if (buf->len) return i;
+    size_t n = text_scanner.string(str.content + i, str.len - i);
+    vte_clipboard_write(vte, u8_slice_range(str, i, i + n));
+    return i + n;
+  }
+  if (vte->state == vte_osc && buf->len < OSC_CLIPBOARD_PREFIX_LEN) return i;
+  if (buf->content[buf->len - 1] == ESC || buf->len + 1 >= MAX_ESC_SEQ_LEN) return i;
+  size_t n = text_scanner.string(str.content + i, str.len - i);
+  size_t room = MAX_ESC_SEQ_LEN - 1 - buf->len;
+  if (n > room) n = room;
+  string_push_range(buf, str.content + i, n);
+  return i + n;
+}
+
 void vte_process(struct vte *vte, struct u8_slice str) {
   assert(vte->ws.height);
   assert(vte->ws.width);
+  vte_alternate_screen_expire(vte);
   for (size_t i = 0; i < str.len; i++) {
     if (vte->state == vte_ground) {
       i = ascii_fastpath(vte, str, i);
       i = unicode_fastpath(vte, str, i);
       if (i >= str.len) break;
+    } else if (vte->state == vte_osc || vte->state == vte_dcs || vte->state == vte_apc || vte->state == vte_clipboard) {
+      i = string_fastpath(vte, str, i);
+      if (i >= str.len) break;
     }
-    uint8_t ch = str.content[i];
-    switch (vte->state) {
-    case vte_ground: vte_dispatch_ground(vte, ch); break;
-    case vte_utf8: vte_dispatch_utf8(vte, ch); break;
-    case vte_escape: vte_dispatch_escape(vte, ch); break;
-    case vte_dcs: vte_dispatch_dcs(vte, ch); break;
-    case vte_osc: vte_dispatch_osc(vte, ch); break;
-    case vte_apc: vte_dispatch_apc(vte, ch); break;
-    case vte_csi: vte_dispatch_csi(vte, ch); break;
-    case vte_pnd: vte_dispatch_pnd(vte, ch); break;
-    case vte_spc: vte_dispatch_spc(vte, ch); break;
-    case vte_pct: vte_dispatch_pct(vte, ch); break;
-    case vte_charset: vte_dispatch_charset(vte, ch); break;
-    default: assert(!"Unreachable");
-    }
+    vte_step(vte, str.content[i]);
   }
 }
 
 void vte_destroy(struct vte *vte) {
+  vte_clipboard_abort(vte);
   screen_destroy(&vte->primary);
   screen_destroy(&vte->alternate);
+  screen_destroy(&vte->synchronized_update.frame);
   string_destroy(&vte->pending_input);
   string_destroy(&vte->command_buffer);
   struct osc_hyperlink **link;
-  vec_foreach(link, vte->links)
+  vec_where(link, vte->links, *link) {
     hyperlink_destroy(*link);
+    free(*link);
+  }
   vec_destroy(&vte->links);
+  vec_destroy(&vte->free_links);
+  grapheme_store_destroy(&vte->graphemes);
+}
+
+static void screen_memory_add(struct screen_memory *m, struct screen_memory add) {
+  m->cells += add.cells;
+  m->lines += add.lines;
+  m->styles += add.styles;
+  m->scrollback += add.scrollback;
+}
+
+struct vte_memory vte_get_memory(const struct vte *vte) {
+  struct vte_memory m = {0};
+  screen_memory_add(&m.screens, screen_get_memory(&vte->primary));
+  screen_memory_add(&m.screens, screen_get_memory(&vte->alternate));
+  screen_memory_add(&m.screens, screen_get_memory(&vte->synchronized_update.frame));
+  m.hyperlinks = vte->links.capacity * vte->links.element_size;
+  struct osc_hyperlink **link;
+  vec_where(link, vte->links, *link) m.hyperlinks += sizeof(**link) + (*link)->buffer.cap;
+  m.hyperlinks += vte->free_links.capacity * vte->free_links.element_size;
+  return m;
+}
+
+hyperlink_handle vte_get_hyperlink(struct vte *vte, hyperlink_id id) {
+  if (!id) return NULL;
+  hyperlink_handle *link = vec_nth(vte->links, id - 1);
+  return *link;
 }
 
 struct screen *vte_get_current_screen(struct vte *vte) {